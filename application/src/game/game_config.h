@@ -17,6 +17,10 @@ typedef struct GameConfig
 
     bool showElapsedTime;
     bool inLevel;
+
+    /// @brief Exécute la simulation du jeu sur un thread dédié.
+    /// Activé par l'argument --threaded-sim.
+    bool threadedSim;
 } GameConfig;
 
 void GameConfig_init();
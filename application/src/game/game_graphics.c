@@ -17,11 +17,8 @@ GameGraphics* GameGraphics_create(Scene* scene)
     AssertNew(self);
 
     self->m_scene = scene;
-    self->m_padding = Vec2_set(0.0f, 0.0f);
-    self->m_spacing = Vec2_set(0.1f, 0.1f);
-    self->m_gridAABB.lower = Vec2_add(Vec2_set(-4.f, -4.f), Vec2_set(8.0f, 4.5f));
-    self->m_gridAABB.upper = Vec2_add(Vec2_set(+4.f, +4.f), Vec2_set(8.0f, 4.5f));
     self->m_enabled = false;
+    GameSim_getSnapshot(Scene_getGameSim(scene), &(self->m_snapshot));
 
     AssetManager* assets = Scene_getAssetManager(scene);
     SpriteSheet* spriteSheet = AssetManager_getSpriteSheet(assets, SPRITE_GAME);
@@ -38,60 +35,24 @@ void GameGraphics_destroy(GameGraphics* self)
     free(self);
 }
 
-static void GameGraphics_updateCells(GameGraphics* self)
-{
-    float totalPaddingX = self->m_padding.x * 2.f;
-    float totalPaddingY = self->m_padding.y * 2.f;
-    float totalSpacingX = self->m_spacing.x * (GAME_GRID_SIZE - 1);
-    float totalSpacingY = self->m_spacing.y * (GAME_GRID_SIZE - 1);
-    Vec2 gridSize = AABB_getSize(&(self->m_gridAABB));
-    float cellW = (gridSize.x - totalPaddingX - totalSpacingX) / GAME_GRID_SIZE;
-    float cellH = (gridSize.y - totalPaddingY - totalSpacingY) / GAME_GRID_SIZE;
-
-    for (int i = 0; i < GAME_GRID_SIZE; i++)
-    {
-        for (int j = 0; j < GAME_GRID_SIZE; j++)
-        {
-            float cellX = self->m_gridAABB.lower.x + self->m_padding.x + j * (cellW + self->m_spacing.x);
-            float cellY = self->m_gridAABB.lower.y + self->m_padding.y + i * (cellH + self->m_spacing.y);
-            self->m_cells[GAME_GRID_SIZE - 1 - i][j].lower = Vec2_set(cellX, cellY);
-            self->m_cells[GAME_GRID_SIZE - 1 - i][j].upper = Vec2_set(cellX + cellW, cellY + cellH);
-        }
-    }
-}
-
 void GameGraphics_update(GameGraphics* self)
 {
     assert(self && "self must not be NULL");
     Scene* scene = self->m_scene;
     Input* input = Scene_getInput(scene);
     Camera* camera = Scene_getCamera(scene);
+    GameSim* sim = Scene_getGameSim(scene);
 
-    GameGraphics_updateCells(self);
-
-    Vec2 mouseWorldPos = { 0 };
-    Camera_viewToWorld(camera, input->mouse.position.x, input->mouse.position.y, &mouseWorldPos);
-
-    if (self->m_enabled == false)
+    // Les entrées sont transmises à la simulation sous forme de commandes
+    if (self->m_enabled && input->mouse.leftPressed)
     {
-        return;
+        Vec2 mouseWorldPos = { 0 };
+        Camera_viewToWorld(camera, input->mouse.position.x, input->mouse.position.y, &mouseWorldPos);
+        GameSim_select(sim, mouseWorldPos);
     }
 
-    if (input->mouse.leftPressed)
-    {
-        for (int i = 0; i < GAME_GRID_SIZE; i++)
-        {
-            for (int j = 0; j < GAME_GRID_SIZE; j++)
-            {
-                AABB* cellAABB = &(self->m_cells[i][j]);
-                if (AABB_containsPoint(cellAABB, mouseWorldPos))
-                {
-                    self->m_selectedRowIndex = i;
-                    self->m_selectedColIndex = j;
-                }
-            }
-        }
-    }
+    GameSim_update(sim);
+    GameSim_getSnapshot(sim, &(self->m_snapshot));
 }
 
 void GameGraphics_render(GameGraphics* self)
@@ -100,6 +61,7 @@ void GameGraphics_render(GameGraphics* self)
 
     Scene* scene = self->m_scene;
     Camera* camera = Scene_getCamera(scene);
+    const GameSnapshot* snapshot = &(self->m_snapshot);
     float scale = Camera_getWorldToViewScale(camera);
 
     SDL_FRect rect = { 0 };
@@ -107,17 +69,17 @@ void GameGraphics_render(GameGraphics* self)
     {
         for (int j = 0; j < GAME_GRID_SIZE; j++)
         {
-            AABB* cellAABB = &(self->m_cells[i][j]);
+            const AABB* cellAABB = &(snapshot->cells[i][j]);
             rect.x = Camera_worldToViewX(camera, cellAABB->lower.x);
             rect.y = Camera_worldToViewY(camera, cellAABB->upper.y);
             rect.w = (cellAABB->upper.x - cellAABB->lower.x) * scale;
             rect.h = (cellAABB->upper.y - cellAABB->lower.y) * scale;
 
-            bool isSelected = (i == self->m_selectedRowIndex && j == self->m_selectedColIndex);
+            bool isSelected = (i == snapshot->selectedRowIndex && j == snapshot->selectedColIndex);
 
             SDL_Color color = isSelected ? g_colors.orange9 : g_colors.gray8;
-            SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, 255);
-            SDL_RenderFillRect(g_renderer, &rect);
+            color.a = 255;
+            RenderQueue_drawFillRect(&rect, color);
 
             if (isSelected)
             {
@@ -9,23 +9,18 @@
 #include "settings.h"
 #include "game/game_config.h"
 #include "game/core/game_core.h"
+#include "game/game_sim.h"
 
 typedef struct Scene Scene;
 
-#define GAME_GRID_SIZE 5
-
 /// @brief Structure représentant la scène du menu principal du jeu.
 typedef struct GameGraphics
 {
     Scene* m_scene;
-    AABB m_gridAABB;
-    Vec2 m_padding;
-    Vec2 m_spacing;
-
-    AABB m_cells[GAME_GRID_SIZE][GAME_GRID_SIZE];
 
-    int m_selectedRowIndex;
-    int m_selectedColIndex;
+    /// @brief Copie du dernier état publié par la simulation, dessinée par
+    /// GameGraphics_render().
+    GameSnapshot m_snapshot;
 
     SpriteGroup* m_spriteRabbit;
 
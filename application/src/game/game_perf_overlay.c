@@ -0,0 +1,261 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "game/game_perf_overlay.h"
+
+#define GAME_PERF_MARGIN 4.f
+#define GAME_PERF_PADDING 3.f
+#define GAME_PERF_LINE_HEIGHT 11.f
+#define GAME_PERF_GRAPH_HEIGHT 30.f
+#define GAME_PERF_BAR_WIDTH 1.f
+
+/// @brief Durée de frame correspondant à la hauteur du graphe, en millisecondes.
+#define GAME_PERF_GRAPH_MAX_MS 33.3f
+#define GAME_PERF_TARGET_MS 16.7f
+
+static double GamePerfOverlay_ticksToMs(Uint64 ticks)
+{
+    return 1000.0 * (double)ticks / (double)SDL_GetPerformanceFrequency();
+}
+
+GamePerfOverlay* GamePerfOverlay_create(TTF_Font* font)
+{
+    GamePerfOverlay* self = (GamePerfOverlay*)calloc(1, sizeof(GamePerfOverlay));
+    AssertNew(self);
+
+    const float panelW = 2.f * GAME_PERF_PADDING + GAME_PERF_SAMPLE_COUNT * GAME_PERF_BAR_WIDTH;
+    const float panelH = 3.f * GAME_PERF_PADDING + GAME_PERF_GRAPH_HEIGHT
+        + GAME_PERF_LINE_COUNT * GAME_PERF_LINE_HEIGHT;
+    UIRect rect = { 0 };
+
+    self->m_canvas = UICanvas_create("perf-canvas");
+
+    // Panneau dans le coin supérieur gauche
+    SDL_Color panelColor = g_colors.black;
+    panelColor.a = 180;
+    UIFillRect* panel = UIFillRect_create("perf-panel", panelColor);
+    rect.anchorMin = Vec2_set(0.f, 1.f);
+    rect.anchorMax = Vec2_set(0.f, 1.f);
+    rect.offsetMin = Vec2_set(GAME_PERF_MARGIN, -GAME_PERF_MARGIN - panelH);
+    rect.offsetMax = Vec2_set(GAME_PERF_MARGIN + panelW, -GAME_PERF_MARGIN);
+    UIObject_setRect(panel, rect);
+    UIObject_setParent(panel, self->m_canvas);
+
+    for (int i = 0; i < GAME_PERF_LINE_COUNT; i++)
+    {
+        UILabel* label = UILabel_create("perf-label", font);
+        UILabel_setAnchor(label, Vec2_anchor_west);
+        UILabel_setColor(label, g_colors.gray0);
+        rect.anchorMin = Vec2_set(0.f, 1.f);
+        rect.anchorMax = Vec2_set(1.f, 1.f);
+        rect.offsetMin = Vec2_set(GAME_PERF_PADDING, -GAME_PERF_PADDING - (i + 1) * GAME_PERF_LINE_HEIGHT);
+        rect.offsetMax = Vec2_set(-GAME_PERF_PADDING, -GAME_PERF_PADDING - i * GAME_PERF_LINE_HEIGHT);
+        UIObject_setRect(label, rect);
+        UIObject_setParent(label, panel);
+        self->m_labels[i] = label;
+    }
+
+    for (int i = 0; i < GAME_PERF_SAMPLE_COUNT; i++)
+    {
+        UIFillRect* bar = UIFillRect_create("perf-bar", g_colors.green5);
+        UIObject_setParent(bar, panel);
+        self->m_bars[i] = bar;
+    }
+
+    UIObject_setEnabled(self->m_canvas, false);
+    self->m_frameStart = SDL_GetPerformanceCounter();
+    self->m_updateEnd = self->m_frameStart;
+
+    return self;
+}
+
+void GamePerfOverlay_destroy(GamePerfOverlay* self)
+{
+    if (!self) return;
+    UIObject_destroy(self->m_canvas);
+    free(self);
+}
+
+void GamePerfOverlay_setVisible(GamePerfOverlay* self, bool isVisible)
+{
+    assert(self && "The GamePerfOverlay must be created");
+    self->m_isVisible = isVisible;
+    UIObject_setEnabled(self->m_canvas, isVisible);
+
+    // Force le rafraîchissement à la prochaine mise à jour
+    self->m_lastRefresh = 0;
+}
+
+void GamePerfOverlay_beginFrame(GamePerfOverlay* self)
+{
+    assert(self && "The GamePerfOverlay must be created");
+    self->m_frameStart = SDL_GetPerformanceCounter();
+    memset(&self->m_currSample, 0, sizeof(GamePerfSample));
+
+    UIUtils_resetTextUpdateCount();
+    self->m_uiAllocMark = UIObject_getAllocStats().heapAllocCount;
+    self->m_sdlAllocMark = SDL_GetNumAllocations();
+    self->m_nodeUpdateMark = UIObject_getUpdateCount();
+}
+
+/// @brief Renvoie le nombre d'allocations SDL vivantes depuis le dernier relevé
+/// puis effectue un nouveau relevé.
+static int GamePerfOverlay_takeSdlAllocDelta(GamePerfOverlay* self)
+{
+    const int allocCount = SDL_GetNumAllocations();
+    const int delta = allocCount - self->m_sdlAllocMark;
+    self->m_sdlAllocMark = allocCount;
+    return delta;
+}
+
+static void GamePerfOverlay_refresh(GamePerfOverlay* self)
+{
+    const int count = self->m_sampleCount;
+    if (count == 0) return;
+
+    // Moyennes sur les frames conservées
+    double frameSum = 0.0, updateSum = 0.0, renderSum = 0.0;
+    double drawSum = 0.0, bindSum = 0.0, stateSum = 0.0;
+    double textSum = 0.0, layoutSum = 0.0, nodeSum = 0.0, allocSum = 0.0, sdlSum = 0.0;
+    float frameMax = 0.f;
+    for (int i = 0; i < count; i++)
+    {
+        const GamePerfSample* sample = &(self->m_samples[i]);
+        frameSum += sample->frameMs;
+        updateSum += sample->updateMs;
+        renderSum += sample->renderMs;
+        drawSum += sample->drawCallCount;
+        bindSum += sample->textureBindCount;
+        stateSum += sample->stateChangeCount;
+        textSum += sample->textUpdateCount;
+        layoutSum += sample->layoutCount;
+        nodeSum += sample->nodeUpdateCount;
+        allocSum += sample->uiHeapAllocCount;
+        sdlSum += sample->sdlAllocDelta;
+        frameMax = fmaxf(frameMax, sample->frameMs);
+    }
+    const double frameAvg = frameSum / count;
+
+    char buffer[128] = { 0 };
+    SDL_snprintf(
+        buffer, sizeof(buffer), "%.0f FPS  %.2f ms (max %.2f)",
+        frameAvg > 0.0 ? 1000.0 / frameAvg : 0.0, frameAvg, frameMax
+    );
+    UILabel_setTextString(self->m_labels[GAME_PERF_LINE_FPS], buffer);
+    SDL_snprintf(
+        buffer, sizeof(buffer), "update %.2f ms  render %.2f ms",
+        updateSum / count, renderSum / count
+    );
+    UILabel_setTextString(self->m_labels[GAME_PERF_LINE_TIMES], buffer);
+    SDL_snprintf(
+        buffer, sizeof(buffer), "draws %.1f  binds %.1f  states %.1f",
+        drawSum / count, bindSum / count, stateSum / count
+    );
+    UILabel_setTextString(self->m_labels[GAME_PERF_LINE_DRAWS], buffer);
+    SDL_snprintf(
+        buffer, sizeof(buffer), "texts %.1f  layouts %.1f  nodes %.0f",
+        textSum / count, layoutSum / count, nodeSum / count
+    );
+    UILabel_setTextString(self->m_labels[GAME_PERF_LINE_UI], buffer);
+    SDL_snprintf(
+        buffer, sizeof(buffer), "UI heap allocs %.1f  SDL net %+.1f",
+        allocSum / count, sdlSum / count
+    );
+    UILabel_setTextString(self->m_labels[GAME_PERF_LINE_ALLOCS], buffer);
+
+    // Graphe des durées de frame, de la plus ancienne à la plus récente
+    const int first = (count < GAME_PERF_SAMPLE_COUNT) ? 0 : self->m_sampleIdx;
+    UIRect rect = { 0 };
+    rect.anchorMin = Vec2_set(0.f, 0.f);
+    rect.anchorMax = Vec2_set(0.f, 0.f);
+    for (int i = 0; i < GAME_PERF_SAMPLE_COUNT; i++)
+    {
+        UIFillRect* bar = self->m_bars[i];
+        if (i >= count)
+        {
+            UIObject_setEnabled(bar, false);
+            continue;
+        }
+
+        const float frameMs = self->m_samples[(first + i) % GAME_PERF_SAMPLE_COUNT].frameMs;
+        const float height = fminf(frameMs / GAME_PERF_GRAPH_MAX_MS, 1.f) * GAME_PERF_GRAPH_HEIGHT;
+        rect.offsetMin = Vec2_set(GAME_PERF_PADDING + i * GAME_PERF_BAR_WIDTH, GAME_PERF_PADDING);
+        rect.offsetMax = Vec2_set(rect.offsetMin.x + GAME_PERF_BAR_WIDTH, GAME_PERF_PADDING + height);
+        UIObject_setRect(bar, rect);
+        UIObject_setEnabled(bar, true);
+
+        SDL_Color color = g_colors.green5;
+        if (frameMs > GAME_PERF_GRAPH_MAX_MS) color = g_colors.red5;
+        else if (frameMs > GAME_PERF_TARGET_MS) color = g_colors.yellow5;
+        UIFillRect_setColor(bar, color);
+    }
+}
+
+void GamePerfOverlay_endUpdate(GamePerfOverlay* self)
+{
+    assert(self && "The GamePerfOverlay must be created");
+    self->m_updateEnd = SDL_GetPerformanceCounter();
+    self->m_currSample.updateMs = (float)GamePerfOverlay_ticksToMs(self->m_updateEnd - self->m_frameStart);
+    self->m_currSample.layoutCount = UIObject_getLayoutCount();
+    self->m_currSample.nodeUpdateCount = (int)(UIObject_getUpdateCount() - self->m_nodeUpdateMark);
+
+    // Relevés avant le rafraîchissement, qui alloue les textes des labels.
+    // Les statistiques d'allocation sont remises à zéro par la construction
+    // des pages : le relevé initial n'est alors plus valide.
+    const int uiAllocCount = UIObject_getAllocStats().heapAllocCount;
+    self->m_currSample.uiHeapAllocCount = (uiAllocCount >= self->m_uiAllocMark)
+        ? uiAllocCount - self->m_uiAllocMark : uiAllocCount;
+    self->m_currSample.sdlAllocDelta = GamePerfOverlay_takeSdlAllocDelta(self);
+
+    if (self->m_isVisible == false) return;
+
+    const double elapsed = GamePerfOverlay_ticksToMs(self->m_updateEnd - self->m_lastRefresh) / 1000.0;
+    if (self->m_lastRefresh == 0 || elapsed >= GAME_PERF_REFRESH_INTERVAL)
+    {
+        self->m_lastRefresh = self->m_updateEnd;
+        GamePerfOverlay_refresh(self);
+    }
+    UIObject_update(self->m_canvas);
+
+    // Les allocations de l'affichage ne sont pas comptées
+    self->m_sdlAllocMark = SDL_GetNumAllocations();
+}
+
+void GamePerfOverlay_render(GamePerfOverlay* self)
+{
+    assert(self && "The GamePerfOverlay must be created");
+
+    RenderQueueStats stats = { 0 };
+    RenderQueue_getStats(g_renderQueue, NULL, &stats);
+    self->m_currSample.drawCallCount = stats.drawCallCount;
+    self->m_currSample.textureBindCount = stats.textureBindCount;
+    self->m_currSample.stateChangeCount = stats.stateChangeCount;
+
+    // Les textes des widgets sont transmis à SDL_ttf pendant leur rendu :
+    // relevé après le rendu de la scène et avant celui de l'affichage
+    self->m_currSample.textUpdateCount = UIUtils_getTextUpdateCount();
+    self->m_currSample.sdlAllocDelta += GamePerfOverlay_takeSdlAllocDelta(self);
+
+    if (self->m_isVisible == false) return;
+
+    // Soumis séparément, après la relève des statistiques de la scène
+    RenderQueue_begin(g_renderQueue);
+    UIObject_render(self->m_canvas);
+    RenderQueue_end(g_renderQueue);
+}
+
+void GamePerfOverlay_endFrame(GamePerfOverlay* self)
+{
+    assert(self && "The GamePerfOverlay must be created");
+    const Uint64 frameEnd = SDL_GetPerformanceCounter();
+    GamePerfSample* sample = &(self->m_currSample);
+    sample->frameMs = (float)GamePerfOverlay_ticksToMs(frameEnd - self->m_frameStart);
+    sample->renderMs = (float)GamePerfOverlay_ticksToMs(frameEnd - self->m_updateEnd);
+
+    self->m_samples[self->m_sampleIdx] = *sample;
+    self->m_sampleIdx = (self->m_sampleIdx + 1) % GAME_PERF_SAMPLE_COUNT;
+    self->m_sampleCount = SDL_min(self->m_sampleCount + 1, GAME_PERF_SAMPLE_COUNT);
+}
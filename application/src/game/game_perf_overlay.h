@@ -0,0 +1,107 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Nombre de frames conservées pour le graphe et les moyennes.
+#define GAME_PERF_SAMPLE_COUNT 120
+
+/// @brief Intervalle de rafraîchissement de l'affichage, en secondes.
+#define GAME_PERF_REFRESH_INTERVAL 0.25
+
+typedef enum GamePerfLine
+{
+    GAME_PERF_LINE_FPS,
+    GAME_PERF_LINE_TIMES,
+    GAME_PERF_LINE_DRAWS,
+    GAME_PERF_LINE_UI,
+    GAME_PERF_LINE_ALLOCS,
+    GAME_PERF_LINE_COUNT
+} GamePerfLine;
+
+/// @brief Mesures d'une frame.
+typedef struct GamePerfSample
+{
+    float frameMs;
+    float updateMs;
+    /// @brief Durée du rendu, présentation comprise.
+    float renderMs;
+    int drawCallCount;
+    int textureBindCount;
+    /// @brief Changements de mode de fusion ou de couleur.
+    int stateChangeCount;
+    int textUpdateCount;
+    int layoutCount;
+    /// @brief Nombre d'objets de l'interface mis à jour.
+    int nodeUpdateCount;
+    /// @brief Allocations sur le tas des objets de l'interface, hors affichage.
+    int uiHeapAllocCount;
+    /// @brief Variation du nombre d'allocations SDL vivantes (SDL_GetNumAllocations()),
+    /// hors affichage. Les allocations libérées dans la frame ne sont pas vues.
+    int sdlAllocDelta;
+} GamePerfSample;
+
+/// @brief Affichage des performances du jeu.
+/// Les mesures sont enregistrées à chaque frame dans un tampon circulaire,
+/// même lorsque l'affichage est caché. Les textes et le graphe ne sont mis à
+/// jour que quelques fois par seconde, et les compteurs sont relevés avant la
+/// mise à jour et le rendu de l'affichage, qui ne se mesure donc pas lui-même.
+/// Les compteurs partagés du moteur ne sont pas remis à zéro : l'affichage
+/// mesure la différence entre deux relevés.
+typedef struct GamePerfOverlay
+{
+    UICanvas* m_canvas;
+    UILabel* m_labels[GAME_PERF_LINE_COUNT];
+    UIFillRect* m_bars[GAME_PERF_SAMPLE_COUNT];
+    bool m_isVisible;
+
+    GamePerfSample m_samples[GAME_PERF_SAMPLE_COUNT];
+    /// @brief Indice de la prochaine mesure dans m_samples.
+    int m_sampleIdx;
+    int m_sampleCount;
+    GamePerfSample m_currSample;
+
+    /// @brief Relevés des compteurs partagés au début de la période mesurée.
+    int m_uiAllocMark;
+    int m_sdlAllocMark;
+    Uint64 m_nodeUpdateMark;
+
+    Uint64 m_frameStart;
+    Uint64 m_updateEnd;
+    Uint64 m_lastRefresh;
+} GamePerfOverlay;
+
+GamePerfOverlay* GamePerfOverlay_create(TTF_Font* font);
+void GamePerfOverlay_destroy(GamePerfOverlay* self);
+
+void GamePerfOverlay_setVisible(GamePerfOverlay* self, bool isVisible);
+
+INLINE bool GamePerfOverlay_isVisible(GamePerfOverlay* self)
+{
+    assert(self && "The GamePerfOverlay must be created");
+    return self->m_isVisible;
+}
+
+/// @brief Début d'une frame, avant la mise à jour de la scène.
+/// @param self l'affichage.
+void GamePerfOverlay_beginFrame(GamePerfOverlay* self);
+
+/// @brief Fin de la mise à jour de la scène.
+/// Relève les compteurs de mise à jour puis met à jour l'affichage s'il est visible.
+/// @param self l'affichage.
+void GamePerfOverlay_endUpdate(GamePerfOverlay* self);
+
+/// @brief Dessine l'affichage s'il est visible.
+/// Doit être appelée après la soumission de la file de rendu de la scène,
+/// dont les statistiques sont relevées.
+/// @param self l'affichage.
+void GamePerfOverlay_render(GamePerfOverlay* self);
+
+/// @brief Fin d'une frame, après la présentation du rendu.
+/// @param self l'affichage.
+void GamePerfOverlay_endFrame(GamePerfOverlay* self);
@@ -0,0 +1,209 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "game/game_sim.h"
+
+static int SDLCALL GameSim_threadMain(void* data);
+
+static void GameSim_updateCells(GameSim* self)
+{
+    GameSnapshot* state = &(self->m_state);
+    float totalPaddingX = self->m_padding.x * 2.f;
+    float totalPaddingY = self->m_padding.y * 2.f;
+    float totalSpacingX = self->m_spacing.x * (GAME_GRID_SIZE - 1);
+    float totalSpacingY = self->m_spacing.y * (GAME_GRID_SIZE - 1);
+    Vec2 gridSize = AABB_getSize(&(self->m_gridAABB));
+    float cellW = (gridSize.x - totalPaddingX - totalSpacingX) / GAME_GRID_SIZE;
+    float cellH = (gridSize.y - totalPaddingY - totalSpacingY) / GAME_GRID_SIZE;
+
+    for (int i = 0; i < GAME_GRID_SIZE; i++)
+    {
+        for (int j = 0; j < GAME_GRID_SIZE; j++)
+        {
+            float cellX = self->m_gridAABB.lower.x + self->m_padding.x + j * (cellW + self->m_spacing.x);
+            float cellY = self->m_gridAABB.lower.y + self->m_padding.y + i * (cellH + self->m_spacing.y);
+            state->cells[GAME_GRID_SIZE - 1 - i][j].lower = Vec2_set(cellX, cellY);
+            state->cells[GAME_GRID_SIZE - 1 - i][j].upper = Vec2_set(cellX + cellW, cellY + cellH);
+        }
+    }
+}
+
+/// @brief Exécute un pas de simulation.
+static void GameSim_step(GameSim* self)
+{
+    GameSnapshot* state = &(self->m_state);
+    GameSim_updateCells(self);
+
+    if (self->m_input.selectPressed)
+    {
+        for (int i = 0; i < GAME_GRID_SIZE; i++)
+        {
+            for (int j = 0; j < GAME_GRID_SIZE; j++)
+            {
+                if (AABB_containsPoint(&(state->cells[i][j]), self->m_input.selectPosition))
+                {
+                    state->selectedRowIndex = i;
+                    state->selectedColIndex = j;
+                }
+            }
+        }
+    }
+
+    // Les commandes ne sont appliquées qu'une fois
+    memset(&(self->m_input), 0, sizeof(GameSimInput));
+    state->stepIndex++;
+}
+
+/// @brief Publie l'état courant de la simulation.
+static void GameSim_publish(GameSim* self)
+{
+    // L'instantané arrière n'est lu par personne : il est écrit hors verrou
+    const int backIdx = 1 - self->m_frontIdx;
+    self->m_snapshots[backIdx] = self->m_state;
+
+    SDL_LockMutex(self->m_mutex);
+    self->m_frontIdx = backIdx;
+    SDL_UnlockMutex(self->m_mutex);
+}
+
+/// @brief Exécute les pas écoulés depuis le dernier appel puis publie l'état.
+static void GameSim_tick(GameSim* self)
+{
+    Timer_update(self->m_timer);
+    const int stepCount = Timer_getFixedStepCount(self->m_timer);
+    if (stepCount == 0) return;
+
+    // Les commandes en attente sont récupérées pour le premier pas
+    SDL_LockMutex(self->m_mutex);
+    self->m_input = self->m_pendingInput;
+    memset(&(self->m_pendingInput), 0, sizeof(GameSimInput));
+    SDL_UnlockMutex(self->m_mutex);
+
+    PROFILE_BEGIN("GameSim_step");
+    for (int i = 0; i < stepCount; i++)
+    {
+        GameSim_step(self);
+    }
+    PROFILE_END();
+
+    GameSim_publish(self);
+}
+
+GameSim* GameSim_create(bool isThreaded)
+{
+    GameSim* self = (GameSim*)calloc(1, sizeof(GameSim));
+    AssertNew(self);
+
+    self->m_padding = Vec2_set(0.0f, 0.0f);
+    self->m_spacing = Vec2_set(0.1f, 0.1f);
+    self->m_gridAABB.lower = Vec2_add(Vec2_set(-4.f, -4.f), Vec2_set(8.0f, 4.5f));
+    self->m_gridAABB.upper = Vec2_add(Vec2_set(+4.f, +4.f), Vec2_set(8.0f, 4.5f));
+
+    self->m_mutex = SDL_CreateMutex();
+    AssertNew(self->m_mutex);
+
+    self->m_timer = Timer_create();
+    Timer_setFixedStep(self->m_timer, 1.0 / GAME_SIM_STEP_RATE, GAME_SIM_MAX_STEPS);
+    Timer_start(self->m_timer);
+
+    // Premier état, disponible avant le premier pas
+    GameSim_updateCells(self);
+    self->m_snapshots[0] = self->m_state;
+    self->m_snapshots[1] = self->m_state;
+
+    // Le thread n'est créé qu'au démarrage du niveau
+    self->m_isThreadRequested = isThreaded;
+
+    return self;
+}
+
+void GameSim_destroy(GameSim* self)
+{
+    if (!self) return;
+
+    GameSim_stop(self);
+    Timer_destroy(self->m_timer);
+    SDL_DestroyMutex(self->m_mutex);
+    free(self);
+}
+
+static int SDLCALL GameSim_threadMain(void* data)
+{
+    GameSim* self = (GameSim*)data;
+    while (SDL_GetAtomicInt(&(self->m_stopping)) == 0)
+    {
+        GameSim_tick(self);
+
+        // Attend le prochain pas
+        const double remaining = (1.0 - Timer_getFixedAlpha(self->m_timer))
+            * Timer_getFixedDelta(self->m_timer);
+        SDL_DelayPrecise((Uint64)(remaining * 1e9));
+    }
+    return 0;
+}
+
+void GameSim_start(GameSim* self)
+{
+    assert(self && "The GameSim must be created");
+    if (self->m_isRunning) return;
+
+    // Le temps écoulé hors du niveau n'est pas rattrapé
+    Timer_start(self->m_timer);
+    self->m_isRunning = true;
+
+    if (self->m_isThreadRequested)
+    {
+        SDL_SetAtomicInt(&(self->m_stopping), 0);
+        self->m_thread = SDL_CreateThread(GameSim_threadMain, "GameSim", self);
+        if (self->m_thread == NULL)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to create the simulation thread");
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", SDL_GetError());
+        }
+    }
+    self->m_isThreaded = (self->m_thread != NULL);
+}
+
+void GameSim_stop(GameSim* self)
+{
+    assert(self && "The GameSim must be created");
+    if (self->m_isRunning == false) return;
+
+    if (self->m_thread)
+    {
+        SDL_SetAtomicInt(&(self->m_stopping), 1);
+        SDL_WaitThread(self->m_thread, NULL);
+        self->m_thread = NULL;
+    }
+    self->m_isThreaded = false;
+    self->m_isRunning = false;
+}
+
+void GameSim_update(GameSim* self)
+{
+    assert(self && "The GameSim must be created");
+    if (self->m_isThreaded || self->m_isRunning == false) return;
+
+    GameSim_tick(self);
+}
+
+void GameSim_select(GameSim* self, Vec2 position)
+{
+    assert(self && "The GameSim must be created");
+    SDL_LockMutex(self->m_mutex);
+    self->m_pendingInput.selectPressed = true;
+    self->m_pendingInput.selectPosition = position;
+    SDL_UnlockMutex(self->m_mutex);
+}
+
+void GameSim_getSnapshot(GameSim* self, GameSnapshot* snapshot)
+{
+    assert(self && "The GameSim must be created");
+    assert(snapshot && "snapshot must not be NULL");
+    SDL_LockMutex(self->m_mutex);
+    *snapshot = self->m_snapshots[self->m_frontIdx];
+    SDL_UnlockMutex(self->m_mutex);
+}
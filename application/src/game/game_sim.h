@@ -0,0 +1,121 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "game/core/game_core.h"
+
+/// @brief Nombre de pas de simulation par seconde.
+#define GAME_SIM_STEP_RATE 60
+
+/// @brief Nombre maximal de pas de simulation rattrapés en une mise à jour.
+#define GAME_SIM_MAX_STEPS 5
+
+/// @brief Etat de la simulation tel que vu par le rendu.
+/// Un instantané publié n'est plus modifié ; le thread principal n'en lit
+/// que des copies.
+typedef struct GameSnapshot
+{
+    AABB cells[GAME_GRID_SIZE][GAME_GRID_SIZE];
+    int selectedRowIndex;
+    int selectedColIndex;
+
+    /// @brief Nombre de pas simulés lors de la publication.
+    Uint64 stepIndex;
+} GameSnapshot;
+
+/// @brief Commandes transmises par le thread principal à la simulation.
+/// Elles sont appliquées au premier pas suivant leur envoi.
+typedef struct GameSimInput
+{
+    bool selectPressed;
+    Vec2 selectPosition;
+} GameSimInput;
+
+/// @brief Simulation du jeu à pas fixe.
+///
+/// La simulation n'avance qu'entre GameSim_start() et GameSim_stop(), appelées
+/// à l'entrée et à la sortie du niveau. En mode multi-thread, elle tourne
+/// alors sur son propre thread à GAME_SIM_STEP_RATE pas par seconde,
+/// indépendamment du rendu. Sinon, les pas sont exécutés sur le thread
+/// principal par GameSim_update().
+///
+/// Propriété des données :
+/// - m_timer, m_state et m_input appartiennent au thread de simulation
+///   (au thread principal en mode mono-thread) ;
+/// - m_pendingInput et m_frontIdx sont protégés par m_mutex ;
+/// - le thread de simulation écrit hors verrou dans l'instantané arrière,
+///   que personne d'autre ne lit, puis l'échange avec l'instantané avant sous
+///   verrou. Le thread principal copie l'instantané avant sous verrou.
+typedef struct GameSim
+{
+    /// @brief Indique si la simulation doit avoir son propre thread une fois démarrée.
+    bool m_isThreadRequested;
+    bool m_isRunning;
+    /// @brief Indique si le thread de simulation est en cours d'exécution.
+    bool m_isThreaded;
+    SDL_Thread* m_thread;
+    SDL_AtomicInt m_stopping;
+
+    Timer* m_timer;
+    GameSnapshot m_state;
+    GameSimInput m_input;
+
+    /// @brief Paramètres de la grille, constants après la création.
+    AABB m_gridAABB;
+    Vec2 m_padding;
+    Vec2 m_spacing;
+
+    SDL_Mutex* m_mutex;
+    GameSimInput m_pendingInput;
+    GameSnapshot m_snapshots[2];
+    /// @brief Indice de l'instantané publié dans m_snapshots.
+    int m_frontIdx;
+} GameSim;
+
+/// @brief Crée la simulation du jeu, à l'arrêt.
+/// @param isThreaded indique si la simulation doit avoir son propre thread.
+/// @return La simulation créée.
+GameSim* GameSim_create(bool isThreaded);
+
+/// @brief Détruit la simulation du jeu, après l'arrêt de son thread.
+/// @param self la simulation.
+void GameSim_destroy(GameSim* self);
+
+/// @brief Démarre la simulation à l'entrée du niveau.
+/// En mode multi-thread, crée le thread de simulation. S'il ne peut pas être
+/// créé, la simulation s'exécute sur le thread principal.
+/// @param self la simulation.
+void GameSim_start(GameSim* self);
+
+/// @brief Arrête la simulation à la sortie du niveau et attend la fin de son
+/// thread. Le dernier instantané publié reste disponible.
+/// @param self la simulation.
+void GameSim_stop(GameSim* self);
+
+/// @brief Exécute les pas de simulation écoulés depuis le dernier appel.
+/// Ne fait rien en mode multi-thread. Appelée par le thread principal.
+/// @param self la simulation.
+void GameSim_update(GameSim* self);
+
+/// @brief Demande la sélection de la cellule contenant une position.
+/// Appelée par le thread principal.
+/// @param self la simulation.
+/// @param position la position dans le référentiel monde.
+void GameSim_select(GameSim* self, Vec2 position);
+
+/// @brief Copie le dernier instantané publié par la simulation.
+/// Appelée par le thread principal.
+/// @param self la simulation.
+/// @param snapshot l'instantané de destination.
+void GameSim_getSnapshot(GameSim* self, GameSnapshot* snapshot);
+
+INLINE bool GameSim_isThreaded(GameSim* self)
+{
+    assert(self && "The GameSim must be created");
+    return self->m_isThreaded;
+}
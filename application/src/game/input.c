@@ -120,6 +120,8 @@ void Input_beforeEventLoop(Input* self)
     mouseInput->moved = false;
 
     debugInput->gizmosPressed = false;
+    debugInput->profilerPressed = false;
+    debugInput->perfOverlayPressed = false;
 
     for (int i = 0; i < MAX_PLAYER_COUNT; i++)
     {
@@ -219,6 +221,12 @@ void Input_processKeyDown(Input* self, PlayerInput* playerInput, bool repeat, in
     case SDL_SCANCODE_F1:
         self->debug.gizmosPressed = true;
         break;
+    case SDL_SCANCODE_F2:
+        self->debug.profilerPressed = true;
+        break;
+    case SDL_SCANCODE_F3:
+        self->debug.perfOverlayPressed = true;
+        break;
     case SDL_SCANCODE_ESCAPE:
         self->quitPressed = true;
         break;
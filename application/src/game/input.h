@@ -17,6 +17,8 @@ typedef struct PlayerInput
 typedef struct DebugInput
 {
     bool gizmosPressed;
+    bool profilerPressed;
+    bool perfOverlayPressed;
 } DebugInput;
 
 typedef struct MouseInput
@@ -15,6 +15,16 @@ Scene* Scene_create()
     self->m_assets = AssetManager_create(SPRITE_COUNT, FONT_COUNT);
     Game_addAssets(self->m_assets);
 
+    // Les assets sont décodés en arrière-plan pendant la création de la scène
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        AssetManager_requestSpriteSheet(self->m_assets, i);
+    }
+    for (int i = 0; i < FONT_COUNT; i++)
+    {
+        AssetManager_requestFont(self->m_assets, i);
+    }
+
     self->m_input = Input_create();
 
     int outW = 0, outH = 0;
@@ -24,7 +34,10 @@ Scene* Scene_create()
     self->m_state = SCENE_STATE_FADING_IN;
     self->m_fadingTime = 0.5f;
     self->m_uiManager = GameUIManager_create(self);
+    GameUIManager_preloadPages(self->m_uiManager);
+    self->m_gameSim = GameSim_create(g_gameConfig.threadedSim);
     self->m_gameGraphics = GameGraphics_create(self);
+    self->m_perfOverlay = GamePerfOverlay_create(AssetManager_getFont(self->m_assets, FONT_NORMAL));
 
     g_gameConfig.nextScene = GAME_SCENE_QUIT;
 
@@ -40,6 +53,8 @@ void Scene_destroy(Scene* self)
     Camera_destroy(self->m_camera);
     GameUIManager_destroy(self->m_uiManager);
     GameGraphics_destroy(self->m_gameGraphics);
+    GameSim_destroy(self->m_gameSim);
+    GamePerfOverlay_destroy(self->m_perfOverlay);
 
     free(self);
 }
@@ -50,26 +65,64 @@ void Scene_mainLoop(Scene* self)
     Timer_setTimeScale(g_time, 1.f);
     while (true)
     {
+        PROFILE_BEGIN("Frame");
+        GamePerfOverlay_beginFrame(self->m_perfOverlay);
+
         // Met à jour le temps
         Timer_update(g_time);
 
+        PROFILE_BEGIN("Scene_update");
         Scene_update(self);
+        PROFILE_END();
+        GamePerfOverlay_endUpdate(self->m_perfOverlay);
 
         Input* input = Scene_getInput(self);
         if (input->quitPressed)
         {
+            PROFILE_END();
             g_gameConfig.nextScene = GAME_SCENE_QUIT;
             return;
         }
 
         if (self->m_state == SCENE_STATE_FINISHED)
+        {
+            PROFILE_END();
             return;
+        }
 
         // Rend la scène
+        PROFILE_BEGIN("Scene_render");
         Scene_render(self);
+        PROFILE_END();
 
         // Affiche le nouveau rendu
+        PROFILE_BEGIN("SDL_RenderPresent");
         SDL_RenderPresent(g_renderer);
+        PROFILE_END();
+
+        GamePerfOverlay_endFrame(self->m_perfOverlay);
+        PROFILE_END();
+    }
+}
+
+/// @brief Démarre une capture du profileur, ou l'arrête et l'enregistre
+/// au format trace_event de Chrome.
+static void Scene_toggleProfiler()
+{
+    if (Profiler_isCapturing() == false)
+    {
+        Profiler_start();
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Profiler capture started");
+        return;
+    }
+
+    Profiler_stop();
+
+    char path[1024] = { 0 };
+    SDL_snprintf(path, sizeof(path), "%sprofile_trace.json", g_paths.base);
+    if (Profiler_saveChromeTrace(path))
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Profiler capture saved to %s", path);
     }
 }
 
@@ -77,22 +130,46 @@ void Scene_update(Scene* self)
 {
     assert(self && "The Scene must be created");
     Game_updateSizes();
+    UIObject_resetLayoutCount();
+
+    PROFILE_BEGIN("Input_update");
     Input_update(self->m_input);
+    PROFILE_END();
 
+    PROFILE_BEGIN("Camera_updateViewport");
     Camera_updateViewport(self->m_camera, g_renderer);
+    PROFILE_END();
+
+    AssetManager_update(self->m_assets);
+
+    PROFILE_BEGIN("AssetManager_updateFontSizes");
     AssetManager_updateFontSizes(self->m_assets);
+    PROFILE_END();
 
+    PROFILE_BEGIN("GameUIManager_update");
     GameUIManager_update(self->m_uiManager, &(self->m_input->uiInput));
+    PROFILE_END();
 
     if (g_gameConfig.inLevel)
     {
+        PROFILE_BEGIN("GameGraphics_update");
         GameGraphics_update(self->m_gameGraphics);
+        PROFILE_END();
     }
 
     if (self->m_input->debug.gizmosPressed)
     {
         g_drawUIGizmos = !g_drawUIGizmos;
     }
+    if (self->m_input->debug.perfOverlayPressed)
+    {
+        GamePerfOverlay* overlay = self->m_perfOverlay;
+        GamePerfOverlay_setVisible(overlay, !GamePerfOverlay_isVisible(overlay));
+    }
+    if (self->m_input->debug.profilerPressed)
+    {
+        Scene_toggleProfiler();
+    }
 
     if (self->m_state == SCENE_STATE_FADING_IN)
     {
@@ -135,13 +212,22 @@ void Scene_render(Scene* self)
     SDL_SetRenderDrawColor(g_renderer, bgColor.r, bgColor.g, bgColor.b, 255);
     SDL_RenderFillRect(g_renderer, NULL);
 
+    // Enregistre les commandes de rendu de l'interface puis du jeu.
+    // Les cellules de la grille ne se superposent pas : leur couche est triable.
+    SpriteBatch_resetStats(g_spriteBatch);
+    RenderQueue_begin(g_renderQueue);
+    RenderQueue_setLayer(g_renderQueue, SCENE_LAYER_UI, false);
+
     GameUIManager_render(self->m_uiManager);
 
     if (g_gameConfig.inLevel)
     {
+        RenderQueue_setLayer(g_renderQueue, SCENE_LAYER_GAME, true);
         GameGraphics_render(self->m_gameGraphics);
     }
 
+    RenderQueue_end(g_renderQueue);
+
     // Fading
     if ((self->m_state == SCENE_STATE_FADING_IN) ||
         (self->m_state == SCENE_STATE_FADING_OUT))
@@ -154,6 +240,8 @@ void Scene_render(Scene* self)
         SDL_SetRenderDrawColor(g_renderer, 0, 0, 0, opacity);
         SDL_RenderFillRect(g_renderer, NULL);
     }
+
+    GamePerfOverlay_render(self->m_perfOverlay);
 }
 
 void Scene_drawGizmos(Scene* self)
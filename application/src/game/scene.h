@@ -12,6 +12,15 @@
 #include "game/input.h"
 #include "game/ui/game_ui_manager.h"
 #include "game/game_graphics.h"
+#include "game/game_perf_overlay.h"
+#include "game/game_sim.h"
+
+/// @brief Couches de la file de commandes de rendu de la scène.
+typedef enum SceneLayer
+{
+    SCENE_LAYER_UI,
+    SCENE_LAYER_GAME,
+} SceneLayer;
 
 /// @brief Structure représentant la scène du menu principal du jeu.
 typedef struct Scene
@@ -21,7 +30,9 @@ typedef struct Scene
     Input* m_input;
     GameUIManager* m_uiManager;
 
+    GameSim* m_gameSim;
     GameGraphics* m_gameGraphics;
+    GamePerfOverlay* m_perfOverlay;
     bool m_drawGizmos;
     SceneState m_state;
     float m_accu;
@@ -85,4 +96,11 @@ INLINE Camera* Scene_getCamera(Scene* self)
     return self->m_camera;
 }
 
-
+/// @brief Renvoie la simulation du jeu de la scène.
+/// @param self la scène.
+/// @return La simulation du jeu de la scène.
+INLINE GameSim* Scene_getGameSim(Scene* self)
+{
+    assert(self && "The Scene must be created");
+    return self->m_gameSim;
+}
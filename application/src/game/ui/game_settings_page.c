@@ -30,6 +30,21 @@ static void GameSettingsPage_onItemChanged(void* selectable, int currItemIdx, in
     printf("List item changed: %s\n", UIObject_getObjectName(selectable));
 }
 
+/// @brief Sélectionne dans les listes les paramètres courants.
+static void GameSettingsPage_syncSettings(GameSettingsPage* self)
+{
+    SDL_WindowFlags windowFlags = SDL_GetWindowFlags(g_window);
+    if (windowFlags & SDL_WINDOW_FULLSCREEN)
+    {
+        UIList_setSelectedItem(self->m_fullscreenList, 1);
+    }
+    else
+    {
+        UIList_setSelectedItem(self->m_fullscreenList, 0);
+    }
+    UIList_setSelectedItem(self->m_elapsedList, (int)g_gameConfig.showElapsedTime);
+}
+
 GameSettingsPage* GameSettingsPage_create(Scene* scene, GameUIManager* manager)
 {
     UICanvas* canvas = manager->m_canvas;
@@ -54,6 +69,7 @@ GameSettingsPage* GameSettingsPage_create(Scene* scene, GameUIManager* manager)
     rect.offsetMin = Vec2_zero;
     rect.offsetMax = Vec2_zero;
     UIObject_setRect(self->m_mainPanel, rect);
+    UIObject_setRenderCacheEnabled(self->m_mainPanel, true);
 
     UIGridLayout* layout = UIGridLayout_create("main-layout", 4, 1);
     UIObject_setParent(layout, self->m_mainPanel);
@@ -91,16 +107,6 @@ GameSettingsPage* GameSettingsPage_create(Scene* scene, GameUIManager* manager)
     UISelectable_setUserId(fullscreenList, GAME_UI_ACTION_CHANGE_FULLSCREEN);
     UIList_setOnItemChangedCallback(fullscreenList, GameSettingsPage_onItemChanged);
 
-    SDL_WindowFlags windowFlags = SDL_GetWindowFlags(g_window);
-    if (windowFlags & SDL_WINDOW_FULLSCREEN)
-    {
-        UIList_setSelectedItem(fullscreenList, 1);
-    }
-    else
-    {
-        UIList_setSelectedItem(fullscreenList, 0);
-    }
-
     UIGridLayout_addObject(layout, fullscreenList, 1, 0, 1, 1);
     UIFocusManager_addSelectable(self->m_focusManager, fullscreenList);
 
@@ -116,7 +122,6 @@ GameSettingsPage* GameSettingsPage_create(Scene* scene, GameUIManager* manager)
     {
         UIList_setItemString(elapsedList, i, toggleItems[i]);
     }
-    UIList_setSelectedItem(elapsedList, (int)g_gameConfig.showElapsedTime);
     UIStyle_setDefaultList(elapsedList, assets);
     UISelectable_setUserData(elapsedList, self);
     UISelectable_setUserId(elapsedList, 0);
@@ -151,6 +156,7 @@ GameSettingsPage* GameSettingsPage_create(Scene* scene, GameUIManager* manager)
     UIGridLayout_addObject(buttonlayout, backButton, 0, 1, 1, 1);
     UIFocusManager_addSelectable(self->m_focusManager, backButton);
 
+    GameSettingsPage_syncSettings(self);
     UIFocusManager_setFocused(self->m_focusManager, fullscreenList);
 
     return self;
@@ -166,6 +172,18 @@ void GameSettingsPage_destroy(GameSettingsPage* self)
     free(self);
 }
 
+void GameSettingsPage_setVisible(GameSettingsPage* self, bool visible)
+{
+    assert(self && "self must not be NULL");
+    UIObject_setEnabled(self->m_mainPanel, visible);
+    if (visible)
+    {
+        self->m_nextAction = GAME_UI_ACTION_NONE;
+        GameSettingsPage_syncSettings(self);
+        UIFocusManager_setFocused(self->m_focusManager, self->m_fullscreenList);
+    }
+}
+
 void GameSettingsPage_update(GameSettingsPage* self, UIInput* input)
 {
     UIFocusManager_update(self->m_focusManager, input);
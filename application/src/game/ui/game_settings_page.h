@@ -26,3 +26,9 @@ typedef struct GameSettingsPage
 GameSettingsPage* GameSettingsPage_create(Scene* scene, GameUIManager *manager);
 void GameSettingsPage_destroy(GameSettingsPage* self);
 void GameSettingsPage_update(GameSettingsPage* self, UIInput* input);
+
+/// @brief Affiche ou cache la page sans la détruire.
+/// A l'affichage, les listes reprennent les paramètres courants.
+/// @param self la page.
+/// @param visible true pour afficher la page.
+void GameSettingsPage_setVisible(GameSettingsPage* self, bool visible);
@@ -45,6 +45,7 @@ GameTitlePage* GameTitlePage_create(Scene* scene, GameUIManager *manager)
     rect.offsetMin = Vec2_set(-75.f, 0.0f);
     rect.offsetMax = Vec2_set(+75.f, 0.0f);
     UIObject_setRect(self->m_mainPanel, rect);
+    UIObject_setRenderCacheEnabled(self->m_mainPanel, true);
 
     UIGridLayout* layout = UIGridLayout_create("main-layout", 4, 1);
     UIObject_setParent(layout, self->m_mainPanel);
@@ -80,6 +81,7 @@ GameTitlePage* GameTitlePage_create(Scene* scene, GameUIManager *manager)
         UIFocusManager_addSelectable(self->m_focusManager, button);
         if (i == 0)
         {
+            self->m_startButton = button;
             UIFocusManager_setFocused(self->m_focusManager, button);
         }
     }
@@ -97,6 +99,17 @@ void GameTitlePage_destroy(GameTitlePage* self)
     free(self);
 }
 
+void GameTitlePage_setVisible(GameTitlePage* self, bool visible)
+{
+    assert(self && "self must not be NULL");
+    UIObject_setEnabled(self->m_mainPanel, visible);
+    if (visible)
+    {
+        self->m_nextAction = GAME_UI_ACTION_NONE;
+        UIFocusManager_setFocused(self->m_focusManager, self->m_startButton);
+    }
+}
+
 void GameTitlePage_update(GameTitlePage* self, UIInput* input)
 {
     UIFocusManager_update(self->m_focusManager, input);
@@ -19,9 +19,16 @@ typedef struct GameTitlePage
 
     GameUIAction m_nextAction;
     UIObject* m_mainPanel;
+    UIButton* m_startButton;
 } GameTitlePage;
 
 GameTitlePage* GameTitlePage_create(Scene* scene, GameUIManager *manager);
 void GameTitlePage_destroy(GameTitlePage* self);
 void GameTitlePage_update(GameTitlePage* self, UIInput* input);
 
+/// @brief Affiche ou cache la page sans la détruire.
+/// A l'affichage, le focus revient sur le premier bouton.
+/// @param self la page.
+/// @param visible true pour afficher la page.
+void GameTitlePage_setVisible(GameTitlePage* self, bool visible);
+
@@ -10,7 +10,12 @@
 #include "game/scene.h"
 #include "game/game_config.h"
 
-static void GameUIManager_closePages(GameUIManager* self);
+#define GAME_UI_PAGE_ARENA_SIZE (16 * 1024)
+
+static const char* s_pageNames[GAME_UI_PAGE_COUNT] = { "title", "settings" };
+
+static void GameUIManager_destroyPage(GameUIManager* self, GameUIPage page);
+static void GameUIManager_showPage(GameUIManager* self, GameUIPage page);
 
 GameUIManager* GameUIManager_create(Scene* scene)
 {
@@ -21,8 +26,15 @@ GameUIManager* GameUIManager_create(Scene* scene)
 
     UICanvas* canvas = UICanvas_create("canvas");
     self->m_canvas = canvas;
-    self->m_mainPage = GameTitlePage_create(scene, self);
+    self->m_mainPage = NULL;
     self->m_settingsPage = NULL;
+    self->m_currPage = GAME_UI_PAGE_NONE;
+    self->m_memoryBudget = GAME_UI_DEFAULT_PAGE_BUDGET;
+    for (int i = 0; i < GAME_UI_PAGE_COUNT; i++)
+    {
+        self->m_pageArenas[i] = MemoryArena_create(GAME_UI_PAGE_ARENA_SIZE);
+    }
+    GameUIManager_showPage(self, GAME_UI_PAGE_TITLE);
 
     return self;
 }
@@ -31,32 +43,218 @@ void GameUIManager_destroy(GameUIManager* self)
 {
     if (!self) return;
 
-    GameUIManager_closePages(self);
+    self->m_currPage = GAME_UI_PAGE_NONE;
+    for (int i = 0; i < GAME_UI_PAGE_COUNT; i++)
+    {
+        GameUIManager_destroyPage(self, (GameUIPage)i);
+        MemoryArena_destroy(self->m_pageArenas[i]);
+    }
     UIObject_destroy(self->m_canvas);
 
     free(self);
 }
 
-static void GameUIManager_closePages(GameUIManager* self)
+static void GameUIManager_logAllocStats(GameUIPage page, const char* event)
 {
-    GameTitlePage_destroy(self->m_mainPage);
-    GameSettingsPage_destroy(self->m_settingsPage);
+    UIAllocStats stats = UIObject_getAllocStats();
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "UI page %s %s: %d arena allocs, %d heap allocs, %d heap frees, %d pool allocs, %d pool frees",
+        s_pageNames[page], event, stats.arenaAllocCount, stats.heapAllocCount, stats.heapFreeCount,
+        stats.poolAllocCount, stats.poolFreeCount
+    );
+}
 
-    self->m_mainPage = NULL;
-    self->m_settingsPage = NULL;
+static bool GameUIManager_isResident(GameUIManager* self, GameUIPage page)
+{
+    switch (page)
+    {
+    case GAME_UI_PAGE_TITLE:
+        return self->m_mainPage != NULL;
+    case GAME_UI_PAGE_SETTINGS:
+        return self->m_settingsPage != NULL;
+    default:
+        return false;
+    }
+}
+
+static void GameUIManager_setPageVisible(GameUIManager* self, GameUIPage page, bool visible)
+{
+    switch (page)
+    {
+    case GAME_UI_PAGE_TITLE:
+        GameTitlePage_setVisible(self->m_mainPage, visible);
+        break;
+    case GAME_UI_PAGE_SETTINGS:
+        GameSettingsPage_setVisible(self->m_settingsPage, visible);
+        break;
+    default:
+        break;
+    }
+}
+
+/// @brief Renvoie la mémoire utilisée par une page résidente.
+/// Sont comptés les nœuds alloués dans l'arène de la page, les textures de
+/// cache de rendu et les textes de ses objets, ainsi que son gestionnaire de focus.
+static size_t GameUIManager_getPageMemory(GameUIManager* self, GameUIPage page)
+{
+    if (GameUIManager_isResident(self, page) == false) return 0;
+
+    size_t memory = MemoryArena_getStats(self->m_pageArenas[page]).usedSize;
+    switch (page)
+    {
+    case GAME_UI_PAGE_TITLE:
+        memory += UIObject_getMemoryEstimate(self->m_mainPage->m_mainPanel);
+        memory += UIFocusManager_getMemory(self->m_mainPage->m_focusManager);
+        break;
+    case GAME_UI_PAGE_SETTINGS:
+        memory += UIObject_getMemoryEstimate(self->m_settingsPage->m_mainPanel);
+        memory += UIFocusManager_getMemory(self->m_settingsPage->m_focusManager);
+        break;
+    default:
+        break;
+    }
+    return memory;
+}
+
+size_t GameUIManager_getResidentMemory(GameUIManager* self)
+{
+    assert(self && "self must not be NULL");
+    size_t memory = 0;
+    for (int i = 0; i < GAME_UI_PAGE_COUNT; i++)
+    {
+        memory += GameUIManager_getPageMemory(self, (GameUIPage)i);
+    }
+    return memory;
+}
+
+static void GameUIManager_buildPage(GameUIManager* self, GameUIPage page)
+{
+    if (GameUIManager_isResident(self, page)) return;
+
+    UIObject_resetAllocStats();
+    MemoryArena* prevArena = UIObject_setArena(self->m_pageArenas[page]);
+    switch (page)
+    {
+    case GAME_UI_PAGE_TITLE:
+        self->m_mainPage = GameTitlePage_create(self->m_scene, self);
+        break;
+    case GAME_UI_PAGE_SETTINGS:
+        self->m_settingsPage = GameSettingsPage_create(self->m_scene, self);
+        break;
+    default:
+        assert(false);
+        break;
+    }
+    UIObject_setArena(prevArena);
+
+    // Une page construite reste cachée jusqu'à son ouverture
+    GameUIManager_setPageVisible(self, page, false);
+
+    GameUIManager_logAllocStats(page, "open");
+}
+
+static void GameUIManager_destroyPage(GameUIManager* self, GameUIPage page)
+{
+    if (GameUIManager_isResident(self, page) == false) return;
+    assert(page != self->m_currPage && "The current page cannot be destroyed");
+
+    UIObject_resetAllocStats();
+    switch (page)
+    {
+    case GAME_UI_PAGE_TITLE:
+        GameTitlePage_destroy(self->m_mainPage);
+        self->m_mainPage = NULL;
+        break;
+    case GAME_UI_PAGE_SETTINGS:
+        GameSettingsPage_destroy(self->m_settingsPage);
+        self->m_settingsPage = NULL;
+        break;
+    default:
+        break;
+    }
+
+    // Les objets de la page sont détruits : leur mémoire est libérée en une fois
+    MemoryArena_reset(self->m_pageArenas[page]);
+
+    GameUIManager_logAllocStats(page, "close");
+}
+
+/// @brief Détruit les pages cachées les moins récemment ouvertes tant que
+/// le budget mémoire est dépassé.
+static void GameUIManager_applyBudget(GameUIManager* self)
+{
+    while (GameUIManager_getResidentMemory(self) > self->m_memoryBudget)
+    {
+        GameUIPage victim = GAME_UI_PAGE_NONE;
+        for (int i = 0; i < GAME_UI_PAGE_COUNT; i++)
+        {
+            GameUIPage page = (GameUIPage)i;
+            if (page == self->m_currPage) continue;
+            if (GameUIManager_isResident(self, page) == false) continue;
+
+            if (victim == GAME_UI_PAGE_NONE || self->m_pageLastUse[page] < self->m_pageLastUse[victim])
+            {
+                victim = page;
+            }
+        }
+        if (victim == GAME_UI_PAGE_NONE) break;
+
+        GameUIManager_destroyPage(self, victim);
+    }
+}
+
+static void GameUIManager_hideCurrentPage(GameUIManager* self)
+{
+    if (self->m_currPage == GAME_UI_PAGE_NONE) return;
+
+    GameUIManager_setPageVisible(self, self->m_currPage, false);
+    self->m_currPage = GAME_UI_PAGE_NONE;
+}
+
+static void GameUIManager_showPage(GameUIManager* self, GameUIPage page)
+{
+    GameUIManager_hideCurrentPage(self);
+    GameUIManager_buildPage(self, page);
+    GameUIManager_setPageVisible(self, page, true);
+
+    self->m_currPage = page;
+    self->m_pageLastUse[page] = ++self->m_useCounter;
+
+    GameUIManager_applyBudget(self);
+}
+
+void GameUIManager_preloadPages(GameUIManager* self)
+{
+    assert(self && "self must not be NULL");
+    for (int i = 0; i < GAME_UI_PAGE_COUNT; i++)
+    {
+        GameUIManager_buildPage(self, (GameUIPage)i);
+    }
+    GameUIManager_applyBudget(self);
+}
+
+void GameUIManager_setMemoryBudget(GameUIManager* self, size_t budget)
+{
+    assert(self && "self must not be NULL");
+    self->m_memoryBudget = budget;
+    GameUIManager_applyBudget(self);
 }
 
 void GameUIManager_update(GameUIManager* self, UIInput* input)
 {
     Scene* scene = self->m_scene;
     UIObject_update(self->m_canvas);
-    if (self->m_mainPage)
+    switch (self->m_currPage)
     {
+    case GAME_UI_PAGE_TITLE:
         GameTitlePage_update(self->m_mainPage, input);
-    }
-    if (self->m_settingsPage)
-    {
+        break;
+    case GAME_UI_PAGE_SETTINGS:
         GameSettingsPage_update(self->m_settingsPage, input);
+        break;
+    default:
+        break;
     }
 
     if (self->m_nextAction != GAME_UI_ACTION_NONE)
@@ -64,19 +262,18 @@ void GameUIManager_update(GameUIManager* self, UIInput* input)
         switch (self->m_nextAction)
         {
         case GAME_UI_ACTION_OPEN_SETTINGS:
-            GameUIManager_closePages(self);
-            self->m_settingsPage = GameSettingsPage_create(scene, self);
+            GameUIManager_showPage(self, GAME_UI_PAGE_SETTINGS);
             break;
 
         case GAME_UI_ACTION_OPEN_MAIN:
-            GameUIManager_closePages(self);
-            self->m_mainPage = GameTitlePage_create(scene, self);
+            GameUIManager_showPage(self, GAME_UI_PAGE_TITLE);
             break;
 
         case GAME_UI_ACTION_START:
-            GameUIManager_closePages(self);
+            GameUIManager_hideCurrentPage(self);
             g_gameConfig.inLevel = true;
             GameGraphics_setEnabled(scene->m_gameGraphics, true);
+            GameSim_start(Scene_getGameSim(scene));
             break;
         }
         self->m_nextAction = GAME_UI_ACTION_NONE;
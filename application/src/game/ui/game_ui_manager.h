@@ -33,18 +33,61 @@ typedef enum GameUIAction
     GAME_UI_ACTION_COUNT
 } GameUIAction;
 
+typedef enum GameUIPage
+{
+    GAME_UI_PAGE_NONE = -1,
+    GAME_UI_PAGE_TITLE = 0,
+    GAME_UI_PAGE_SETTINGS,
+    GAME_UI_PAGE_COUNT
+} GameUIPage;
+
+/// @brief Budget mémoire par défaut des pages résidentes, en octets.
+/// Le cache de rendu d'un panneau principal en 1080p occupe à lui seul
+/// environ 8 Mo : le budget permet de garder quelques pages de cette taille.
+#define GAME_UI_DEFAULT_PAGE_BUDGET (32 * 1024 * 1024)
+
 typedef struct GameUIManager
 {
     Scene* m_scene;
     UICanvas* m_canvas;
+
+    /// @brief Pages résidentes, ou NULL si elles ne sont pas construites.
+    /// Seule la page courante est visible, les autres sont désactivées.
     GameTitlePage* m_mainPage;
     GameSettingsPage* m_settingsPage;
+    GameUIPage m_currPage;
     GameUIAction m_nextAction;
+
+    /// @brief Arène contenant les objets de chaque page.
+    MemoryArena* m_pageArenas[GAME_UI_PAGE_COUNT];
+    /// @brief Date de dernière ouverture de chaque page, pour l'éviction.
+    Uint64 m_pageLastUse[GAME_UI_PAGE_COUNT];
+    Uint64 m_useCounter;
+    /// @brief Mémoire maximale des pages résidentes.
+    size_t m_memoryBudget;
 } GameUIManager;
 
 GameUIManager* GameUIManager_create(Scene* scene);
 void GameUIManager_destroy(GameUIManager* self);
 
+/// @brief Construit les pages non résidentes sans les afficher.
+/// Cette fonction est appelée pendant le chargement de la scène ; les pages
+/// dépassant le budget mémoire ne sont pas conservées.
+/// @param self le gestionnaire d'interface.
+void GameUIManager_preloadPages(GameUIManager* self);
+
+/// @brief Définit la mémoire maximale des pages résidentes.
+/// Les pages cachées les moins récemment ouvertes sont détruites en premier.
+/// La page courante n'est jamais détruite.
+/// @param self le gestionnaire d'interface.
+/// @param budget le budget en octets.
+void GameUIManager_setMemoryBudget(GameUIManager* self, size_t budget);
+
+/// @brief Renvoie la mémoire utilisée par les pages résidentes.
+/// @param self le gestionnaire d'interface.
+/// @return La mémoire en octets.
+size_t GameUIManager_getResidentMemory(GameUIManager* self);
+
 void GameUIManager_render(GameUIManager* self);
 void GameUIManager_update(GameUIManager* self, UIInput* input);
 
@@ -41,6 +41,14 @@ int main(int argc, char* argv[])
     Game_init(&initParams);
     GameConfig_init();
 
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--threaded-sim") == 0)
+        {
+            g_gameConfig.threadedSim = true;
+        }
+    }
+
     SDL_SetLogPriority(SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_INFO);
     SDL_SetLogPriority(SDL_LOG_CATEGORY_RENDER, SDL_LOG_PRIORITY_INFO);
 
@@ -54,6 +62,7 @@ int main(int argc, char* argv[])
 
 #ifndef DEPLOY
     Game_createAssetsFromDev();
+    Game_createAssetPackFromDev(false);
 #endif
 
     //--------------------------------------------------------------------------
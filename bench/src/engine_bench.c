@@ -0,0 +1,660 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "game_engine.h"
+
+// Banc d'essai sans fenêtre visible (pilote vidéo "dummy", rendu logiciel).
+// Chaque scénario est exécuté pendant un nombre fixe de frames et les
+// résultats sont écrits sur la sortie standard en JSON (par défaut) ou en CSV.
+// Les allocations comptées sont celles passant par SDL (SDL_malloc, SDL_calloc,
+// SDL_realloc) et celles des objets de l'interface sur le tas ; les appels
+// directs à malloc() ou calloc() du moteur ne sont pas comptés.
+//
+// Utilisation : engine_bench [assetsPath] [--csv] [--frames N]
+
+#define BENCH_WIDTH 1280
+#define BENCH_HEIGHT 720
+#define BENCH_WARMUP_FRAMES 10
+#define BENCH_DEFAULT_FRAME_COUNT 200
+
+#define BENCH_LABEL_COUNT 1000
+#define BENCH_BUTTON_COUNT 400
+#define BENCH_BUTTON_COLUMNS 20
+#define BENCH_TREE_DEPTH 256
+#define BENCH_SPRITE_COUNT 5000
+#define BENCH_ASSET_LOAD_COUNT 20
+#define BENCH_DECODE_SIZE (8 * 1024 * 1024)
+
+#define BENCH_FONT_ID 0
+#define BENCH_SHEET_ID 0
+
+typedef enum BenchFormat
+{
+    BENCH_FORMAT_JSON,
+    BENCH_FORMAT_CSV,
+} BenchFormat;
+
+typedef struct BenchContext
+{
+    AssetManager* assets;
+    TTF_Font* font;
+    SpriteGroup* spriteGroup;
+    int frameCount;
+} BenchContext;
+
+/// @brief Scénario exécuté par le banc d'essai.
+typedef struct BenchScenario
+{
+    const char* name;
+    /// @brief Nombre d'éléments manipulés par le scénario.
+    int itemCount;
+    /// @brief Nombre de frames mesurées, ou 0 pour le nombre par défaut.
+    int frameCount;
+    /// @brief Nombre de frames de chauffe non mesurées, ou -1 pour la valeur par défaut.
+    int warmupCount;
+    /// @brief Indique si le scénario utilise la police et les sprites partagés.
+    bool usesAssets;
+    void* (*setup)(BenchContext* context, int itemCount);
+    void (*frame)(BenchContext* context, void* state, int frameIdx);
+    void (*teardown)(BenchContext* context, void* state);
+} BenchScenario;
+
+typedef struct BenchResult
+{
+    const char* name;
+    int itemCount;
+    int frameCount;
+    double meanMs;
+    double p50Ms;
+    double p95Ms;
+    double p99Ms;
+    double maxMs;
+    /// @brief Allocations SDL (SDL_malloc, SDL_calloc, SDL_realloc) par frame,
+    /// hors appels directs à malloc() ou calloc().
+    double sdlAllocsPerFrame;
+    /// @brief Allocations des objets de l'interface sur le tas par frame.
+    double uiHeapAllocsPerFrame;
+    /// @brief Nombre moyen de mises en page par frame.
+    double layoutsPerFrame;
+    /// @brief Statistiques de rendu de la dernière frame.
+    RenderQueueStats renderStats;
+} BenchResult;
+
+//------------------------------------------------------------------------------
+// Comptage des allocations
+
+static SDL_malloc_func s_mallocFunc = NULL;
+static SDL_calloc_func s_callocFunc = NULL;
+static SDL_realloc_func s_reallocFunc = NULL;
+static SDL_free_func s_freeFunc = NULL;
+static SDL_AtomicInt s_allocCount = { 0 };
+
+static void* SDLCALL Bench_malloc(size_t size)
+{
+    SDL_AddAtomicInt(&s_allocCount, 1);
+    return s_mallocFunc(size);
+}
+
+static void* SDLCALL Bench_calloc(size_t nmemb, size_t size)
+{
+    SDL_AddAtomicInt(&s_allocCount, 1);
+    return s_callocFunc(nmemb, size);
+}
+
+static void* SDLCALL Bench_realloc(void* mem, size_t size)
+{
+    SDL_AddAtomicInt(&s_allocCount, 1);
+    return s_reallocFunc(mem, size);
+}
+
+static void SDLCALL Bench_free(void* mem)
+{
+    s_freeFunc(mem);
+}
+
+/// @brief Installe les fonctions d'allocation comptées.
+/// Doit être appelée avant toute allocation par SDL.
+static void Bench_installAllocHooks()
+{
+    SDL_GetOriginalMemoryFunctions(&s_mallocFunc, &s_callocFunc, &s_reallocFunc, &s_freeFunc);
+    SDL_SetMemoryFunctions(Bench_malloc, Bench_calloc, Bench_realloc, Bench_free);
+}
+
+//------------------------------------------------------------------------------
+// Utilitaires
+
+static int Bench_compareTicks(const void* a, const void* b)
+{
+    const Uint64 ticksA = *(const Uint64*)a;
+    const Uint64 ticksB = *(const Uint64*)b;
+    return (ticksA < ticksB) ? -1 : (ticksA > ticksB) ? 1 : 0;
+}
+
+static double Bench_ticksToMs(Uint64 ticks)
+{
+    return 1000.0 * (double)ticks / (double)SDL_GetPerformanceFrequency();
+}
+
+/// @brief Renvoie le percentile d'un tableau trié, par la méthode du rang le plus proche.
+static Uint64 Bench_getPercentile(const Uint64* sortedTicks, int count, int percent)
+{
+    int rank = (percent * count + 99) / 100;
+    rank = Int_clamp(rank, 1, count);
+    return sortedTicks[rank - 1];
+}
+
+static UIRect Bench_getGridRect(int index, int columnCount, int rowCount)
+{
+    const int col = index % columnCount;
+    const int row = index / columnCount;
+    UIRect rect = { 0 };
+    rect.anchorMin = Vec2_set((float)col / columnCount, (float)row / rowCount);
+    rect.anchorMax = Vec2_set((float)(col + 1) / columnCount, (float)(row + 1) / rowCount);
+    return rect;
+}
+
+static void Bench_renderCanvas(UICanvas* canvas)
+{
+    UIObject_update(canvas);
+
+    Game_setRenderDrawColor(g_colors.black, 255);
+    SDL_RenderClear(g_renderer);
+
+    RenderQueue_begin(g_renderQueue);
+    UIObject_render(canvas);
+    RenderQueue_end(g_renderQueue);
+
+    SDL_RenderPresent(g_renderer);
+}
+
+//------------------------------------------------------------------------------
+// Scénario : labels statiques
+
+typedef struct LabelsState
+{
+    UICanvas* canvas;
+    UILabel** labels;
+    int labelCount;
+} LabelsState;
+
+static void* Labels_setup(BenchContext* context, int itemCount)
+{
+    LabelsState* state = (LabelsState*)calloc(1, sizeof(LabelsState));
+    AssertNew(state);
+
+    const int columnCount = 40;
+    const int rowCount = (itemCount + columnCount - 1) / columnCount;
+    state->canvas = UICanvas_create("canvas");
+    state->labels = (UILabel**)calloc(itemCount, sizeof(UILabel*));
+    AssertNew(state->labels);
+    state->labelCount = itemCount;
+    for (int i = 0; i < itemCount; i++)
+    {
+        char buffer[32] = { 0 };
+        SDL_snprintf(buffer, sizeof(buffer), "%d", i);
+
+        UILabel* label = UILabel_create("label", context->font);
+        UILabel_setTextString(label, buffer);
+        UIObject_setRect(label, Bench_getGridRect(i, columnCount, rowCount));
+        UIObject_setParent(label, state->canvas);
+        state->labels[i] = label;
+    }
+    return state;
+}
+
+static void Labels_frame(BenchContext* context, void* state, int frameIdx)
+{
+    LabelsState* labelsState = (LabelsState*)state;
+    Bench_renderCanvas(labelsState->canvas);
+}
+
+/// @brief Frame de référence : le texte est retransmis à SDL_ttf à chaque
+/// frame, comme avant le suivi des révisions du texte.
+static void LabelsForced_frame(BenchContext* context, void* state, int frameIdx)
+{
+    LabelsState* labelsState = (LabelsState*)state;
+    for (int i = 0; i < labelsState->labelCount; i++)
+    {
+        UITextCache_invalidate(&labelsState->labels[i]->m_textCache);
+        labelsState->labels[i]->m_textCache.hasColor = false;
+    }
+    Bench_renderCanvas(labelsState->canvas);
+}
+
+static void Labels_teardown(BenchContext* context, void* state)
+{
+    LabelsState* labelsState = (LabelsState*)state;
+    UICanvas_destroy(labelsState->canvas);
+    free(labelsState->labels);
+    free(labelsState);
+}
+
+//------------------------------------------------------------------------------
+// Scénario : boutons dans une grille, avec navigation
+
+typedef struct ButtonsState
+{
+    UICanvas* canvas;
+    UIFocusManager* focusManager;
+    UIInput input;
+} ButtonsState;
+
+static void* Buttons_setup(BenchContext* context, int itemCount)
+{
+    ButtonsState* state = (ButtonsState*)calloc(1, sizeof(ButtonsState));
+    AssertNew(state);
+
+    state->canvas = UICanvas_create("canvas");
+    state->focusManager = UIFocusManager_create();
+    UIInput_init(&state->input);
+
+    UIButton* firstButton = NULL;
+    UIGridLayout* grid = UIGridLayout_create("grid", 1, BENCH_BUTTON_COLUMNS);
+    UIGridLayout_setColumnSpacings(grid, 2.f);
+    UIGridLayout_setRowSizes(grid, 20.f);
+    UIGridLayout_setRowSpacings(grid, 2.f);
+    UIObject_setParent(grid, state->canvas);
+
+    for (int i = 0; i < itemCount; i++)
+    {
+        char buffer[32] = { 0 };
+        SDL_snprintf(buffer, sizeof(buffer), "Button %d", i);
+
+        UIButton* button = UIButton_create("button", context->font);
+        UIButton_setLabelString(button, buffer);
+        UIGridLayout_appendObject(grid, button, 1, 1);
+        UIFocusManager_addSelectable(state->focusManager, button);
+        if (firstButton == NULL) firstButton = button;
+    }
+    UIFocusManager_setFocused(state->focusManager, firstButton);
+    return state;
+}
+
+static void Buttons_frame(BenchContext* context, void* state, int frameIdx)
+{
+    ButtonsState* buttonsState = (ButtonsState*)state;
+    UIInput* input = &buttonsState->input;
+
+    // Parcours en serpentin : une frame sur deux, un déplacement vers la
+    // droite ou vers le bas
+    UIInput_beforeEventLoop(input);
+    UIInput_afterEventLoop(input);
+    input->mouseMoved = false;
+    input->lastInputType = UI_INPUT_TYPE_KEYBOARD;
+    if (frameIdx % 2 == 0) input->rightPressed = true;
+    else if (frameIdx % 20 == 1) input->downPressed = true;
+
+    UIFocusManager_update(buttonsState->focusManager, input);
+    Bench_renderCanvas(buttonsState->canvas);
+}
+
+static void Buttons_teardown(BenchContext* context, void* state)
+{
+    ButtonsState* buttonsState = (ButtonsState*)state;
+    UIFocusManager_destroy(buttonsState->focusManager);
+    UICanvas_destroy(buttonsState->canvas);
+    free(buttonsState);
+}
+
+//------------------------------------------------------------------------------
+// Scénario : arbre profond entièrement remis en page à chaque frame
+
+typedef struct DeepTreeState
+{
+    UICanvas* canvas;
+    UIObject* root;
+} DeepTreeState;
+
+static void* DeepTree_setup(BenchContext* context, int itemCount)
+{
+    DeepTreeState* state = (DeepTreeState*)calloc(1, sizeof(DeepTreeState));
+    AssertNew(state);
+
+    state->canvas = UICanvas_create("canvas");
+    state->root = UIObject_create("root");
+    UIObject_setParent(state->root, state->canvas);
+
+    UIRect rect = { 0 };
+    rect.anchorMax = Vec2_one;
+    rect.offsetMin = Vec2_set(+0.5f, +0.5f);
+    rect.offsetMax = Vec2_set(-0.5f, -0.5f);
+
+    void* parent = state->root;
+    for (int i = 1; i < itemCount; i++)
+    {
+        UIObject* node = UIObject_create("node");
+        UIObject_setRect(node, rect);
+        UIObject_setParent(node, parent);
+        parent = node;
+    }
+
+    UILabel* label = UILabel_create("leaf", context->font);
+    UILabel_setTextString(label, "leaf");
+    UIObject_setRect(label, rect);
+    UIObject_setParent(label, parent);
+
+    return state;
+}
+
+static void DeepTree_frame(BenchContext* context, void* state, int frameIdx)
+{
+    DeepTreeState* treeState = (DeepTreeState*)state;
+
+    // Le déplacement de la racine invalide la mise en page de tout l'arbre
+    const float offset = (float)(frameIdx % 2);
+    UIRect rect = { 0 };
+    rect.anchorMax = Vec2_one;
+    rect.offsetMin = Vec2_set(offset, offset);
+    rect.offsetMax = Vec2_set(offset, offset);
+    UIObject_setRect(treeState->root, rect);
+
+    Bench_renderCanvas(treeState->canvas);
+}
+
+static void DeepTree_teardown(BenchContext* context, void* state)
+{
+    DeepTreeState* treeState = (DeepTreeState*)state;
+    UICanvas_destroy(treeState->canvas);
+    free(treeState);
+}
+
+//------------------------------------------------------------------------------
+// Scénario : sprites dessinés par la file de rendu
+
+typedef struct SpritesState
+{
+    int spriteCount;
+} SpritesState;
+
+static void* Sprites_setup(BenchContext* context, int itemCount)
+{
+    SpritesState* state = (SpritesState*)calloc(1, sizeof(SpritesState));
+    AssertNew(state);
+    state->spriteCount = itemCount;
+    return state;
+}
+
+static void Sprites_frame(BenchContext* context, void* state, int frameIdx)
+{
+    SpritesState* spritesState = (SpritesState*)state;
+    SpriteGroup* spriteGroup = context->spriteGroup;
+
+    Game_setRenderDrawColor(g_colors.black, 255);
+    SDL_RenderClear(g_renderer);
+
+    RenderQueue_begin(g_renderQueue);
+    RenderQueue_setLayer(g_renderQueue, 0, true);
+    for (int i = 0; i < spritesState->spriteCount; i++)
+    {
+        SDL_FRect dstRect = { 0 };
+        dstRect.x = (float)((i * 37 + frameIdx) % BENCH_WIDTH);
+        dstRect.y = (float)((i * 101) % BENCH_HEIGHT);
+        dstRect.w = 32.f;
+        dstRect.h = 32.f;
+        SpriteGroup_render(
+            spriteGroup, i % spriteGroup->m_spriteCount,
+            &dstRect, Vec2_anchor_north_west, 1.f
+        );
+    }
+    RenderQueue_end(g_renderQueue);
+
+    SDL_RenderPresent(g_renderer);
+}
+
+static void Sprites_teardown(BenchContext* context, void* state)
+{
+    free(state);
+}
+
+//------------------------------------------------------------------------------
+// Scénarios : chargement des assets
+
+static void AssetLoad_frame(BenchContext* context, void* state, int frameIdx)
+{
+    AssetManager* assets = AssetManager_create(1, 1);
+    AssetManager_addSpriteSheet(assets, BENCH_SHEET_ID, "atlas/ui_base", "atlas/ui_base_desc");
+    AssetManager_addFont(assets, BENCH_FONT_ID, "font/noto_sans_regular", 16);
+    AssetManager_cacheSpriteSheet(assets, BENCH_SHEET_ID);
+    AssetManager_cacheFont(assets, BENCH_FONT_ID);
+    AssetManager_destroy(assets);
+}
+
+static void* AssetLoad_setup(BenchContext* context, int itemCount)
+{
+    return NULL;
+}
+
+static void AssetLoad_teardown(BenchContext* context, void* state)
+{
+}
+
+//------------------------------------------------------------------------------
+// Scénario : décodage des données obfusquées
+
+typedef struct DecodeState
+{
+    Uint8* buffer;
+    Uint64 size;
+    GameObfuscationHeader header;
+} DecodeState;
+
+static void* Decode_setup(BenchContext* context, int itemCount)
+{
+    DecodeState* state = (DecodeState*)calloc(1, sizeof(DecodeState));
+    AssertNew(state);
+
+    const Uint64 size = (Uint64)itemCount;
+    Uint8* source = (Uint8*)SDL_malloc((size_t)size);
+    AssertNew(source);
+    for (Uint64 i = 0; i < size; i++)
+    {
+        source[i] = (Uint8)((i * 2654435761u) >> 13);
+    }
+
+    state->size = size;
+    state->buffer = (Uint8*)SDL_malloc((size_t)Game_getObfuscatedSizeV2(size));
+    AssertNew(state->buffer);
+    Game_obfuscateMemV2(state->buffer, source, size, 0);
+    memcpy(&state->header, state->buffer, sizeof(state->header));
+    SDL_free(source);
+
+    return state;
+}
+
+static void Decode_frame(BenchContext* context, void* state, int frameIdx)
+{
+    DecodeState* decodeState = (DecodeState*)state;
+    const GameObfuscationHeader* header = &decodeState->header;
+    const Uint64 blockCount = (decodeState->size + header->blockSize - 1) / header->blockSize;
+
+    // Le décodage v2 est une involution : le buffer est réutilisé tel quel
+    Game_retriveBlocksV2(
+        decodeState->buffer + sizeof(*header), decodeState->size, header, 0, blockCount
+    );
+}
+
+static void Decode_teardown(BenchContext* context, void* state)
+{
+    DecodeState* decodeState = (DecodeState*)state;
+    SDL_free(decodeState->buffer);
+    free(decodeState);
+}
+
+//------------------------------------------------------------------------------
+// Exécution et sortie des résultats
+
+// Les scénarios sont exécutés dans l'ordre : le chargement à froid, premier
+// chargement du processus, précède le chargement des assets partagés
+static const BenchScenario s_scenarios[] = {
+    { "asset_load_cold", 1, 1, 0, false, AssetLoad_setup, AssetLoad_frame, AssetLoad_teardown },
+    { "asset_load_warm", 1, BENCH_ASSET_LOAD_COUNT, 1, false, AssetLoad_setup, AssetLoad_frame, AssetLoad_teardown },
+    { "labels", BENCH_LABEL_COUNT, 0, -1, true, Labels_setup, Labels_frame, Labels_teardown },
+    { "labels_forced_update", BENCH_LABEL_COUNT, 0, -1, true, Labels_setup, LabelsForced_frame, Labels_teardown },
+    { "buttons", BENCH_BUTTON_COUNT, 0, -1, true, Buttons_setup, Buttons_frame, Buttons_teardown },
+    { "deep_tree", BENCH_TREE_DEPTH, 0, -1, true, DeepTree_setup, DeepTree_frame, DeepTree_teardown },
+    { "sprites", BENCH_SPRITE_COUNT, 0, -1, true, Sprites_setup, Sprites_frame, Sprites_teardown },
+    { "obfuscation_decode", BENCH_DECODE_SIZE, 20, 2, false, Decode_setup, Decode_frame, Decode_teardown },
+};
+
+/// @brief Charge la police et les sprites partagés par les scénarios.
+static bool Bench_loadAssets(BenchContext* context)
+{
+    context->assets = AssetManager_create(1, 1);
+    AssetManager_addSpriteSheet(context->assets, BENCH_SHEET_ID, "atlas/ui_base", "atlas/ui_base_desc");
+    AssetManager_addFont(context->assets, BENCH_FONT_ID, "font/noto_sans_regular", 16);
+
+    context->font = AssetManager_getFont(context->assets, BENCH_FONT_ID);
+    SpriteSheet* spriteSheet = AssetManager_getSpriteSheet(context->assets, BENCH_SHEET_ID);
+    if (context->font == NULL || spriteSheet == NULL || spriteSheet->m_groupCount < 1) return false;
+
+    context->spriteGroup = SpriteSheet_getGroupByIndex(spriteSheet, 0);
+    return context->spriteGroup->m_spriteCount > 0;
+}
+
+static void Bench_run(BenchContext* context, const BenchScenario* scenario, BenchResult* result)
+{
+    const int frameCount = (scenario->frameCount > 0) ? scenario->frameCount : context->frameCount;
+    const int warmupCount = (scenario->warmupCount >= 0) ? scenario->warmupCount : BENCH_WARMUP_FRAMES;
+    Uint64* frameTicks = (Uint64*)calloc(frameCount, sizeof(Uint64));
+    AssertNew(frameTicks);
+
+    void* state = scenario->setup(context, scenario->itemCount);
+
+    Uint64 totalTicks = 0;
+    int sdlAllocCount = 0;
+    int uiHeapAllocCount = 0;
+    int layoutCount = 0;
+    for (int frame = -warmupCount; frame < frameCount; frame++)
+    {
+        UIObject_resetLayoutCount();
+        UIObject_resetAllocStats();
+        const int allocStart = SDL_GetAtomicInt(&s_allocCount);
+
+        const Uint64 start = SDL_GetPerformanceCounter();
+        scenario->frame(context, state, frame + warmupCount);
+        const Uint64 ticks = SDL_GetPerformanceCounter() - start;
+
+        if (frame < 0) continue;
+        frameTicks[frame] = ticks;
+        totalTicks += ticks;
+        sdlAllocCount += SDL_GetAtomicInt(&s_allocCount) - allocStart;
+        uiHeapAllocCount += UIObject_getAllocStats().heapAllocCount;
+        layoutCount += UIObject_getLayoutCount();
+    }
+
+    RenderQueue_getStats(g_renderQueue, NULL, &result->renderStats);
+    scenario->teardown(context, state);
+
+    SDL_qsort(frameTicks, frameCount, sizeof(Uint64), Bench_compareTicks);
+    result->name = scenario->name;
+    result->itemCount = scenario->itemCount;
+    result->frameCount = frameCount;
+    result->meanMs = Bench_ticksToMs(totalTicks) / frameCount;
+    result->p50Ms = Bench_ticksToMs(Bench_getPercentile(frameTicks, frameCount, 50));
+    result->p95Ms = Bench_ticksToMs(Bench_getPercentile(frameTicks, frameCount, 95));
+    result->p99Ms = Bench_ticksToMs(Bench_getPercentile(frameTicks, frameCount, 99));
+    result->maxMs = Bench_ticksToMs(frameTicks[frameCount - 1]);
+    result->sdlAllocsPerFrame = (double)sdlAllocCount / frameCount;
+    result->uiHeapAllocsPerFrame = (double)uiHeapAllocCount / frameCount;
+    result->layoutsPerFrame = (double)layoutCount / frameCount;
+
+    free(frameTicks);
+}
+
+static void Bench_printJSON(const BenchResult* results, int count)
+{
+    printf("{\n  \"benchmarks\": [\n");
+    for (int i = 0; i < count; i++)
+    {
+        const BenchResult* r = &results[i];
+        printf(
+            "    { \"name\": \"%s\", \"items\": %d, \"frames\": %d, "
+            "\"mean_ms\": %.4f, \"p50_ms\": %.4f, \"p95_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f, "
+            "\"sdl_allocs_per_frame\": %.2f, \"ui_heap_allocs_per_frame\": %.2f, \"layouts_per_frame\": %.2f, "
+            "\"commands\": %d, \"draw_calls\": %d, \"texture_binds\": %d, \"state_changes\": %d }%s\n",
+            r->name, r->itemCount, r->frameCount,
+            r->meanMs, r->p50Ms, r->p95Ms, r->p99Ms, r->maxMs,
+            r->sdlAllocsPerFrame, r->uiHeapAllocsPerFrame, r->layoutsPerFrame,
+            r->renderStats.commandCount, r->renderStats.drawCallCount,
+            r->renderStats.textureBindCount, r->renderStats.stateChangeCount,
+            (i + 1 < count) ? "," : ""
+        );
+    }
+    printf("  ]\n}\n");
+}
+
+static void Bench_printCSV(const BenchResult* results, int count)
+{
+    printf(
+        "name,items,frames,mean_ms,p50_ms,p95_ms,p99_ms,max_ms,"
+        "sdl_allocs_per_frame,ui_heap_allocs_per_frame,layouts_per_frame,"
+        "commands,draw_calls,texture_binds,state_changes\n"
+    );
+    for (int i = 0; i < count; i++)
+    {
+        const BenchResult* r = &results[i];
+        printf(
+            "%s,%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.2f,%.2f,%.2f,%d,%d,%d,%d\n",
+            r->name, r->itemCount, r->frameCount,
+            r->meanMs, r->p50Ms, r->p95Ms, r->p99Ms, r->maxMs,
+            r->sdlAllocsPerFrame, r->uiHeapAllocsPerFrame, r->layoutsPerFrame,
+            r->renderStats.commandCount, r->renderStats.drawCallCount,
+            r->renderStats.textureBindCount, r->renderStats.stateChangeCount
+        );
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Bench_installAllocHooks();
+
+    const char* assetsPath = "assets";
+    BenchFormat format = BENCH_FORMAT_JSON;
+    BenchContext context = { 0 };
+    context.frameCount = BENCH_DEFAULT_FRAME_COUNT;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--csv") == 0) format = BENCH_FORMAT_CSV;
+        else if (strcmp(argv[i], "--json") == 0) format = BENCH_FORMAT_JSON;
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) context.frameCount = SDL_max(atoi(argv[++i]), 1);
+        else assetsPath = argv[i];
+    }
+
+    // Rendu logiciel sans fenêtre visible
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+
+    const GameInitParams initParams = {
+        .sdlFlags = SDL_INIT_VIDEO,
+        .projectRootPath = "",
+        .assetsPath = assetsPath,
+    };
+    if (Game_init(&initParams) != SDL_APP_CONTINUE) return EXIT_FAILURE;
+    if (Game_createWindow(BENCH_WIDTH, BENCH_HEIGHT, "engine_bench", SDL_WINDOW_HIDDEN) != SDL_APP_CONTINUE) return EXIT_FAILURE;
+    if (Game_createRenderer(BENCH_WIDTH, BENCH_HEIGHT) != SDL_APP_CONTINUE) return EXIT_FAILURE;
+    SDL_SetRenderVSync(g_renderer, 0);
+    Game_updateSizes();
+
+    const int scenarioCount = sizeof(s_scenarios) / sizeof(s_scenarios[0]);
+    BenchResult results[sizeof(s_scenarios) / sizeof(s_scenarios[0])] = { 0 };
+
+    for (int i = 0; i < scenarioCount; i++)
+    {
+        if (s_scenarios[i].usesAssets && context.assets == NULL)
+        {
+            if (Bench_loadAssets(&context) == false) return EXIT_FAILURE;
+        }
+        Bench_run(&context, &s_scenarios[i], &results[i]);
+    }
+
+    if (format == BENCH_FORMAT_CSV) Bench_printCSV(results, scenarioCount);
+    else Bench_printJSON(results, scenarioCount);
+
+    AssetManager_destroy(context.assets);
+    Game_quit();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "game_engine.h"
+
+#define BENCH_BUFFER_SIZE (64 * 1024 * 1024)
+#define BENCH_REPEAT_COUNT 5
+
+typedef struct DecodeTask
+{
+    Uint8* payload;
+    Uint64 size;
+    const GameObfuscationHeader* header;
+    Uint64 firstBlock;
+    Uint64 blockCount;
+} DecodeTask;
+
+static void DecodeTask_run(void* userData)
+{
+    DecodeTask* task = (DecodeTask*)userData;
+    Game_retriveBlocksV2(task->payload, task->size, task->header, task->firstBlock, task->blockCount);
+}
+
+static double Bench_getMegaBytesPerSecond(Uint64 byteCount, Uint64 ticks)
+{
+    double seconds = (double)ticks / (double)SDL_GetPerformanceFrequency();
+    return (double)byteCount / (1024.0 * 1024.0) / seconds;
+}
+
+static void Bench_printResult(const char* name, Uint64 byteCount, Uint64 bestTicks)
+{
+    printf("%-24s %10.1f MB/s\n", name, Bench_getMegaBytesPerSecond(byteCount, bestTicks));
+}
+
+/// @brief Vérifie que le décodage v2 restitue les données d'origine.
+/// @param source les données d'origine.
+/// @param size la taille des données.
+/// @return true si les données décodées sont identiques.
+static bool Bench_checkRoundTrip(const Uint8* source, Uint64 size)
+{
+    const Uint64 obfuscatedSize = Game_getObfuscatedSizeV2(size);
+    Uint8* buffer = (Uint8*)SDL_malloc((size_t)obfuscatedSize);
+    AssertNew(buffer);
+    Game_obfuscateMemV2(buffer, source, size, size);
+
+    Uint64 offset = 0;
+    Uint64 decodedSize = 0;
+    Game_retriveAnyMem(buffer, obfuscatedSize, &offset, &decodedSize);
+    bool success = (decodedSize == size) && (memcmp(buffer + offset, source, (size_t)size) == 0);
+    SDL_free(buffer);
+
+    if (!success)
+    {
+        printf("Round trip failed for %llu bytes\n", (unsigned long long)size);
+    }
+    return success;
+}
+
+int main(int argc, char* argv[])
+{
+    const Uint64 size = BENCH_BUFFER_SIZE;
+    Uint8* source = (Uint8*)SDL_malloc(size);
+    Uint8* v1 = (Uint8*)SDL_malloc(size);
+    Uint8* v2 = (Uint8*)SDL_malloc((size_t)Game_getObfuscatedSizeV2(size));
+    AssertNew(source);
+    AssertNew(v1);
+    AssertNew(v2);
+
+    for (Uint64 i = 0; i < size; i++)
+    {
+        source[i] = (Uint8)((i * 2654435761u) >> 13);
+    }
+
+    // Tailles autour des limites de blocs et des 64 octets du flux de clé
+    const Uint64 blockSize = GAME_OBFUSCATION_BLOCK_SIZE;
+    const Uint64 checkSizes[] = {
+        0, 1, 63, 64, 65, blockSize - 1, blockSize, blockSize + 1,
+        3 * blockSize + 17, size - 1, size
+    };
+    bool success = true;
+    for (int i = 0; i < (int)(sizeof(checkSizes) / sizeof(checkSizes[0])); i++)
+    {
+        success = Bench_checkRoundTrip(source, checkSizes[i]) && success;
+    }
+    if (!success) return EXIT_FAILURE;
+
+    memcpy(v1, source, size);
+    Game_obfuscateMem(v1, size);
+    Game_obfuscateMemV2(v2, source, size, 0);
+
+    GameObfuscationHeader header = { 0 };
+    memcpy(&header, v2, sizeof(header));
+    Uint8* payload = v2 + sizeof(header);
+    const Uint64 blockCount = (size + header.blockSize - 1) / header.blockSize;
+
+    ThreadPool* threadPool = ThreadPool_create(0);
+    const int threadCount = ThreadPool_getThreadCount(threadPool);
+    DecodeTask* tasks = (DecodeTask*)calloc(threadCount, sizeof(DecodeTask));
+    AssertNew(tasks);
+
+    Uint64 bestV1 = UINT64_MAX;
+    Uint64 bestV2 = UINT64_MAX;
+    Uint64 bestV2Threaded = UINT64_MAX;
+
+    // Le décodage étant une involution pour v2 et bijectif pour v1, les
+    // passes successives s'appliquent au même buffer sans le recopier.
+    for (int r = 0; r < BENCH_REPEAT_COUNT; r++)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        Game_retriveMem(v1, size);
+        bestV1 = SDL_min(bestV1, SDL_GetPerformanceCounter() - start);
+
+        start = SDL_GetPerformanceCounter();
+        Game_retriveBlocksV2(payload, size, &header, 0, blockCount);
+        bestV2 = SDL_min(bestV2, SDL_GetPerformanceCounter() - start);
+
+        start = SDL_GetPerformanceCounter();
+        Uint64 blocksPerTask = (blockCount + threadCount - 1) / threadCount;
+        for (int i = 0; i < threadCount; i++)
+        {
+            tasks[i].payload = payload;
+            tasks[i].size = size;
+            tasks[i].header = &header;
+            tasks[i].firstBlock = i * blocksPerTask;
+            tasks[i].blockCount = blocksPerTask;
+            ThreadPool_submit(threadPool, DecodeTask_run, tasks + i);
+        }
+        ThreadPool_wait(threadPool);
+        bestV2Threaded = SDL_min(bestV2Threaded, SDL_GetPerformanceCounter() - start);
+    }
+
+    // Chaque passe comprend deux décodages v2 : les données sont de nouveau
+    // obfusquées, et un décodage par blocs sur plusieurs threads doit les restituer
+    Uint64 blocksPerTask = (blockCount + threadCount - 1) / threadCount;
+    for (int i = 0; i < threadCount; i++)
+    {
+        tasks[i].firstBlock = i * blocksPerTask;
+        tasks[i].blockCount = blocksPerTask;
+        ThreadPool_submit(threadPool, DecodeTask_run, tasks + i);
+    }
+    ThreadPool_wait(threadPool);
+    if (memcmp(payload, source, (size_t)size) != 0)
+    {
+        printf("Threaded decode does not match the source\n");
+        success = false;
+    }
+
+    printf("Decode %d MB, best of %d runs\n", (int)(size / (1024 * 1024)), BENCH_REPEAT_COUNT);
+    Bench_printResult("v1 (serial)", size, bestV1);
+    Bench_printResult("v2 (1 thread)", size, bestV2);
+    char name[64] = { 0 };
+    SDL_snprintf(name, sizeof(name), "v2 (%d threads)", threadCount);
+    Bench_printResult(name, size, bestV2Threaded);
+
+    ThreadPool_destroy(threadPool);
+    free(tasks);
+    SDL_free(source);
+    SDL_free(v1);
+    SDL_free(v2);
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -6,12 +6,39 @@
 
 #include "core/asset_manager.h"
 #include "game_engine_common.h"
+#include "core/profiler.h"
 
-static void AssetManager_loadSpriteSheet(AssetManager* self, SpriteSheetData* data);
+#define ASSET_FONT_DATA_PROPERTY "game_engine.asset_manager.font_data"
+
+/// @brief Numéro incrémenté lorsqu'une police change d'instance active ou
+/// qu'une instance est redimensionnée.
+static Uint32 s_fontGeneration = 1;
+
+/// @brief Tâche de chargement soumise aux threads du gestionnaire.
+typedef struct AssetLoadTask
+{
+    AssetManager* manager;
+    SpriteSheetData* spriteData;
+    FontData* fontData;
+} AssetLoadTask;
+
+static bool AssetManager_decodeSpriteSheet(AssetManager* self, SpriteSheetData* data);
+static bool AssetManager_finalizeSpriteSheet(AssetManager* self, SpriteSheetData* data);
 static void AssetManager_clearSpriteSheet(AssetManager* self, SpriteSheetData* data);
 
-static void AssetManager_loadFont(AssetManager* self, FontData* data);
+static bool AssetManager_decodeFont(AssetManager* self, FontData* data);
+static bool AssetManager_finalizeFont(AssetManager* self, FontData* data);
 static void AssetManager_clearFont(AssetManager* self, FontData* data);
+static void AssetManager_selectFontSize(AssetManager* self, FontData* data, int pixelSize);
+
+static void AssetManager_submitTask(AssetManager* self, SpriteSheetData* spriteData, FontData* fontData);
+static void AssetManager_loadTaskMain(void* userData);
+static AssetState AssetManager_waitState(AssetManager* self, SDL_AtomicInt* state);
+static bool AssetManager_tryReadFile(
+    AssetManager* self, const char* fileName, void** outBuffer, Uint64* outOffset, Uint64* outLength);
+static bool AssetManager_openFileData(
+    AssetManager* self, const char* fileName,
+    const void** outData, Uint64* outLength, void** outBuffer);
 
 static char* AssetManager_makeDatPath(const char* fileName);
 SDL_Texture* AssetManager_loadTexture(AssetManager* self, SDL_Renderer* renderer, const char* fileName);
@@ -34,6 +61,16 @@ AssetManager* AssetManager_create(int spriteCapacity, int fontCapacity)
     self->m_storage = SDL_OpenTitleStorage(g_paths.assets, 0);
     AssertNew(self->m_storage);
 
+    char packPath[256] = { 0 };
+    SDL_strlcat(packPath, g_paths.assets, sizeof(packPath));
+    SDL_strlcat(packPath, "/" ASSET_PACK_FILE_NAME, sizeof(packPath));
+    self->m_pack = AssetPack_open(packPath);
+
+    self->m_loadMutex = SDL_CreateMutex();
+    self->m_loadCond = SDL_CreateCondition();
+    AssertNew(self->m_loadMutex);
+    AssertNew(self->m_loadCond);
+
     return self;
 }
 
@@ -41,6 +78,10 @@ void AssetManager_destroy(AssetManager* self)
 {
     if (!self) return;
 
+    // Termine les chargements en cours avant de libérer les données
+    ThreadPool_destroy(self->m_threadPool);
+    self->m_threadPool = NULL;
+
     if (self->m_spriteData)
     {
         // Libère les spriteSheet
@@ -69,6 +110,10 @@ void AssetManager_destroy(AssetManager* self)
         assert(false);
     }
 
+    AssetPack_close(self->m_pack);
+    SDL_DestroyCondition(self->m_loadCond);
+    SDL_DestroyMutex(self->m_loadMutex);
+
     free(self);
 }
 
@@ -144,7 +189,32 @@ SpriteSheet* AssetManager_getSpriteSheet(AssetManager* self, int sheetID)
         return NULL;
     }
 
-    AssetManager_loadSpriteSheet(self, spriteData);
+    PROFILE_BEGIN("AssetManager_getSpriteSheet");
+    AssetState state = AssetManager_waitState(self, &spriteData->m_state);
+    if (state == ASSET_STATE_LOADED)
+    {
+        SDL_AddAtomicInt(&self->m_loadedCount, -1);
+        AssetManager_finalizeSpriteSheet(self, spriteData);
+    }
+    else if (state == ASSET_STATE_UNLOADED)
+    {
+        // Chargement synchrone sur le thread appelant
+        if (AssetManager_decodeSpriteSheet(self, spriteData))
+        {
+            AssetManager_finalizeSpriteSheet(self, spriteData);
+        }
+        else
+        {
+            SDL_SetAtomicInt(&spriteData->m_state, ASSET_STATE_FAILED);
+        }
+    }
+    PROFILE_END();
+
+    if (spriteData->m_spriteSheet == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load sprite sheet with ID %d", sheetID);
+        assert(false && "Unable to load the sprite sheet");
+    }
     return spriteData->m_spriteSheet;
 }
 
@@ -163,7 +233,32 @@ TTF_Font* AssetManager_getFont(AssetManager* self, int fontID)
         return NULL;
     }
 
-    AssetManager_loadFont(self, fontData);
+    PROFILE_BEGIN("AssetManager_getFont");
+    AssetState state = AssetManager_waitState(self, &fontData->m_state);
+    if (state == ASSET_STATE_LOADED)
+    {
+        SDL_AddAtomicInt(&self->m_loadedCount, -1);
+        AssetManager_finalizeFont(self, fontData);
+    }
+    else if (state == ASSET_STATE_UNLOADED)
+    {
+        // Chargement synchrone sur le thread appelant
+        if (AssetManager_decodeFont(self, fontData))
+        {
+            AssetManager_finalizeFont(self, fontData);
+        }
+        else
+        {
+            SDL_SetAtomicInt(&fontData->m_state, ASSET_STATE_FAILED);
+        }
+    }
+    PROFILE_END();
+
+    if (fontData->m_font == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load font with ID %d", fontID);
+        assert(false && "Unable to load the font");
+    }
     return fontData->m_font;
 }
 
@@ -179,16 +274,227 @@ void AssetManager_cacheFont(AssetManager* self, int fontID)
     assert(font);
 }
 
-static void AssetManager_loadSpriteSheet(AssetManager* self, SpriteSheetData* data)
+void AssetManager_requestSpriteSheet(AssetManager* self, int sheetID)
+{
+    assert(self && "The AssetManager must be created");
+    assert(0 <= sheetID && sheetID < self->m_spriteCapacity && "The sheetID is not valid");
+
+    SpriteSheetData* spriteData = &(self->m_spriteData[sheetID]);
+    if (spriteData->m_texFileName == NULL || spriteData->m_descFileName == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No sprite sheet with ID %d", sheetID);
+        assert(false && "No sprite sheet with this sheetID");
+        return;
+    }
+    if (SDL_GetAtomicInt(&spriteData->m_state) != ASSET_STATE_UNLOADED) return;
+
+    SDL_SetAtomicInt(&spriteData->m_state, ASSET_STATE_QUEUED);
+    AssetManager_submitTask(self, spriteData, NULL);
+}
+
+void AssetManager_requestFont(AssetManager* self, int fontID)
+{
+    assert(self && "The AssetManager must be created");
+    assert(0 <= fontID && fontID < self->m_fontCapacity && "The fontID is not valid");
+
+    FontData* fontData = &(self->m_fontData[fontID]);
+    if (fontData->m_fileName == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No font with ID %d", fontID);
+        assert(false && "No font with this fontID");
+        return;
+    }
+    if (SDL_GetAtomicInt(&fontData->m_state) != ASSET_STATE_UNLOADED) return;
+
+    SDL_SetAtomicInt(&fontData->m_state, ASSET_STATE_QUEUED);
+    AssetManager_submitTask(self, NULL, fontData);
+}
+
+AssetState AssetManager_getSpriteSheetState(AssetManager* self, int sheetID)
+{
+    assert(self && "The AssetManager must be created");
+    assert(0 <= sheetID && sheetID < self->m_spriteCapacity && "The sheetID is not valid");
+    return (AssetState)SDL_GetAtomicInt(&(self->m_spriteData[sheetID].m_state));
+}
+
+AssetState AssetManager_getFontState(AssetManager* self, int fontID)
+{
+    assert(self && "The AssetManager must be created");
+    assert(0 <= fontID && fontID < self->m_fontCapacity && "The fontID is not valid");
+    return (AssetState)SDL_GetAtomicInt(&(self->m_fontData[fontID].m_state));
+}
+
+void AssetManager_update(AssetManager* self)
+{
+    assert(self && "The AssetManager must be created");
+    if (SDL_GetAtomicInt(&self->m_loadedCount) <= 0) return;
+
+    PROFILE_BEGIN("AssetManager_update");
+    for (int i = 0; i < self->m_spriteCapacity; i++)
+    {
+        SpriteSheetData* spriteData = &(self->m_spriteData[i]);
+        if (SDL_GetAtomicInt(&spriteData->m_state) != ASSET_STATE_LOADED) continue;
+
+        SDL_AddAtomicInt(&self->m_loadedCount, -1);
+        AssetManager_finalizeSpriteSheet(self, spriteData);
+    }
+    for (int i = 0; i < self->m_fontCapacity; i++)
+    {
+        FontData* fontData = &(self->m_fontData[i]);
+        if (SDL_GetAtomicInt(&fontData->m_state) != ASSET_STATE_LOADED) continue;
+
+        SDL_AddAtomicInt(&self->m_loadedCount, -1);
+        AssetManager_finalizeFont(self, fontData);
+    }
+    PROFILE_END();
+}
+
+void AssetManager_waitAll(AssetManager* self)
+{
+    assert(self && "The AssetManager must be created");
+    if (self->m_threadPool)
+    {
+        ThreadPool_wait(self->m_threadPool);
+    }
+    AssetManager_update(self);
+}
+
+static void AssetManager_submitTask(AssetManager* self, SpriteSheetData* spriteData, FontData* fontData)
+{
+    if (self->m_threadPool == NULL)
+    {
+        int threadCount = SDL_GetNumLogicalCPUCores() - 1;
+        threadCount = SDL_clamp(threadCount, 1, ASSET_LOADER_MAX_THREADS);
+        self->m_threadPool = ThreadPool_create(threadCount);
+    }
+
+    AssetLoadTask* task = (AssetLoadTask*)calloc(1, sizeof(AssetLoadTask));
+    AssertNew(task);
+    task->manager = self;
+    task->spriteData = spriteData;
+    task->fontData = fontData;
+
+    ThreadPool_submit(self->m_threadPool, AssetManager_loadTaskMain, task);
+}
+
+static void AssetManager_loadTaskMain(void* userData)
+{
+    AssetLoadTask* task = (AssetLoadTask*)userData;
+    AssetManager* self = task->manager;
+    SDL_AtomicInt* state = NULL;
+    bool success = false;
+
+    if (task->spriteData)
+    {
+        state = &(task->spriteData->m_state);
+        SDL_SetAtomicInt(state, ASSET_STATE_LOADING);
+        PROFILE_BEGIN("AssetManager_decodeSpriteSheet");
+        success = AssetManager_decodeSpriteSheet(self, task->spriteData);
+        PROFILE_END();
+    }
+    else
+    {
+        state = &(task->fontData->m_state);
+        SDL_SetAtomicInt(state, ASSET_STATE_LOADING);
+        PROFILE_BEGIN("AssetManager_decodeFont");
+        success = AssetManager_decodeFont(self, task->fontData);
+        PROFILE_END();
+    }
+
+    // L'état est modifié sous le mutex pour ne pas perdre de réveil
+    SDL_LockMutex(self->m_loadMutex);
+    if (success)
+    {
+        SDL_AddAtomicInt(&self->m_loadedCount, 1);
+    }
+    SDL_SetAtomicInt(state, success ? ASSET_STATE_LOADED : ASSET_STATE_FAILED);
+    SDL_BroadcastCondition(self->m_loadCond);
+    SDL_UnlockMutex(self->m_loadMutex);
+
+    free(task);
+}
+
+static AssetState AssetManager_waitState(AssetManager* self, SDL_AtomicInt* state)
 {
-    SDL_Texture* texture = AssetManager_loadTexture(self, g_renderer, data->m_texFileName);
+    AssetState value = (AssetState)SDL_GetAtomicInt(state);
+    if (value != ASSET_STATE_QUEUED && value != ASSET_STATE_LOADING) return value;
+
+    SDL_LockMutex(self->m_loadMutex);
+    while (true)
+    {
+        value = (AssetState)SDL_GetAtomicInt(state);
+        if (value != ASSET_STATE_QUEUED && value != ASSET_STATE_LOADING) break;
+        SDL_WaitCondition(self->m_loadCond, self->m_loadMutex);
+    }
+    SDL_UnlockMutex(self->m_loadMutex);
+
+    return value;
+}
 
+static bool AssetManager_decodeSpriteSheet(AssetManager* self, SpriteSheetData* data)
+{
+    const void* texData = NULL;
+    Uint64 texFileSize = 0;
+    void* texBuffer = NULL;
+    if (!AssetManager_openFileData(self, data->m_texFileName, &texData, &texFileSize, &texBuffer))
+    {
+        return false;
+    }
+
+    SDL_IOStream* ioStream = SDL_IOFromConstMem(texData, (size_t)texFileSize);
+    SDL_Surface* surface = ioStream ? IMG_Load_IO(ioStream, true) : NULL;
+    SDL_free(texBuffer);
+    if (surface == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load image %s", data->m_texFileName);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", SDL_GetError());
+        return false;
+    }
+
+    const void* descData = NULL;
     Uint64 descFileSize = 0;
     void* descBuffer = NULL;
-    AssetManager_readFileToBuffer(self, data->m_descFileName, &descBuffer, &descFileSize);
+    if (!AssetManager_openFileData(self, data->m_descFileName, &descData, &descFileSize, &descBuffer))
+    {
+        SDL_DestroySurface(surface);
+        return false;
+    }
 
-    data->m_spriteSheet = SpriteSheet_create(texture, (char*)descBuffer, (int)descFileSize);
+    data->m_pendingSheet = SpriteSheet_createFromDesc((const char*)descData, descFileSize);
     SDL_free(descBuffer);
+    if (data->m_pendingSheet == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load sprite sheet %s", data->m_descFileName);
+        SDL_DestroySurface(surface);
+        return false;
+    }
+    data->m_pendingSurface = surface;
+
+    return true;
+}
+
+static bool AssetManager_finalizeSpriteSheet(AssetManager* self, SpriteSheetData* data)
+{
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(g_renderer, data->m_pendingSurface);
+    SDL_DestroySurface(data->m_pendingSurface);
+    data->m_pendingSurface = NULL;
+
+    if (texture == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to create texture %s", data->m_texFileName);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", SDL_GetError());
+        SpriteSheet_destroy(data->m_pendingSheet);
+        data->m_pendingSheet = NULL;
+        SDL_SetAtomicInt(&data->m_state, ASSET_STATE_FAILED);
+        return false;
+    }
+
+    SpriteSheet_setTexture(data->m_pendingSheet, texture);
+    data->m_spriteSheet = data->m_pendingSheet;
+    data->m_pendingSheet = NULL;
+    SDL_SetAtomicInt(&data->m_state, ASSET_STATE_READY);
+
+    return true;
 }
 
 static void AssetManager_clearSpriteSheet(AssetManager* self, SpriteSheetData* data)
@@ -197,74 +503,181 @@ static void AssetManager_clearSpriteSheet(AssetManager* self, SpriteSheetData* d
     {
         SpriteSheet_destroy(data->m_spriteSheet);
     }
+    if (data->m_pendingSheet)
+    {
+        SpriteSheet_destroy(data->m_pendingSheet);
+    }
+    if (data->m_pendingSurface)
+    {
+        SDL_DestroySurface(data->m_pendingSurface);
+    }
     free(data->m_texFileName);
     free(data->m_descFileName);
     memset(data, 0, sizeof(SpriteSheetData));
 }
 
-static void AssetManager_loadFont(AssetManager* self, FontData* data)
+static bool AssetManager_decodeFont(AssetManager* self, FontData* data)
 {
-    Uint64 fileSize = 0;
-    AssetManager_createIOStream(self, data->m_fileName, &data->m_ioStream, &data->m_buffer, &fileSize);
+    return AssetManager_openFileData(
+        self, data->m_fileName, &data->m_fileData, &data->m_fileSize, &data->m_buffer
+    );
+}
 
-    data->m_font = TTF_OpenFontIO(data->m_ioStream, false, data->m_size);
+static bool AssetManager_finalizeFont(AssetManager* self, FontData* data)
+{
+    data->m_ioStream = SDL_IOFromConstMem(data->m_fileData, (size_t)data->m_fileSize);
+    data->m_font = data->m_ioStream ? TTF_OpenFontIO(data->m_ioStream, false, data->m_size) : NULL;
     if (data->m_font == NULL)
     {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load font %s", data->m_fileName);
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", SDL_GetError());
-        assert(false);
-        abort();
+        AssetManager_destroyIOStream(self, data->m_ioStream, data->m_buffer);
+        data->m_ioStream = NULL;
+        data->m_buffer = NULL;
+        SDL_SetAtomicInt(&data->m_state, ASSET_STATE_FAILED);
+        return false;
     }
+
+    // La police ouverte depuis le flux sert de source aux autres tailles
+    FontSizeEntry* entry = &(data->m_sizeCache[0]);
+    entry->m_font = data->m_font;
+    entry->m_pixelSize = (int)roundf(data->m_size);
+    entry->m_lastUse = 0;
+    data->m_sizeCacheCount = 1;
+    data->m_sizeCacheClock = 0;
+    data->m_appliedScale = -1.f;
+
+    SDL_SetPointerProperty(TTF_GetFontProperties(data->m_font), ASSET_FONT_DATA_PROPERTY, data);
+    SDL_SetAtomicInt(&data->m_state, ASSET_STATE_READY);
+
+    return true;
 }
 
 static void AssetManager_clearFont(AssetManager* self, FontData* data)
 {
     if (data->m_font)
     {
-        TTF_CloseFont(data->m_font);
+        // Les copies doivent être fermées avant la police source
+        for (int i = data->m_sizeCacheCount - 1; i >= 0; i--)
+        {
+            TTF_CloseFont(data->m_sizeCache[i].m_font);
+        }
         AssetManager_destroyIOStream(self, data->m_ioStream, data->m_buffer);
     }
+    else if (data->m_buffer)
+    {
+        // Police décodée mais jamais finalisée
+        SDL_free(data->m_buffer);
+    }
     free(data->m_fileName);
     memset(data, 0, sizeof(FontData));
 }
 
 
-void AssetManager_readFileToBuffer(
-    AssetManager* self, const char* fileName, void** outBuffer, Uint64* outLength)
+/// @brief Lit et décode un fichier dans un buffer alloué avec SDL_malloc().
+/// Une entrée du pack est toujours copiée, la projection étant en lecture seule.
+/// Les données décodées commencent à la position outOffset du buffer
+/// (en-tête du format d'obfuscation v2).
+static bool AssetManager_tryReadFile(
+    AssetManager* self, const char* fileName, void** outBuffer, Uint64* outOffset, Uint64* outLength)
 {
-    assert(outBuffer && outLength && "The output buffer and length must be valid");
+    assert(outBuffer && outOffset && outLength && "The output buffer and length must be valid");
+
+    const AssetPackEntry* entry = self->m_pack ? AssetPack_findEntry(self->m_pack, fileName) : NULL;
+    if (entry)
+    {
+        void* copy = SDL_malloc((size_t)entry->size);
+        AssertNew(copy);
+        memcpy(copy, AssetPack_getEntryData(self->m_pack, entry), (size_t)entry->size);
+        *outOffset = 0;
+        *outLength = entry->size;
+        if (entry->flags & ASSET_PACK_FLAG_OBFUSCATED)
+        {
+            Game_retriveAnyMem(copy, entry->size, outOffset, outLength);
+        }
+        *outBuffer = copy;
+        return true;
+    }
+
     Uint64 fileSize = 0;
     bool success = SDL_GetStorageFileSize(self->m_storage, fileName, &fileSize);
     if (!success)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to get file size");
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to get file size %s", fileName);
         SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
-        assert(false);
-        abort();
+        return false;
     }
     void* mem = SDL_malloc((size_t)fileSize);
     AssertNew(mem);
     success = SDL_ReadStorageFile(self->m_storage, fileName, mem, fileSize);
     if (!success)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to read file");
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to read file %s", fileName);
         SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
+        SDL_free(mem);
+        return false;
+    }
+    Game_retriveAnyMem(mem, fileSize, outOffset, outLength);
+    *outBuffer = mem;
+    return true;
+}
+
+/// @brief Donne accès aux données d'un fichier.
+/// Seule une entrée du pack sans ASSET_PACK_FLAG_OBFUSCATED est lue sans copie :
+/// les données sont alors une vue dans la projection du pack et outBuffer vaut NULL.
+/// Les packs construits par Game_createAssetPackFromDev() sont entièrement
+/// obfusqués, leurs entrées sont donc copiées dans outBuffer puis décodées.
+/// outBuffer doit être libéré avec SDL_free().
+static bool AssetManager_openFileData(
+    AssetManager* self, const char* fileName,
+    const void** outData, Uint64* outLength, void** outBuffer)
+{
+    const AssetPackEntry* entry = self->m_pack ? AssetPack_findEntry(self->m_pack, fileName) : NULL;
+    if (entry && (entry->flags & ASSET_PACK_FLAG_OBFUSCATED) == 0)
+    {
+        *outData = AssetPack_getEntryData(self->m_pack, entry);
+        *outLength = entry->size;
+        *outBuffer = NULL;
+        return true;
+    }
+
+    Uint64 offset = 0;
+    if (!AssetManager_tryReadFile(self, fileName, outBuffer, &offset, outLength))
+    {
+        return false;
+    }
+    *outData = (Uint8*)(*outBuffer) + offset;
+    return true;
+}
+
+void AssetManager_readFileToBuffer(
+    AssetManager* self, const char* fileName, void** outBuffer, Uint64* outLength)
+{
+    Uint64 offset = 0;
+    bool success = AssetManager_tryReadFile(self, fileName, outBuffer, &offset, outLength);
+    if (!success)
+    {
         assert(false);
         abort();
     }
-    Game_retriveMem(mem, (size_t)fileSize);
-    *outBuffer = mem;
-    *outLength = fileSize;
+    if (offset > 0)
+    {
+        memmove(*outBuffer, (Uint8*)(*outBuffer) + offset, (size_t)(*outLength));
+    }
 }
 
 void AssetManager_createIOStream(
     AssetManager* self, const char* fileName,
     SDL_IOStream** outIOStream, void** outBuffer, Uint64* outLength)
 {
-    Uint64 fileSize = 0;
-    AssetManager_readFileToBuffer(self, fileName, outBuffer, outLength);
+    const void* data = NULL;
+    if (!AssetManager_openFileData(self, fileName, &data, outLength, outBuffer))
+    {
+        assert(false);
+        abort();
+    }
 
-    *outIOStream = SDL_IOFromConstMem(*outBuffer, (size_t)(*outLength));
+    *outIOStream = SDL_IOFromConstMem(data, (size_t)(*outLength));
     if (*outIOStream == NULL)
     {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to create IOStream %s", fileName);
@@ -304,19 +717,110 @@ SDL_Texture* AssetManager_loadTexture(AssetManager* self, SDL_Renderer* renderer
 void AssetManager_updateFontSizes(AssetManager* self)
 {
     assert(self && "The AssetManager must be created");
+    const float scale = g_sizes.mainRenderScale;
     for (int i = 0; i < self->m_fontCapacity; i++)
     {
         FontData* fontData = &(self->m_fontData[i]);
-        TTF_Font* font = fontData->m_font;
-        if (!font) continue;
+        if (!fontData->m_font) continue;
+        if (fontData->m_appliedScale == scale) continue;
+
+        fontData->m_appliedScale = scale;
+        AssetManager_selectFontSize(self, fontData, (int)roundf(fontData->m_size * scale));
+    }
+}
+
+static void AssetManager_selectFontSize(AssetManager* self, FontData* data, int pixelSize)
+{
+    FontSizeEntry* active = NULL;
+    FontSizeEntry* oldest = NULL;
+    data->m_sizeCacheClock++;
 
-        const float newSize = roundf(fontData->m_size * g_sizes.mainRenderScale);
-        bool success = TTF_SetFontSize(font, newSize);
-        if (!success)
+    for (int i = 0; i < data->m_sizeCacheCount; i++)
+    {
+        FontSizeEntry* entry = &(data->m_sizeCache[i]);
+        if (entry->m_font == data->m_font)
         {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to update font size %s", fontData->m_fileName);
+            active = entry;
+            if (entry->m_pixelSize == pixelSize)
+            {
+                entry->m_lastUse = data->m_sizeCacheClock;
+                return;
+            }
+            continue;
+        }
+        if (entry->m_pixelSize == pixelSize)
+        {
+            // Instance déjà rastérisée à cette taille
+            entry->m_lastUse = data->m_sizeCacheClock;
+            data->m_font = entry->m_font;
+            self->m_fontCacheStats.hitCount++;
+            s_fontGeneration++;
+            return;
+        }
+        if (oldest == NULL || entry->m_lastUse < oldest->m_lastUse)
+        {
+            oldest = entry;
+        }
+    }
+    assert(active && "The active font must be in the size cache");
+
+    FontSizeEntry* entry = NULL;
+    if (data->m_sizeCacheCount < ASSET_FONT_SIZE_CACHE_CAPACITY)
+    {
+        entry = &(data->m_sizeCache[data->m_sizeCacheCount]);
+        entry->m_font = TTF_CopyFont(data->m_sizeCache[0].m_font);
+        if (entry->m_font == NULL)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to copy font %s", data->m_fileName);
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", SDL_GetError());
             assert(false);
+            abort();
         }
+        SDL_SetPointerProperty(TTF_GetFontProperties(entry->m_font), ASSET_FONT_DATA_PROPERTY, data);
+        data->m_sizeCacheCount++;
+    }
+    else
+    {
+        // Le cache est plein : l'instance la moins récemment utilisée est
+        // redimensionnée. Les textes qui la référencent restent valides.
+        entry = oldest ? oldest : active;
+    }
+
+    self->m_fontCacheStats.missCount++;
+    bool success = TTF_SetFontSize(entry->m_font, (float)pixelSize);
+    if (!success)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to update font size %s", data->m_fileName);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", SDL_GetError());
+        assert(false);
+    }
+    entry->m_pixelSize = pixelSize;
+    entry->m_lastUse = data->m_sizeCacheClock;
+    data->m_font = entry->m_font;
+    s_fontGeneration++;
+}
+
+Uint32 AssetManager_getFontGeneration()
+{
+    return s_fontGeneration;
+}
+
+void AssetManager_syncTextFont(TTF_Text* text)
+{
+    assert(text && "The text must be valid");
+    TTF_Font* font = TTF_GetTextFont(text);
+    if (!font) return;
+
+    FontData* data = (FontData*)SDL_GetPointerProperty(
+        TTF_GetFontProperties(font), ASSET_FONT_DATA_PROPERTY, NULL
+    );
+    if (data == NULL || data->m_font == font) return;
+
+    bool success = TTF_SetTextFont(text, data->m_font);
+    if (!success)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to update text font %s", data->m_fileName);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", SDL_GetError());
+        assert(false);
     }
 }
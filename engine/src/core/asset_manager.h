@@ -7,17 +7,57 @@
 #pragma once
 
 #include "game_engine_settings.h"
+#include "core/asset_pack.h"
 #include "core/sprite_sheet.h"
+#include "core/thread_pool.h"
 
 typedef struct SpriteSheetData SpriteSheetData;
 typedef struct FontData FontData;
 
+/// @brief Nombre maximal de threads utilisés pour le chargement asynchrone.
+#define ASSET_LOADER_MAX_THREADS 4
+
+/// @brief Etat de chargement d'un asset.
+typedef enum AssetState
+{
+    /// @brief L'asset n'a pas encore été demandé.
+    ASSET_STATE_UNLOADED = 0,
+    /// @brief L'asset est dans la file des threads de chargement.
+    ASSET_STATE_QUEUED,
+    /// @brief L'asset est en cours de lecture et de décodage.
+    ASSET_STATE_LOADING,
+    /// @brief L'asset est décodé et attend sa finalisation sur le thread principal.
+    ASSET_STATE_LOADED,
+    /// @brief L'asset est utilisable.
+    ASSET_STATE_READY,
+    /// @brief Le chargement de l'asset a échoué.
+    ASSET_STATE_FAILED,
+} AssetState;
+
+/// @brief Nombre maximal d'instances d'une même police conservées en cache,
+/// une par taille en pixels.
+#define ASSET_FONT_SIZE_CACHE_CAPACITY 4
+
+/// @brief Statistiques du cache des tailles de polices.
+typedef struct AssetFontCacheStats
+{
+    /// @brief Nombre de changements de taille servis par une instance déjà chaude.
+    Uint64 hitCount;
+
+    /// @brief Nombre de changements de taille ayant nécessité une nouvelle rastérisation.
+    Uint64 missCount;
+} AssetFontCacheStats;
+
 /// @brief Structure contenant l'ensemble des assets du jeu.
 /// Cela correspond aux ressources utilisées (textures, fontes, musiques, son...)
 typedef struct AssetManager
 {
     SDL_Storage* m_storage;
 
+    /// @brief Pack d'assets projeté en mémoire, ou NULL si absent.
+    /// Les fichiers absents du pack sont lus depuis m_storage.
+    AssetPack* m_pack;
+
     int m_spriteCapacity;
     SpriteSheetData* m_spriteData;
 
@@ -25,6 +65,16 @@ typedef struct AssetManager
     FontData* m_fontData;
 
     int m_defaultViewportWidth;
+
+    AssetFontCacheStats m_fontCacheStats;
+
+    /// @brief Threads de chargement, créés à la première demande asynchrone.
+    ThreadPool* m_threadPool;
+    SDL_Mutex* m_loadMutex;
+    SDL_Condition* m_loadCond;
+
+    /// @brief Nombre d'assets décodés en attente de finalisation.
+    SDL_AtomicInt m_loadedCount;
 } AssetManager;
 
 /// @brief Crée le gestionnaire des assets du jeu.
@@ -64,6 +114,41 @@ SpriteSheet* AssetManager_getSpriteSheet(AssetManager* self, int sheetID);
 /// @return Le police associée à l'identifiant fontID.
 TTF_Font* AssetManager_getFont(AssetManager* self, int fontID);
 
+/// @brief Demande le chargement asynchrone d'une sprite sheet.
+/// La lecture du fichier, le décodage de l'image et du descripteur sont
+/// effectués par un thread de chargement. La texture est créée sur le thread
+/// principal par AssetManager_update().
+/// @param self le gestionnaire d'assets.
+/// @param sheetID l'identifiant de la sprite sheet.
+void AssetManager_requestSpriteSheet(AssetManager* self, int sheetID);
+
+/// @brief Demande le chargement asynchrone d'une police.
+/// @param self le gestionnaire d'assets.
+/// @param fontID l'identifiant de la police.
+void AssetManager_requestFont(AssetManager* self, int fontID);
+
+/// @brief Renvoie l'état de chargement d'une sprite sheet.
+/// @param self le gestionnaire d'assets.
+/// @param sheetID l'identifiant de la sprite sheet.
+/// @return L'état de chargement de la sprite sheet.
+AssetState AssetManager_getSpriteSheetState(AssetManager* self, int sheetID);
+
+/// @brief Renvoie l'état de chargement d'une police.
+/// @param self le gestionnaire d'assets.
+/// @param fontID l'identifiant de la police.
+/// @return L'état de chargement de la police.
+AssetState AssetManager_getFontState(AssetManager* self, int fontID);
+
+/// @brief Finalise les assets décodés par les threads de chargement.
+/// Cette fonction doit être appelée depuis le thread principal,
+/// typiquement à chaque tour de la boucle de rendu.
+/// @param self le gestionnaire d'assets.
+void AssetManager_update(AssetManager* self);
+
+/// @brief Attend la fin de tous les chargements demandés puis les finalise.
+/// @param self le gestionnaire d'assets.
+void AssetManager_waitAll(AssetManager* self);
+
 /// @brief Charge une sprite sheet répertoriée dans le gestionnaire d'assets.
 /// @param self le gestionnaire d'assets.
 /// @param sheetID l'identifiant de la sprite sheet.
@@ -85,9 +170,38 @@ INLINE int AssetManager_getDefaultViewportWidth(AssetManager* self)
     return self->m_defaultViewportWidth;
 }
 
+/// @brief Adapte la taille des polices chargées à l'échelle de rendu courante.
+/// Rien n'est fait tant que g_sizes.mainRenderScale ne change pas. Lors d'un
+/// changement, la police active bascule vers une instance déjà rastérisée à la
+/// bonne taille si elle est présente dans le cache.
+/// @param self le gestionnaire d'assets.
 void AssetManager_updateFontSizes(AssetManager* self);
 
+/// @brief Renvoie les statistiques du cache des tailles de polices.
+/// @param self le gestionnaire d'assets.
+/// @return Les statistiques du cache.
+INLINE AssetFontCacheStats AssetManager_getFontCacheStats(AssetManager* self)
+{
+    assert(self && "The AssetManager must be created");
+    return self->m_fontCacheStats;
+}
+
+/// @brief Associe un texte à l'instance active de sa police.
+/// Les instances d'une police changent lorsque l'échelle de rendu change.
+/// Il suffit d'appeler cette fonction lorsque AssetManager_getFontGeneration()
+/// a changé depuis le dernier appel pour ce texte.
+/// @param text le texte.
+void AssetManager_syncTextFont(TTF_Text* text);
+
+/// @brief Renvoie un numéro incrémenté à chaque changement d'instance active
+/// d'une police ou de taille d'une instance. Il n'est jamais remis à zéro et
+/// vaut au moins 1.
+Uint32 AssetManager_getFontGeneration();
 
+/// @brief Crée un flux de lecture sur un fichier des assets.
+/// Les données sont copiées et décodées dans outBuffer, y compris pour une
+/// entrée obfusquée du pack. Seule une entrée non obfusquée est lue directement
+/// dans la projection en mémoire, outBuffer valant alors NULL.
 void AssetManager_createIOStream(
     AssetManager* self, const char* fileName,
     SDL_IOStream** outIOStream, void** outBuffer, Uint64* outLength
@@ -103,13 +217,42 @@ struct SpriteSheetData
     SpriteSheet* m_spriteSheet;
     char* m_texFileName;
     char* m_descFileName;
+
+    SDL_AtomicInt m_state;
+
+    /// @brief Résultats du décodage en attente de finalisation.
+    SpriteSheet* m_pendingSheet;
+    SDL_Surface* m_pendingSurface;
 };
 
+typedef struct FontSizeEntry
+{
+    TTF_Font* m_font;
+    int m_pixelSize;
+    Uint64 m_lastUse;
+} FontSizeEntry;
+
 struct FontData
 {
+    /// @brief Instance active de la police (à la taille courante).
     TTF_Font* m_font;
     char* m_fileName;
+    /// @brief Données du fichier, vue dans le pack ou m_buffer.
+    const void* m_fileData;
+    Uint64 m_fileSize;
+    /// @brief Copie du fichier possédée par le gestionnaire, NULL pour une vue.
     void* m_buffer;
     SDL_IOStream* m_ioStream;
     float m_size;
+
+    SDL_AtomicInt m_state;
+
+    /// @brief Dernière échelle de rendu appliquée à la police.
+    float m_appliedScale;
+
+    /// @brief Instances de la police, une par taille en pixels.
+    /// La première entrée est la police ouverte depuis le flux.
+    FontSizeEntry m_sizeCache[ASSET_FONT_SIZE_CACHE_CAPACITY];
+    int m_sizeCacheCount;
+    Uint64 m_sizeCacheClock;
 };
@@ -0,0 +1,403 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/asset_pack.h"
+#include "game_engine_common.h"
+
+#ifdef _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+static bool AssetPack_map(AssetPack* self, const char* path);
+static void AssetPack_unmap(AssetPack* self);
+static bool AssetPack_validate(AssetPack* self);
+
+AssetPack* AssetPack_open(const char* path)
+{
+    assert(path && "The path must be valid");
+
+    SDL_PathInfo info = { 0 };
+    if (!SDL_GetPathInfo(path, &info) || info.type != SDL_PATHTYPE_FILE)
+    {
+        return NULL;
+    }
+
+    AssetPack* self = (AssetPack*)calloc(1, sizeof(AssetPack));
+    AssertNew(self);
+
+    if (AssetPack_map(self, path) == false)
+    {
+        // Repli : une seule lecture du fichier complet
+        size_t size = 0;
+        self->m_data = (const Uint8*)SDL_LoadFile(path, &size);
+        self->m_size = size;
+        if (self->m_data == NULL)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to load asset pack %s", path);
+            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
+            free(self);
+            return NULL;
+        }
+    }
+
+    if (AssetPack_validate(self) == false)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Invalid asset pack %s", path);
+        AssetPack_close(self);
+        return NULL;
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_SYSTEM, "Asset pack %s opened (%d entries, %s)",
+        path, self->m_entryCount, self->m_mapped ? "mapped" : "loaded"
+    );
+    return self;
+}
+
+void AssetPack_close(AssetPack* self)
+{
+    if (!self) return;
+
+    if (self->m_mapped)
+    {
+        AssetPack_unmap(self);
+    }
+    else
+    {
+        SDL_free((void*)self->m_data);
+    }
+    free(self);
+}
+
+/// @brief Compare un nom d'asset au nom normalisé enregistré dans le pack.
+static bool AssetPack_nameEquals(const char* name, const char* packName, Uint32 packNameLength)
+{
+    for (Uint32 i = 0; i < packNameLength; i++)
+    {
+        char c = (name[i] == '\\') ? '/' : name[i];
+        if (c != packName[i]) return false;
+    }
+    return name[packNameLength] == '\0';
+}
+
+Uint64 AssetPack_hashName(const char* name)
+{
+    assert(name && "The name must be valid");
+    Uint64 hash = 0xCBF29CE484222325ULL;
+    for (const char* c = name; *c != '\0'; c++)
+    {
+        Uint8 byte = (*c == '\\') ? (Uint8)'/' : (Uint8)*c;
+        hash ^= byte;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+const AssetPackEntry* AssetPack_findEntry(AssetPack* self, const char* name)
+{
+    assert(self && "The AssetPack must be created");
+    Uint64 hash = AssetPack_hashName(name);
+
+    // La table est triée par hash
+    int lower = 0;
+    int upper = self->m_entryCount - 1;
+    while (lower <= upper)
+    {
+        int mid = (lower + upper) / 2;
+        Uint64 midHash = self->m_entries[mid].nameHash;
+        if (midHash == hash)
+        {
+            // Les hash sont uniques dans le pack : un nom différent est une collision
+            const AssetPackEntry* entry = &(self->m_entries[mid]);
+            const char* packName = self->m_names + entry->nameOffset;
+            return AssetPack_nameEquals(name, packName, entry->nameLength) ? entry : NULL;
+        }
+        if (midHash < hash) lower = mid + 1;
+        else upper = mid - 1;
+    }
+    return NULL;
+}
+
+static bool AssetPack_validate(AssetPack* self)
+{
+    if (self->m_size < sizeof(AssetPackHeader)) return false;
+
+    const AssetPackHeader* header = (const AssetPackHeader*)self->m_data;
+    if (header->magic != ASSET_PACK_MAGIC) return false;
+    if (header->version != ASSET_PACK_VERSION) return false;
+    if (header->fileSize != self->m_size) return false;
+
+    Uint64 tocEnd = sizeof(AssetPackHeader) + (Uint64)header->entryCount * sizeof(AssetPackEntry);
+    if (tocEnd > self->m_size) return false;
+
+    Uint64 namesEnd = tocEnd + header->nameTableSize;
+    if (namesEnd > self->m_size) return false;
+
+    self->m_entries = (const AssetPackEntry*)(self->m_data + sizeof(AssetPackHeader));
+    self->m_entryCount = (int)header->entryCount;
+    self->m_names = (const char*)(self->m_data + tocEnd);
+    self->m_contentHash = header->contentHash;
+
+    for (int i = 0; i < self->m_entryCount; i++)
+    {
+        const AssetPackEntry* entry = &(self->m_entries[i]);
+        if ((Uint64)entry->nameOffset + entry->nameLength > header->nameTableSize) return false;
+        if (entry->offset < namesEnd) return false;
+        if (entry->offset > self->m_size) return false;
+        if (entry->size > self->m_size - entry->offset) return false;
+        if (i > 0 && self->m_entries[i - 1].nameHash >= entry->nameHash) return false;
+    }
+    return true;
+}
+
+#ifdef _WIN32
+
+static bool AssetPack_map(AssetPack* self, const char* path)
+{
+    HANDLE file = CreateFileA(
+        path, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL
+    );
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize = { 0 };
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    self->m_data = (const Uint8*)data;
+    self->m_size = (Uint64)fileSize.QuadPart;
+    self->m_fileHandle = file;
+    self->m_mappingHandle = mapping;
+    self->m_mapped = true;
+    return true;
+}
+
+static void AssetPack_unmap(AssetPack* self)
+{
+    UnmapViewOfFile(self->m_data);
+    CloseHandle((HANDLE)self->m_mappingHandle);
+    CloseHandle((HANDLE)self->m_fileHandle);
+}
+
+#else
+
+static bool AssetPack_map(AssetPack* self, const char* path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat fileStat = { 0 };
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    self->m_data = (const Uint8*)data;
+    self->m_size = (Uint64)fileStat.st_size;
+    self->m_mapped = true;
+    return true;
+}
+
+static void AssetPack_unmap(AssetPack* self)
+{
+    munmap((void*)self->m_data, (size_t)self->m_size);
+}
+
+#endif
+
+AssetPackWriter* AssetPackWriter_create()
+{
+    AssetPackWriter* self = (AssetPackWriter*)calloc(1, sizeof(AssetPackWriter));
+    AssertNew(self);
+
+    self->m_capacity = 16;
+    self->m_entries = (AssetPackEntry*)calloc(self->m_capacity, sizeof(AssetPackEntry));
+    self->m_buffers = (void**)calloc(self->m_capacity, sizeof(void*));
+    self->m_names = (char**)calloc(self->m_capacity, sizeof(char*));
+    AssertNew(self->m_entries);
+    AssertNew(self->m_buffers);
+    AssertNew(self->m_names);
+
+    return self;
+}
+
+void AssetPackWriter_destroy(AssetPackWriter* self)
+{
+    if (!self) return;
+
+    for (int i = 0; i < self->m_count; i++)
+    {
+        SDL_free(self->m_buffers[i]);
+        free(self->m_names[i]);
+    }
+    free(self->m_entries);
+    free(self->m_buffers);
+    free(self->m_names);
+    free(self);
+}
+
+bool AssetPackWriter_addFile(
+    AssetPackWriter* self, const char* name, void* buffer, Uint64 size, Uint32 flags)
+{
+    assert(self && "The AssetPackWriter must be created");
+    Uint64 hash = AssetPack_hashName(name);
+
+    // Insertion triée par hash
+    int index = self->m_count;
+    while (index > 0 && self->m_entries[index - 1].nameHash > hash)
+    {
+        index--;
+    }
+    if (index > 0 && self->m_entries[index - 1].nameHash == hash)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Duplicate asset name hash %s", name);
+        SDL_free(buffer);
+        return false;
+    }
+
+    if (self->m_count >= self->m_capacity)
+    {
+        int newCapacity = 2 * self->m_capacity;
+        AssetPackEntry* newEntries = (AssetPackEntry*)realloc(self->m_entries, newCapacity * sizeof(AssetPackEntry));
+        AssertNew(newEntries);
+        self->m_entries = newEntries;
+        void** newBuffers = (void**)realloc(self->m_buffers, newCapacity * sizeof(void*));
+        AssertNew(newBuffers);
+        self->m_buffers = newBuffers;
+        char** newNames = (char**)realloc(self->m_names, newCapacity * sizeof(char*));
+        AssertNew(newNames);
+        self->m_names = newNames;
+        self->m_capacity = newCapacity;
+    }
+
+    int moveCount = self->m_count - index;
+    memmove(self->m_entries + index + 1, self->m_entries + index, moveCount * sizeof(AssetPackEntry));
+    memmove(self->m_buffers + index + 1, self->m_buffers + index, moveCount * sizeof(void*));
+    memmove(self->m_names + index + 1, self->m_names + index, moveCount * sizeof(char*));
+
+    AssetPackEntry* entry = &(self->m_entries[index]);
+    memset(entry, 0, sizeof(AssetPackEntry));
+    entry->nameHash = hash;
+    entry->size = size;
+    entry->flags = flags;
+    self->m_buffers[index] = buffer;
+    self->m_count++;
+
+    // Le nom est enregistré avec des séparateurs '/', comme pour le hash
+    char* packName = Strdup(name);
+    for (char* c = packName; *c != '\0'; c++)
+    {
+        if (*c == '\\') *c = '/';
+    }
+    self->m_names[index] = packName;
+
+    return true;
+}
+
+bool AssetPackWriter_save(AssetPackWriter* self, const char* path)
+{
+    assert(self && "The AssetPackWriter must be created");
+
+    // Table des noms, chaque nom étant suivi d'un '\0'
+    Uint32 nameTableSize = 0;
+    for (int i = 0; i < self->m_count; i++)
+    {
+        Uint32 nameLength = (Uint32)strlen(self->m_names[i]);
+        self->m_entries[i].nameOffset = nameTableSize;
+        self->m_entries[i].nameLength = nameLength;
+        nameTableSize += nameLength + 1;
+    }
+    const Uint64 namesStart = sizeof(AssetPackHeader) + (Uint64)self->m_count * sizeof(AssetPackEntry);
+
+    // Calcule la position alignée des données de chaque entrée
+    Uint64 offset = namesStart + nameTableSize;
+    for (int i = 0; i < self->m_count; i++)
+    {
+        offset = (offset + ASSET_PACK_ALIGNMENT - 1) & ~(Uint64)(ASSET_PACK_ALIGNMENT - 1);
+        self->m_entries[i].offset = offset;
+        offset += self->m_entries[i].size;
+    }
+
+    char tmpPath[1024] = { 0 };
+    SDL_snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+    SDL_IOStream* output = SDL_IOFromFile(tmpPath, "wb");
+    if (output == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to create asset pack %s", tmpPath);
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
+        return false;
+    }
+
+    AssetPackHeader header = { 0 };
+    header.magic = ASSET_PACK_MAGIC;
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = (Uint32)self->m_count;
+    header.nameTableSize = nameTableSize;
+    header.fileSize = offset;
+    header.contentHash = self->m_contentHash;
+
+    bool success = true;
+    success &= SDL_WriteIO(output, &header, sizeof(header)) == sizeof(header);
+    success &= SDL_WriteIO(output, self->m_entries, self->m_count * sizeof(AssetPackEntry))
+        == self->m_count * sizeof(AssetPackEntry);
+    for (int i = 0; i < self->m_count && success; i++)
+    {
+        size_t nameSize = (size_t)self->m_entries[i].nameLength + 1;
+        success &= SDL_WriteIO(output, self->m_names[i], nameSize) == nameSize;
+    }
+
+    const Uint8 padding[ASSET_PACK_ALIGNMENT] = { 0 };
+    Uint64 position = namesStart + nameTableSize;
+    for (int i = 0; i < self->m_count && success; i++)
+    {
+        const AssetPackEntry* entry = &(self->m_entries[i]);
+        size_t padSize = (size_t)(entry->offset - position);
+        success &= SDL_WriteIO(output, padding, padSize) == padSize;
+        success &= SDL_WriteIO(output, self->m_buffers[i], (size_t)entry->size) == entry->size;
+        position = entry->offset + entry->size;
+    }
+
+    if (!SDL_CloseIO(output)) success = false;
+
+    // Le pack existant n'est remplacé qu'une fois le nouveau entièrement écrit
+    if (success) success = SDL_RenamePath(tmpPath, path);
+    if (!success)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to write asset pack %s", path);
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
+        SDL_RemovePath(tmpPath);
+    }
+    return success;
+}
@@ -0,0 +1,164 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+/// @brief Nom du fichier pack placé à la racine du dossier des assets.
+#define ASSET_PACK_FILE_NAME "assets.pak"
+
+#define ASSET_PACK_MAGIC 0x4B415047 // "GPAK"
+#define ASSET_PACK_VERSION 3
+
+/// @brief Alignement en octets des données de chaque entrée dans le pack.
+#define ASSET_PACK_ALIGNMENT 16
+
+typedef enum AssetPackFlags
+{
+    ASSET_PACK_FLAG_NONE = 0,
+    /// @brief Les données de l'entrée sont obfusquées comme les fichiers .dat.
+    /// Elles sont copiées puis décodées avec Game_retriveAnyMem().
+    ASSET_PACK_FLAG_OBFUSCATED = 1 << 0,
+} AssetPackFlags;
+
+/// @brief En-tête du pack, suivi de la table des entrées triée par hash puis
+/// de la table des noms. Les valeurs sont stockées en little-endian.
+typedef struct AssetPackHeader
+{
+    Uint32 magic;
+    Uint32 version;
+    Uint32 entryCount;
+    /// @brief Taille de la table des noms qui suit la table des entrées.
+    Uint32 nameTableSize;
+    /// @brief Taille totale du fichier, pour détecter un pack tronqué.
+    Uint64 fileSize;
+    /// @brief Hash des sources à partir desquelles le pack a été construit.
+    Uint64 contentHash;
+} AssetPackHeader;
+
+/// @brief Entrée de la table des matières du pack.
+typedef struct AssetPackEntry
+{
+    /// @brief Hash du chemin de l'asset relatif au dossier des assets.
+    Uint64 nameHash;
+    /// @brief Position des données depuis le début du fichier.
+    Uint64 offset;
+    Uint64 size;
+    Uint32 flags;
+    /// @brief Position du nom de l'asset dans la table des noms.
+    /// Le nom est vérifié lors de la recherche pour écarter les collisions de hash.
+    Uint32 nameOffset;
+    Uint32 nameLength;
+    Uint32 reserved;
+} AssetPackEntry;
+
+/// @brief Structure représentant un pack d'assets projeté en mémoire.
+typedef struct AssetPack
+{
+    const Uint8* m_data;
+    Uint64 m_size;
+
+    const AssetPackEntry* m_entries;
+    int m_entryCount;
+    const char* m_names;
+    Uint64 m_contentHash;
+
+    /// @brief Indique si le fichier est projeté en mémoire ou chargé en une
+    /// seule allocation lorsque la projection n'est pas disponible.
+    bool m_mapped;
+    void* m_fileHandle;
+    void* m_mappingHandle;
+} AssetPack;
+
+/// @brief Ouvre un pack d'assets en le projetant en mémoire.
+/// @param path le chemin du fichier.
+/// @return Le pack ouvert ou NULL si le fichier n'existe pas ou n'est pas valide.
+AssetPack* AssetPack_open(const char* path);
+
+/// @brief Ferme un pack d'assets.
+/// Les vues obtenues avec AssetPack_getEntryData() deviennent invalides.
+/// @param self le pack.
+void AssetPack_close(AssetPack* self);
+
+/// @brief Calcule le hash d'un nom d'asset (FNV-1a 64 bits).
+/// Les séparateurs '\' sont considérés comme des '/'.
+/// @param name le chemin de l'asset relatif au dossier des assets.
+/// @return Le hash du nom.
+Uint64 AssetPack_hashName(const char* name);
+
+/// @brief Recherche une entrée dans le pack.
+/// @param self le pack.
+/// @param name le chemin de l'asset relatif au dossier des assets.
+/// @return L'entrée ou NULL si l'asset n'est pas dans le pack.
+const AssetPackEntry* AssetPack_findEntry(AssetPack* self, const char* name);
+
+/// @brief Renvoie un pointeur vers les données d'une entrée, sans copie.
+/// @param self le pack.
+/// @param entry l'entrée.
+/// @return Les données de l'entrée, valides jusqu'à la fermeture du pack.
+INLINE const void* AssetPack_getEntryData(AssetPack* self, const AssetPackEntry* entry)
+{
+    assert(self && entry);
+    return self->m_data + entry->offset;
+}
+
+/// @brief Renvoie le hash des sources à partir desquelles le pack a été construit.
+/// @param self le pack.
+/// @return Le hash enregistré par AssetPackWriter_setContentHash().
+INLINE Uint64 AssetPack_getContentHash(AssetPack* self)
+{
+    assert(self && "The AssetPack must be created");
+    return self->m_contentHash;
+}
+
+/// @brief Structure permettant de construire un pack d'assets.
+typedef struct AssetPackWriter
+{
+    AssetPackEntry* m_entries;
+    void** m_buffers;
+    char** m_names;
+    int m_count;
+    int m_capacity;
+    Uint64 m_contentHash;
+} AssetPackWriter;
+
+/// @brief Crée un constructeur de pack vide.
+/// @return Le constructeur créé.
+AssetPackWriter* AssetPackWriter_create();
+
+/// @brief Détruit un constructeur de pack ainsi que les buffers ajoutés.
+/// @param self le constructeur.
+void AssetPackWriter_destroy(AssetPackWriter* self);
+
+/// @brief Ajoute un fichier au pack.
+/// @param self le constructeur.
+/// @param name le chemin de l'asset relatif au dossier des assets.
+/// @param buffer les données, allouées avec SDL_malloc(). Le constructeur en prend possession.
+/// @param size la taille des données.
+/// @param flags les options de l'entrée (AssetPackFlags).
+/// @return true si le fichier a été ajouté, false si le hash du nom est déjà
+/// présent. Le buffer est alors libéré.
+bool AssetPackWriter_addFile(
+    AssetPackWriter* self, const char* name, void* buffer, Uint64 size, Uint32 flags);
+
+/// @brief Définit le hash des sources enregistré dans l'en-tête du pack.
+/// Il permet de savoir si un pack existant est à jour.
+/// @param self le constructeur.
+/// @param contentHash le hash des sources.
+INLINE void AssetPackWriter_setContentHash(AssetPackWriter* self, Uint64 contentHash)
+{
+    assert(self && "The AssetPackWriter must be created");
+    self->m_contentHash = contentHash;
+}
+
+/// @brief Ecrit le pack sur le disque.
+/// Le pack est écrit dans un fichier temporaire qui remplace ensuite le
+/// fichier de destination : une écriture interrompue ne laisse pas de pack tronqué.
+/// @param self le constructeur.
+/// @param path le chemin du fichier.
+/// @return true en cas de succès, false sinon.
+bool AssetPackWriter_save(AssetPackWriter* self, const char* path);
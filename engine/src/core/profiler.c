@@ -0,0 +1,278 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/profiler.h"
+#include "game_engine_common.h"
+
+#if GAME_ENABLE_PROFILER
+
+#define PROFILER_MAX_THREADS 64
+
+/// @brief Evénements d'un thread.
+/// Seul le thread propriétaire écrit dans cette structure. Les zones ouvertes
+/// avant l'arrêt de la capture peuvent encore se terminer pendant l'export :
+/// generation, events et eventCount sont donc modifiés sous le verrou lock,
+/// que l'export prend pour copier le tampon.
+typedef struct ProfilerThread
+{
+    SDL_ThreadID threadID;
+    SDL_SpinLock lock;
+    /// @brief Capture à laquelle appartiennent les événements.
+    int generation;
+
+    /// @brief Tampon circulaire des zones terminées.
+    ProfilerEvent* events;
+    /// @brief Nombre total d'événements écrits depuis le début de la capture.
+    Uint64 eventCount;
+
+    /// @brief Zones ouvertes.
+    ProfilerEvent stack[PROFILER_MAX_DEPTH];
+    int depth;
+    /// @brief Nombre de zones ouvertes au-delà de PROFILER_MAX_DEPTH.
+    int overflowDepth;
+} ProfilerThread;
+
+static SDL_TLSID s_threadTLS = { 0 };
+static SDL_Mutex* s_mutex = NULL;
+static ProfilerThread* s_threads[PROFILER_MAX_THREADS] = { 0 };
+static int s_threadCount = 0;
+
+static SDL_AtomicInt s_isCapturing = { 0 };
+static SDL_AtomicInt s_generation = { 0 };
+static Uint64 s_captureStart = 0;
+
+void Profiler_init()
+{
+    assert(s_mutex == NULL && "The profiler is already initialized");
+    s_mutex = SDL_CreateMutex();
+    AssertNew(s_mutex);
+}
+
+void Profiler_quit()
+{
+    if (s_mutex == NULL) return;
+
+    SDL_SetAtomicInt(&s_isCapturing, 0);
+    SDL_SetTLS(&s_threadTLS, NULL, NULL);
+    for (int i = 0; i < s_threadCount; i++)
+    {
+        free(s_threads[i]->events);
+        free(s_threads[i]);
+        s_threads[i] = NULL;
+    }
+    s_threadCount = 0;
+
+    SDL_DestroyMutex(s_mutex);
+    s_mutex = NULL;
+}
+
+static ProfilerThread* Profiler_getThread()
+{
+    ProfilerThread* thread = (ProfilerThread*)SDL_GetTLS(&s_threadTLS);
+    if (thread) return thread;
+    if (s_mutex == NULL) return NULL;
+
+    SDL_LockMutex(s_mutex);
+    if (s_threadCount < PROFILER_MAX_THREADS)
+    {
+        thread = (ProfilerThread*)calloc(1, sizeof(ProfilerThread));
+        AssertNew(thread);
+        thread->events = (ProfilerEvent*)calloc(PROFILER_EVENT_CAPACITY, sizeof(ProfilerEvent));
+        AssertNew(thread->events);
+        thread->threadID = SDL_GetCurrentThreadID();
+        thread->generation = -1;
+        s_threads[s_threadCount++] = thread;
+    }
+    SDL_UnlockMutex(s_mutex);
+
+    if (thread == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Profiler_getThread");
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Too many profiled threads");
+        return NULL;
+    }
+    SDL_SetTLS(&s_threadTLS, thread, NULL);
+    return thread;
+}
+
+/// @brief Efface les événements du thread lorsqu'une nouvelle capture a démarré.
+static void Profiler_syncGeneration(ProfilerThread* thread)
+{
+    const int generation = SDL_GetAtomicInt(&s_generation);
+    if (thread->generation == generation) return;
+
+    SDL_LockSpinlock(&(thread->lock));
+    thread->generation = generation;
+    thread->eventCount = 0;
+    SDL_UnlockSpinlock(&(thread->lock));
+
+    thread->depth = 0;
+    thread->overflowDepth = 0;
+}
+
+void Profiler_begin(const char* name)
+{
+    ProfilerThread* thread = (ProfilerThread*)SDL_GetTLS(&s_threadTLS);
+
+    // Hors capture, seules les zones imbriquées dans une zone déjà ouverte
+    // sont suivies, pour que chaque PROFILE_END() ferme la bonne zone
+    if (SDL_GetAtomicInt(&s_isCapturing) == 0 && (thread == NULL || thread->depth == 0)) return;
+
+    if (thread == NULL) thread = Profiler_getThread();
+    if (thread == NULL) return;
+    Profiler_syncGeneration(thread);
+
+    if (thread->depth >= PROFILER_MAX_DEPTH)
+    {
+        thread->overflowDepth++;
+        return;
+    }
+
+    ProfilerEvent* event = &(thread->stack[thread->depth++]);
+    event->name = name;
+    event->start = SDL_GetPerformanceCounter();
+}
+
+void Profiler_end()
+{
+    const Uint64 end = SDL_GetPerformanceCounter();
+    ProfilerThread* thread = (ProfilerThread*)SDL_GetTLS(&s_threadTLS);
+    if (thread == NULL || thread->depth == 0) return;
+
+    // Zone ouverte avant le début de la capture courante
+    if (thread->generation != SDL_GetAtomicInt(&s_generation))
+    {
+        Profiler_syncGeneration(thread);
+        return;
+    }
+
+    if (thread->overflowDepth > 0)
+    {
+        thread->overflowDepth--;
+        return;
+    }
+
+    SDL_LockSpinlock(&(thread->lock));
+    ProfilerEvent* event = &(thread->events[thread->eventCount & (PROFILER_EVENT_CAPACITY - 1)]);
+    *event = thread->stack[--thread->depth];
+    event->end = end;
+    thread->eventCount++;
+    SDL_UnlockSpinlock(&(thread->lock));
+}
+
+void Profiler_start()
+{
+    s_captureStart = SDL_GetPerformanceCounter();
+    SDL_AddAtomicInt(&s_generation, 1);
+    SDL_SetAtomicInt(&s_isCapturing, 1);
+}
+
+void Profiler_stop()
+{
+    SDL_SetAtomicInt(&s_isCapturing, 0);
+}
+
+bool Profiler_isCapturing()
+{
+    return SDL_GetAtomicInt(&s_isCapturing) != 0;
+}
+
+static double Profiler_ticksToMicroseconds(Uint64 ticks, double frequency)
+{
+    return 1e6 * (double)ticks / frequency;
+}
+
+/// @brief Copie les événements de la capture courante d'un thread.
+/// Le tampon est copié sous le verrou du thread, qui peut continuer d'écrire.
+/// @param thread le thread.
+/// @param generation la capture courante.
+/// @param snapshot le tableau de PROFILER_EVENT_CAPACITY événements à remplir.
+/// @return Le nombre d'événements copiés, du plus ancien au plus récent.
+static int Profiler_snapshotThread(ProfilerThread* thread, int generation, ProfilerEvent* snapshot)
+{
+    int count = 0;
+    SDL_LockSpinlock(&(thread->lock));
+    if (thread->generation == generation)
+    {
+        const Uint64 eventCount = thread->eventCount;
+        count = (int)SDL_min(eventCount, (Uint64)PROFILER_EVENT_CAPACITY);
+        for (int k = 0; k < count; k++)
+        {
+            snapshot[k] = thread->events[(eventCount - count + k) & (PROFILER_EVENT_CAPACITY - 1)];
+        }
+    }
+    SDL_UnlockSpinlock(&(thread->lock));
+    return count;
+}
+
+bool Profiler_saveChromeTrace(const char* path)
+{
+    assert(Profiler_isCapturing() == false && "The capture must be stopped");
+    if (s_mutex == NULL) return false;
+
+    SDL_IOStream* output = SDL_IOFromFile(path, "wb");
+    if (output == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to create trace file %s", path);
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
+        return false;
+    }
+
+    const double frequency = (double)SDL_GetPerformanceFrequency();
+    const int generation = SDL_GetAtomicInt(&s_generation);
+    bool success = true;
+    bool isFirst = true;
+
+    ProfilerEvent* snapshot = (ProfilerEvent*)calloc(PROFILER_EVENT_CAPACITY, sizeof(ProfilerEvent));
+    AssertNew(snapshot);
+
+    success &= SDL_IOprintf(output, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n") > 0;
+
+    SDL_LockMutex(s_mutex);
+    for (int i = 0; i < s_threadCount && success; i++)
+    {
+        ProfilerThread* thread = s_threads[i];
+        const int count = Profiler_snapshotThread(thread, generation, snapshot);
+        for (int k = 0; k < count && success; k++)
+        {
+            const ProfilerEvent* event = &(snapshot[k]);
+            if (event->start < s_captureStart) continue;
+
+            success &= SDL_IOprintf(
+                output, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%" SDL_PRIu64 ",\"ts\":%.3f,\"dur\":%.3f}",
+                isFirst ? "" : ",\n", event->name, (Uint64)thread->threadID,
+                Profiler_ticksToMicroseconds(event->start - s_captureStart, frequency),
+                Profiler_ticksToMicroseconds(event->end - event->start, frequency)
+            ) > 0;
+            isFirst = false;
+        }
+    }
+    SDL_UnlockMutex(s_mutex);
+    free(snapshot);
+
+    success &= SDL_IOprintf(output, "\n]}\n") > 0;
+    if (!SDL_CloseIO(output)) success = false;
+
+    if (success == false)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to write trace file %s", path);
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
+    }
+    return success;
+}
+
+#else
+
+void Profiler_init() {}
+void Profiler_quit() {}
+void Profiler_start() {}
+void Profiler_stop() {}
+bool Profiler_isCapturing() { return false; }
+bool Profiler_saveChromeTrace(const char* path) { return false; }
+void Profiler_begin(const char* name) {}
+void Profiler_end() {}
+
+#endif
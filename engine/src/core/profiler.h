@@ -0,0 +1,85 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+/// @brief Active le profileur.
+/// Par défaut, le profileur est actif sauf dans les builds de release
+/// (NDEBUG défini). Il peut être forcé en définissant GAME_ENABLE_PROFILER à 0 ou 1.
+#ifndef GAME_ENABLE_PROFILER
+#  ifdef NDEBUG
+#    define GAME_ENABLE_PROFILER 0
+#  else
+#    define GAME_ENABLE_PROFILER 1
+#  endif
+#endif
+
+/// @brief Nombre d'événements conservés par thread.
+/// Les événements les plus anciens sont écrasés lorsque la capture est longue.
+#define PROFILER_EVENT_CAPACITY (1 << 16)
+
+/// @brief Profondeur maximale d'imbrication des zones mesurées.
+#define PROFILER_MAX_DEPTH 32
+
+/// @brief Zone mesurée par le profileur.
+typedef struct ProfilerEvent
+{
+    /// @brief Nom de la zone, qui doit rester valide jusqu'à l'export.
+    const char* name;
+    Uint64 start;
+    Uint64 end;
+} ProfilerEvent;
+
+#if GAME_ENABLE_PROFILER
+
+/// @brief Début d'une zone mesurée, terminée par PROFILE_END().
+/// Le nom doit être une chaîne littérale. Les zones d'un même thread doivent
+/// être correctement imbriquées.
+#  define PROFILE_BEGIN(name) Profiler_begin(name)
+/// @brief Fin de la dernière zone ouverte par PROFILE_BEGIN().
+#  define PROFILE_END() Profiler_end()
+
+#else
+
+#  define PROFILE_BEGIN(name) ((void)0)
+#  define PROFILE_END() ((void)0)
+
+#endif
+
+/// @brief Initialise le profileur. Appelée par Game_init().
+void Profiler_init();
+
+/// @brief Libère la mémoire du profileur. Appelée par Game_quit(),
+/// lorsque les autres threads utilisant le profileur sont terminés.
+void Profiler_quit();
+
+/// @brief Démarre une capture. Les événements de la capture précédente sont effacés.
+void Profiler_start();
+
+/// @brief Arrête la capture en cours.
+void Profiler_stop();
+
+/// @brief Indique si une capture est en cours.
+bool Profiler_isCapturing();
+
+/// @brief Ecrit les événements capturés au format trace_event de Chrome
+/// (chrome://tracing, Perfetto).
+/// La capture doit être arrêtée. Les autres threads peuvent encore terminer
+/// leurs zones ouvertes : le tampon de chaque thread est copié sous son verrou.
+/// @param path le chemin du fichier JSON.
+/// @return true si le fichier a été écrit.
+bool Profiler_saveChromeTrace(const char* path);
+
+/// @brief Début d'une zone mesurée sur le thread courant.
+/// Utiliser de préférence la macro PROFILE_BEGIN().
+/// @param name le nom de la zone.
+void Profiler_begin(const char* name);
+
+/// @brief Fin de la dernière zone ouverte sur le thread courant.
+/// Utiliser de préférence la macro PROFILE_END().
+void Profiler_end();
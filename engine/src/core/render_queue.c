@@ -0,0 +1,568 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/render_queue.h"
+#include "game_engine_common.h"
+
+// Clé de tri sur 64 bits :
+// | couche (12) | texture (20) | mode de fusion (8) | ordre d'enregistrement (24) |
+#define RENDER_KEY_LAYER_SHIFT 52
+#define RENDER_KEY_TEXTURE_SHIFT 32
+#define RENDER_KEY_BLEND_SHIFT 24
+#define RENDER_KEY_TEXTURE_MASK 0xFFFFFu
+#define RENDER_KEY_BLEND_MASK 0xFFu
+#define RENDER_KEY_SEQUENCE_MASK 0xFFFFFFu
+
+static RenderQueue* s_currentQueue = NULL;
+
+RenderQueue* RenderQueue_create(SDL_Renderer* renderer, SpriteBatch* batch)
+{
+    assert(renderer && batch);
+
+    RenderQueue* self = (RenderQueue*)calloc(1, sizeof(RenderQueue));
+    AssertNew(self);
+
+    self->m_renderer = renderer;
+    self->m_batch = batch;
+
+    self->m_commandCapacity = 1024;
+    self->m_commands = (RenderCommand*)calloc(self->m_commandCapacity, sizeof(RenderCommand));
+    AssertNew(self->m_commands);
+
+    self->m_vertexCapacity = 4 * 1024;
+    self->m_vertices = (SDL_Vertex*)calloc(self->m_vertexCapacity, sizeof(SDL_Vertex));
+    AssertNew(self->m_vertices);
+
+    self->m_indexCapacity = 6 * 1024;
+    self->m_indices = (int*)calloc(self->m_indexCapacity, sizeof(int));
+    AssertNew(self->m_indices);
+
+    self->m_textureCapacity = 32;
+    self->m_textures = (SDL_Texture**)calloc(self->m_textureCapacity, sizeof(SDL_Texture*));
+    AssertNew(self->m_textures);
+
+    return self;
+}
+
+void RenderQueue_destroy(RenderQueue* self)
+{
+    if (!self) return;
+    if (s_currentQueue == self)
+    {
+        s_currentQueue = NULL;
+    }
+    free(self->m_commands);
+    free(self->m_vertices);
+    free(self->m_indices);
+    free(self->m_textures);
+    free(self);
+}
+
+RenderQueue* RenderQueue_getCurrent()
+{
+    return s_currentQueue;
+}
+
+RenderQueue* RenderQueue_swapCurrent(RenderQueue* queue)
+{
+    RenderQueue* prevQueue = s_currentQueue;
+    s_currentQueue = queue;
+    return prevQueue;
+}
+
+void RenderQueue_setOffset(RenderQueue* self, float x, float y)
+{
+    assert(self && "The RenderQueue must be created");
+    self->m_offsetX = x;
+    self->m_offsetY = y;
+}
+
+void RenderQueue_begin(RenderQueue* self)
+{
+    assert(self && "The RenderQueue must be created");
+    assert(s_currentQueue == NULL && "A RenderQueue is already active");
+
+    self->m_commandCount = 0;
+    self->m_vertexCount = 0;
+    self->m_indexCount = 0;
+    self->m_textureCount = 0;
+    self->m_layer = 0;
+    self->m_layerSortable = false;
+    self->m_offsetX = 0.f;
+    self->m_offsetY = 0.f;
+
+    s_currentQueue = self;
+}
+
+void RenderQueue_setLayer(RenderQueue* self, int layer, bool sortable)
+{
+    assert(self && "The RenderQueue must be created");
+    assert(0 <= layer && layer < RENDER_QUEUE_MAX_LAYERS);
+    self->m_layer = layer;
+    self->m_layerSortable = sortable;
+}
+
+static Uint32 RenderQueue_getTextureKey(RenderQueue* self, SDL_Texture* texture)
+{
+    if (texture == NULL) return 0;
+
+    // Peu de textures différentes par frame : une recherche linéaire suffit
+    for (int i = self->m_textureCount - 1; i >= 0; i--)
+    {
+        if (self->m_textures[i] == texture) return (Uint32)(i + 1);
+    }
+
+    if (self->m_textureCount >= self->m_textureCapacity)
+    {
+        int newCapacity = 2 * self->m_textureCapacity;
+        SDL_Texture** newTextures = (SDL_Texture**)realloc(self->m_textures, newCapacity * sizeof(SDL_Texture*));
+        AssertNew(newTextures);
+        self->m_textures = newTextures;
+        self->m_textureCapacity = newCapacity;
+    }
+    self->m_textures[self->m_textureCount++] = texture;
+    return (Uint32)self->m_textureCount;
+}
+
+static RenderCommand* RenderQueue_pushCommand(
+    RenderQueue* self, RenderCommandType type,
+    SDL_Texture* texture, SDL_BlendMode blendMode)
+{
+    if (self->m_commandCount >= self->m_commandCapacity)
+    {
+        int newCapacity = 2 * self->m_commandCapacity;
+        RenderCommand* newCommands = (RenderCommand*)realloc(self->m_commands, newCapacity * sizeof(RenderCommand));
+        AssertNew(newCommands);
+        self->m_commands = newCommands;
+        self->m_commandCapacity = newCapacity;
+    }
+    assert(self->m_commandCount <= RENDER_KEY_SEQUENCE_MASK && "Too many render commands");
+
+    Uint64 sortKey = (Uint64)self->m_layer << RENDER_KEY_LAYER_SHIFT;
+    if (self->m_layerSortable)
+    {
+        // Les textes et les contours ne sont pas regroupés avec la géométrie
+        Uint32 textureKey = RENDER_KEY_TEXTURE_MASK;
+        Uint32 blendKey = RENDER_KEY_BLEND_MASK;
+        if (type == RENDER_COMMAND_GEOMETRY)
+        {
+            textureKey = RenderQueue_getTextureKey(self, texture) & RENDER_KEY_TEXTURE_MASK;
+            blendKey = (Uint32)blendMode & RENDER_KEY_BLEND_MASK;
+        }
+        sortKey |= (Uint64)textureKey << RENDER_KEY_TEXTURE_SHIFT;
+        sortKey |= (Uint64)blendKey << RENDER_KEY_BLEND_SHIFT;
+    }
+    sortKey |= (Uint64)self->m_commandCount & RENDER_KEY_SEQUENCE_MASK;
+
+    RenderCommand* command = &(self->m_commands[self->m_commandCount++]);
+    memset(command, 0, sizeof(RenderCommand));
+    command->sortKey = sortKey;
+    command->type = type;
+    command->texture = texture;
+    command->blendMode = blendMode;
+    return command;
+}
+
+/// @brief Réserve des sommets et des indices pour une commande de géométrie.
+/// @return Les sommets à remplir.
+static SDL_Vertex* RenderQueue_pushGeometry(
+    RenderQueue* self, SDL_Texture* texture,
+    int vertexCount, const int* indices, int indexCount)
+{
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    if (texture)
+    {
+        SDL_GetTextureBlendMode(texture, &blendMode);
+    }
+    else
+    {
+        SDL_GetRenderDrawBlendMode(self->m_renderer, &blendMode);
+    }
+
+    if (self->m_vertexCount + vertexCount > self->m_vertexCapacity)
+    {
+        int newCapacity = self->m_vertexCapacity;
+        while (self->m_vertexCount + vertexCount > newCapacity) newCapacity *= 2;
+        SDL_Vertex* newVertices = (SDL_Vertex*)realloc(self->m_vertices, newCapacity * sizeof(SDL_Vertex));
+        AssertNew(newVertices);
+        self->m_vertices = newVertices;
+        self->m_vertexCapacity = newCapacity;
+    }
+    if (self->m_indexCount + indexCount > self->m_indexCapacity)
+    {
+        int newCapacity = self->m_indexCapacity;
+        while (self->m_indexCount + indexCount > newCapacity) newCapacity *= 2;
+        int* newIndices = (int*)realloc(self->m_indices, newCapacity * sizeof(int));
+        AssertNew(newIndices);
+        self->m_indices = newIndices;
+        self->m_indexCapacity = newCapacity;
+    }
+
+    RenderCommand* command = RenderQueue_pushCommand(self, RENDER_COMMAND_GEOMETRY, texture, blendMode);
+    command->firstVertex = self->m_vertexCount;
+    command->vertexCount = vertexCount;
+    command->firstIndex = self->m_indexCount;
+    command->indexCount = indexCount;
+
+    memcpy(self->m_indices + self->m_indexCount, indices, indexCount * sizeof(int));
+    self->m_indexCount += indexCount;
+
+    SDL_Vertex* vertices = self->m_vertices + self->m_vertexCount;
+    self->m_vertexCount += vertexCount;
+    return vertices;
+}
+
+void RenderQueue_addQuad(
+    RenderQueue* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect, SDL_FColor color)
+{
+    assert(self && "The RenderQueue must be created");
+    float textureWidth = 1.f, textureHeight = 1.f;
+    if (texture) SDL_GetTextureSize(texture, &textureWidth, &textureHeight);
+
+    SDL_Vertex* vertices = RenderQueue_pushGeometry(
+        self, texture, SPRITE_BATCH_QUAD_VERTEX_COUNT,
+        SpriteBatch_getQuadIndices(), SPRITE_BATCH_QUAD_INDEX_COUNT
+    );
+    SpriteBatch_buildQuadVertices(vertices, textureWidth, textureHeight, srcRect, dstRect, color);
+}
+
+void RenderQueue_addQuadRotated(
+    RenderQueue* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    double angle, const SDL_FPoint* center, SDL_FlipMode flip, SDL_FColor color)
+{
+    assert(self && "The RenderQueue must be created");
+    float textureWidth = 1.f, textureHeight = 1.f;
+    if (texture) SDL_GetTextureSize(texture, &textureWidth, &textureHeight);
+
+    SDL_Vertex* vertices = RenderQueue_pushGeometry(
+        self, texture, SPRITE_BATCH_QUAD_VERTEX_COUNT,
+        SpriteBatch_getQuadIndices(), SPRITE_BATCH_QUAD_INDEX_COUNT
+    );
+    SpriteBatch_buildQuadRotatedVertices(
+        vertices, textureWidth, textureHeight,
+        srcRect, dstRect, angle, center, flip, color
+    );
+}
+
+void RenderQueue_add9Grid(
+    RenderQueue* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    float l, float r, float t, float b, float scale, SDL_FColor color)
+{
+    assert(self && "The RenderQueue must be created");
+    float textureWidth = 1.f, textureHeight = 1.f;
+    if (texture) SDL_GetTextureSize(texture, &textureWidth, &textureHeight);
+
+    SDL_Vertex* vertices = RenderQueue_pushGeometry(
+        self, texture, SPRITE_BATCH_9GRID_VERTEX_COUNT,
+        SpriteBatch_get9GridIndices(), SPRITE_BATCH_9GRID_INDEX_COUNT
+    );
+    SpriteBatch_build9GridVertices(
+        vertices, textureWidth, textureHeight,
+        srcRect, dstRect, l, r, t, b, scale, color
+    );
+}
+
+void RenderQueue_addGeometry(
+    RenderQueue* self, SDL_Texture* texture,
+    const SDL_Vertex* vertices, int vertexCount,
+    const int* indices, int indexCount)
+{
+    assert(self && "The RenderQueue must be created");
+    assert(vertices && indices);
+
+    SDL_Vertex* dst = RenderQueue_pushGeometry(self, texture, vertexCount, indices, indexCount);
+    memcpy(dst, vertices, vertexCount * sizeof(SDL_Vertex));
+}
+
+void RenderQueue_addFillRect(RenderQueue* self, const SDL_FRect* dstRect, SDL_FColor color)
+{
+    assert(self && "The RenderQueue must be created");
+
+    SDL_FRect rect = { 0 };
+    if (dstRect)
+    {
+        rect = *dstRect;
+    }
+    else
+    {
+        int w = 0, h = 0;
+        SDL_GetCurrentRenderOutputSize(self->m_renderer, &w, &h);
+        rect.w = (float)w;
+        rect.h = (float)h;
+    }
+    RenderQueue_addQuad(self, NULL, NULL, &rect, color);
+}
+
+void RenderQueue_addRect(RenderQueue* self, const SDL_FRect* rect, SDL_FColor color)
+{
+    assert(self && "The RenderQueue must be created");
+    assert(rect);
+
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(self->m_renderer, &blendMode);
+
+    RenderCommand* command = RenderQueue_pushCommand(self, RENDER_COMMAND_RECT, NULL, blendMode);
+    command->rect = *rect;
+    command->color = color;
+}
+
+void RenderQueue_addText(RenderQueue* self, TTF_Text* text, float x, float y)
+{
+    assert(self && "The RenderQueue must be created");
+    assert(text);
+
+    RenderCommand* command = RenderQueue_pushCommand(self, RENDER_COMMAND_TEXT, NULL, SDL_BLENDMODE_BLEND);
+    command->text = text;
+    command->rect.x = x;
+    command->rect.y = y;
+}
+
+static void RenderQueue_logError(const char* functionName)
+{
+    SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", functionName);
+    SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
+    assert(false);
+}
+
+void RenderQueue_drawTexture(
+    SDL_Texture* texture, const SDL_FRect* srcRect, const SDL_FRect* dstRect, SDL_FColor color)
+{
+    assert(dstRect);
+    if (s_currentQueue)
+    {
+        RenderQueue_addQuad(s_currentQueue, texture, srcRect, dstRect, color);
+        return;
+    }
+
+    float textureWidth = 1.f, textureHeight = 1.f;
+    if (texture) SDL_GetTextureSize(texture, &textureWidth, &textureHeight);
+
+    SDL_Vertex vertices[SPRITE_BATCH_QUAD_VERTEX_COUNT];
+    SpriteBatch_buildQuadVertices(vertices, textureWidth, textureHeight, srcRect, dstRect, color);
+    bool success = SDL_RenderGeometry(
+        g_renderer, texture,
+        vertices, SPRITE_BATCH_QUAD_VERTEX_COUNT,
+        SpriteBatch_getQuadIndices(), SPRITE_BATCH_QUAD_INDEX_COUNT
+    );
+    if (!success) RenderQueue_logError("RenderQueue_drawTexture");
+}
+
+void RenderQueue_drawGeometry(
+    SDL_Texture* texture,
+    const SDL_Vertex* vertices, int vertexCount,
+    const int* indices, int indexCount)
+{
+    if (s_currentQueue)
+    {
+        RenderQueue_addGeometry(s_currentQueue, texture, vertices, vertexCount, indices, indexCount);
+        return;
+    }
+
+    bool success = SDL_RenderGeometry(g_renderer, texture, vertices, vertexCount, indices, indexCount);
+    if (!success) RenderQueue_logError("RenderQueue_drawGeometry");
+}
+
+void RenderQueue_drawFillRect(const SDL_FRect* dstRect, SDL_Color color)
+{
+    if (s_currentQueue)
+    {
+        RenderQueue_addFillRect(s_currentQueue, dstRect, SpriteBatch_toFColor(color));
+        return;
+    }
+
+    bool success = SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, color.a);
+    success = success && SDL_RenderFillRect(g_renderer, dstRect);
+    if (!success) RenderQueue_logError("RenderQueue_drawFillRect");
+}
+
+void RenderQueue_drawRect(const SDL_FRect* rect, SDL_Color color)
+{
+    assert(rect);
+    if (s_currentQueue)
+    {
+        RenderQueue_addRect(s_currentQueue, rect, SpriteBatch_toFColor(color));
+        return;
+    }
+
+    bool success = SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, color.a);
+    success = success && SDL_RenderRect(g_renderer, rect);
+    if (!success) RenderQueue_logError("RenderQueue_drawRect");
+}
+
+void RenderQueue_drawText(TTF_Text* text, float x, float y)
+{
+    assert(text);
+    if (s_currentQueue)
+    {
+        RenderQueue_addText(s_currentQueue, text, x, y);
+        return;
+    }
+
+    bool success = TTF_DrawRendererText(text, x, y);
+    if (!success) RenderQueue_logError("RenderQueue_drawText");
+}
+
+static bool RenderQueue_colorEquals(SDL_FColor a, SDL_FColor b)
+{
+    return (a.r == b.r) && (a.g == b.g) && (a.b == b.b) && (a.a == b.a);
+}
+
+/// @brief Calcule le nombre d'appels de dessin et de changements d'état
+/// nécessaires pour soumettre les commandes dans leur ordre actuel.
+static void RenderQueue_computeStats(const RenderQueue* self, RenderQueueStats* stats)
+{
+    memset(stats, 0, sizeof(RenderQueueStats));
+    stats->commandCount = self->m_commandCount;
+
+    bool hasGeometryState = false;
+    bool hasPendingGeometry = false;
+    SDL_Texture* texture = NULL;
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    bool hasDrawColor = false;
+    SDL_FColor drawColor = { 0 };
+
+    for (int i = 0; i < self->m_commandCount; i++)
+    {
+        const RenderCommand* command = &(self->m_commands[i]);
+        if (command->type == RENDER_COMMAND_GEOMETRY)
+        {
+            if (!hasGeometryState || command->texture != texture || command->blendMode != blendMode)
+            {
+                if (hasPendingGeometry) stats->drawCallCount++;
+                if (!hasGeometryState || command->texture != texture) stats->textureBindCount++;
+                if (!hasGeometryState || command->blendMode != blendMode) stats->stateChangeCount++;
+                texture = command->texture;
+                blendMode = command->blendMode;
+                hasGeometryState = true;
+            }
+            hasPendingGeometry = true;
+            continue;
+        }
+
+        if (hasPendingGeometry)
+        {
+            stats->drawCallCount++;
+            hasPendingGeometry = false;
+        }
+        if (command->type == RENDER_COMMAND_RECT)
+        {
+            if (!hasDrawColor || !RenderQueue_colorEquals(drawColor, command->color))
+            {
+                stats->stateChangeCount++;
+                drawColor = command->color;
+                hasDrawColor = true;
+            }
+        }
+        stats->drawCallCount++;
+    }
+    if (hasPendingGeometry) stats->drawCallCount++;
+}
+
+static int RenderQueue_compareCommands(const void* a, const void* b)
+{
+    const Uint64 keyA = ((const RenderCommand*)a)->sortKey;
+    const Uint64 keyB = ((const RenderCommand*)b)->sortKey;
+    return (keyA < keyB) ? -1 : (keyA > keyB) ? 1 : 0;
+}
+
+void RenderQueue_end(RenderQueue* self)
+{
+    assert(self && "The RenderQueue must be created");
+    assert(s_currentQueue == self && "The RenderQueue is not active");
+    s_currentQueue = NULL;
+
+    RenderQueue_computeStats(self, &self->m_recordedStats);
+
+    // L'ordre d'enregistrement fait partie de la clé : le tri est stable
+    SDL_qsort(self->m_commands, self->m_commandCount, sizeof(RenderCommand), RenderQueue_compareCommands);
+
+    RenderQueue_computeStats(self, &self->m_submittedStats);
+
+    const float offsetX = self->m_offsetX;
+    const float offsetY = self->m_offsetY;
+    if ((offsetX != 0.f) || (offsetY != 0.f))
+    {
+        for (int i = 0; i < self->m_vertexCount; i++)
+        {
+            self->m_vertices[i].position.x += offsetX;
+            self->m_vertices[i].position.y += offsetY;
+        }
+    }
+
+    SDL_Renderer* renderer = self->m_renderer;
+    SpriteBatch* batch = self->m_batch;
+    SDL_BlendMode initialBlendMode = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(renderer, &initialBlendMode);
+    SDL_BlendMode drawBlendMode = initialBlendMode;
+    bool hasDrawColor = false;
+    SDL_FColor drawColor = { 0 };
+    bool success = true;
+
+    for (int i = 0; i < self->m_commandCount; i++)
+    {
+        const RenderCommand* command = &(self->m_commands[i]);
+        if ((command->texture == NULL) && (command->blendMode != drawBlendMode) &&
+            (command->type != RENDER_COMMAND_TEXT))
+        {
+            SDL_SetRenderDrawBlendMode(renderer, command->blendMode);
+            drawBlendMode = command->blendMode;
+        }
+
+        switch (command->type)
+        {
+        case RENDER_COMMAND_GEOMETRY:
+            SpriteBatch_addGeometry(
+                batch, command->texture,
+                self->m_vertices + command->firstVertex, command->vertexCount,
+                self->m_indices + command->firstIndex, command->indexCount
+            );
+            break;
+
+        case RENDER_COMMAND_RECT:
+        {
+            SpriteBatch_flush(batch);
+            if (!hasDrawColor || !RenderQueue_colorEquals(drawColor, command->color))
+            {
+                SDL_SetRenderDrawColorFloat(
+                    renderer, command->color.r, command->color.g, command->color.b, command->color.a
+                );
+                drawColor = command->color;
+                hasDrawColor = true;
+            }
+            SDL_FRect rect = command->rect;
+            rect.x += offsetX;
+            rect.y += offsetY;
+            success = SDL_RenderRect(renderer, &rect);
+            break;
+        }
+
+        case RENDER_COMMAND_TEXT:
+            SpriteBatch_flush(batch);
+            success = TTF_DrawRendererText(command->text, command->rect.x + offsetX, command->rect.y + offsetY);
+            break;
+
+        default:
+            assert(false);
+            break;
+        }
+        if (!success)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "RenderQueue_end");
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "%s", SDL_GetError());
+            assert(false);
+            success = true;
+        }
+    }
+    SpriteBatch_flush(batch);
+
+    if (drawBlendMode != initialBlendMode)
+    {
+        SDL_SetRenderDrawBlendMode(renderer, initialBlendMode);
+    }
+}
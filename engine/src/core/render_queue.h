@@ -0,0 +1,239 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+#include "core/sprite_batch.h"
+
+/// @brief Nombre maximal de couches de rendu.
+#define RENDER_QUEUE_MAX_LAYERS 4096
+
+typedef enum RenderCommandType
+{
+    /// @brief Triangles texturés ou non, regroupés par le SpriteBatch.
+    RENDER_COMMAND_GEOMETRY,
+    /// @brief Contour de rectangle.
+    RENDER_COMMAND_RECT,
+    /// @brief Texte SDL_ttf.
+    RENDER_COMMAND_TEXT,
+} RenderCommandType;
+
+/// @brief Commande de rendu enregistrée dans une RenderQueue.
+typedef struct RenderCommand
+{
+    /// @brief Clé de tri : couche, texture, mode de fusion puis ordre d'enregistrement.
+    Uint64 sortKey;
+    RenderCommandType type;
+
+    SDL_Texture* texture;
+    SDL_BlendMode blendMode;
+
+    int firstVertex;
+    int vertexCount;
+    int firstIndex;
+    int indexCount;
+
+    /// @brief Rectangle d'un contour, ou position d'un texte.
+    SDL_FRect rect;
+    SDL_FColor color;
+    TTF_Text* text;
+} RenderCommand;
+
+/// @brief Statistiques d'une suite de commandes de rendu.
+typedef struct RenderQueueStats
+{
+    /// @brief Nombre de commandes.
+    int commandCount;
+    /// @brief Nombre d'appels de dessin au moteur de rendu.
+    int drawCallCount;
+    /// @brief Nombre de changements de texture.
+    int textureBindCount;
+    /// @brief Nombre de changements d'état hors texture (mode de fusion, couleur de dessin).
+    int stateChangeCount;
+} RenderQueueStats;
+
+/// @brief File de commandes de rendu.
+/// Les commandes sont enregistrées pendant le parcours de la scène puis triées
+/// et soumises au moteur de rendu en une fois. Dans une couche triable, les
+/// commandes sont regroupées par texture et mode de fusion ; dans les autres
+/// couches, l'ordre d'enregistrement est conservé car la superposition des
+/// éléments semi-transparents en dépend.
+/// Les changements d'état redondants sont supprimés à la soumission et la
+/// couleur des sprites est portée par les sommets.
+typedef struct RenderQueue
+{
+    SDL_Renderer* m_renderer;
+    SpriteBatch* m_batch;
+
+    RenderCommand* m_commands;
+    int m_commandCount;
+    int m_commandCapacity;
+
+    SDL_Vertex* m_vertices;
+    int m_vertexCount;
+    int m_vertexCapacity;
+
+    int* m_indices;
+    int m_indexCount;
+    int m_indexCapacity;
+
+    /// @brief Textures rencontrées pendant la frame, pour la clé de tri.
+    SDL_Texture** m_textures;
+    int m_textureCount;
+    int m_textureCapacity;
+
+    int m_layer;
+    bool m_layerSortable;
+
+    /// @brief Translation appliquée à la soumission.
+    float m_offsetX;
+    float m_offsetY;
+
+    /// @brief Statistiques dans l'ordre d'enregistrement.
+    RenderQueueStats m_recordedStats;
+    /// @brief Statistiques après le tri et la suppression des états redondants.
+    RenderQueueStats m_submittedStats;
+} RenderQueue;
+
+/// @brief Crée une file de commandes de rendu.
+/// @param renderer le moteur de rendu.
+/// @param batch le batch utilisé pour soumettre la géométrie.
+/// @return La file créée.
+RenderQueue* RenderQueue_create(SDL_Renderer* renderer, SpriteBatch* batch);
+
+/// @brief Détruit une file de commandes de rendu.
+/// @param self la file.
+void RenderQueue_destroy(RenderQueue* self);
+
+/// @brief Vide la file et l'active : les fonctions de rendu du moteur y
+/// enregistrent leurs commandes jusqu'à l'appel de RenderQueue_end().
+/// @param self la file.
+void RenderQueue_begin(RenderQueue* self);
+
+/// @brief Trie et soumet les commandes enregistrées puis désactive la file.
+/// @param self la file.
+void RenderQueue_end(RenderQueue* self);
+
+/// @brief Renvoie la file active.
+/// @return La file active ou NULL si le rendu est immédiat.
+RenderQueue* RenderQueue_getCurrent();
+
+/// @brief Remplace la file active sans la soumettre.
+/// Cette fonction permet d'enregistrer une passe de rendu imbriquée, vers une
+/// texture cible par exemple, pendant l'enregistrement de la frame.
+/// @param queue la nouvelle file active, ou NULL.
+/// @return La file active précédente.
+RenderQueue* RenderQueue_swapCurrent(RenderQueue* queue);
+
+/// @brief Définit la translation appliquée aux commandes lors de leur soumission.
+/// Elle est remise à zéro par RenderQueue_begin().
+/// @param self la file.
+/// @param x la translation horizontale en pixels.
+/// @param y la translation verticale en pixels.
+void RenderQueue_setOffset(RenderQueue* self, float x, float y);
+
+/// @brief Définit la couche des commandes suivantes.
+/// Toutes les commandes d'une même couche doivent partager le même choix de tri.
+/// @param self la file.
+/// @param layer la couche, les couches basses sont dessinées en premier.
+/// @param sortable indique si les commandes de la couche peuvent être
+/// réordonnées, c'est-à-dire si elles ne se superposent pas.
+void RenderQueue_setLayer(RenderQueue* self, int layer, bool sortable);
+
+void RenderQueue_addQuad(
+    RenderQueue* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect, SDL_FColor color);
+
+void RenderQueue_addQuadRotated(
+    RenderQueue* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    double angle, const SDL_FPoint* center, SDL_FlipMode flip, SDL_FColor color);
+
+void RenderQueue_add9Grid(
+    RenderQueue* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    float l, float r, float t, float b, float scale, SDL_FColor color);
+
+/// @brief Enregistre des sommets et des indices quelconques.
+/// @param self la file.
+/// @param texture la texture, ou NULL.
+/// @param vertices les sommets, en coordonnées de texture normalisées.
+/// @param vertexCount le nombre de sommets.
+/// @param indices les indices relatifs au premier sommet.
+/// @param indexCount le nombre d'indices.
+void RenderQueue_addGeometry(
+    RenderQueue* self, SDL_Texture* texture,
+    const SDL_Vertex* vertices, int vertexCount,
+    const int* indices, int indexCount);
+
+/// @brief Enregistre un rectangle plein.
+/// Le mode de fusion est celui du moteur de rendu au moment de l'appel.
+/// @param self la file.
+/// @param dstRect le rectangle, ou NULL pour toute la cible de rendu.
+/// @param color la couleur du rectangle.
+void RenderQueue_addFillRect(RenderQueue* self, const SDL_FRect* dstRect, SDL_FColor color);
+
+/// @brief Enregistre le contour d'un rectangle.
+/// @param self la file.
+/// @param rect le rectangle.
+/// @param color la couleur du contour.
+void RenderQueue_addRect(RenderQueue* self, const SDL_FRect* rect, SDL_FColor color);
+
+/// @brief Enregistre le dessin d'un texte.
+/// Le texte est dessiné avec son contenu et sa couleur au moment de la soumission.
+/// @param self la file.
+/// @param text le texte.
+/// @param x l'abscisse du coin supérieur gauche.
+/// @param y l'ordonnée du coin supérieur gauche.
+void RenderQueue_addText(RenderQueue* self, TTF_Text* text, float x, float y);
+
+// Fonctions de dessin : la commande est enregistrée dans la file active
+// (RenderQueue_getCurrent()) ou, si le rendu est immédiat, exécutée directement
+// par g_renderer. Les erreurs du moteur de rendu sont journalisées.
+
+/// @brief Dessine une texture, la couleur étant portée par les sommets.
+/// @param texture la texture.
+/// @param srcRect le rectangle source, ou NULL pour toute la texture.
+/// @param dstRect le rectangle de destination.
+/// @param color la couleur des sommets.
+void RenderQueue_drawTexture(
+    SDL_Texture* texture, const SDL_FRect* srcRect, const SDL_FRect* dstRect, SDL_FColor color);
+
+/// @brief Dessine des sommets et des indices quelconques.
+/// Les paramètres suivent ceux de RenderQueue_addGeometry().
+void RenderQueue_drawGeometry(
+    SDL_Texture* texture,
+    const SDL_Vertex* vertices, int vertexCount,
+    const int* indices, int indexCount);
+
+/// @brief Dessine un rectangle plein avec le mode de fusion du moteur de rendu.
+/// @param dstRect le rectangle, ou NULL pour toute la cible de rendu.
+/// @param color la couleur du rectangle.
+void RenderQueue_drawFillRect(const SDL_FRect* dstRect, SDL_Color color);
+
+/// @brief Dessine le contour d'un rectangle.
+/// @param rect le rectangle.
+/// @param color la couleur du contour.
+void RenderQueue_drawRect(const SDL_FRect* rect, SDL_Color color);
+
+/// @brief Dessine un texte SDL_ttf.
+/// @param text le texte.
+/// @param x l'abscisse du coin supérieur gauche.
+/// @param y l'ordonnée du coin supérieur gauche.
+void RenderQueue_drawText(TTF_Text* text, float x, float y);
+
+/// @brief Renvoie les statistiques de la dernière frame soumise.
+/// @param self la file.
+/// @param recorded les statistiques dans l'ordre d'enregistrement, ou NULL.
+/// @param submitted les statistiques après tri, ou NULL.
+INLINE void RenderQueue_getStats(
+    RenderQueue* self, RenderQueueStats* recorded, RenderQueueStats* submitted)
+{
+    assert(self && "The RenderQueue must be created");
+    if (recorded) *recorded = self->m_recordedStats;
+    if (submitted) *submitted = self->m_submittedStats;
+}
@@ -0,0 +1,375 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/sprite_batch.h"
+#include "game_engine_common.h"
+
+static int SpriteBatch_prepare(
+    SpriteBatch* self, SDL_Texture* texture, int vertexCount, int indexCount);
+
+SpriteBatch* SpriteBatch_create(SDL_Renderer* renderer)
+{
+    assert(renderer && "The renderer must be valid");
+
+    SpriteBatch* self = (SpriteBatch*)calloc(1, sizeof(SpriteBatch));
+    AssertNew(self);
+
+    self->m_renderer = renderer;
+    self->m_vertexCapacity = 4 * 1024;
+    self->m_indexCapacity = 6 * 1024;
+    self->m_vertices = (SDL_Vertex*)calloc(self->m_vertexCapacity, sizeof(SDL_Vertex));
+    self->m_indices = (int*)calloc(self->m_indexCapacity, sizeof(int));
+    AssertNew(self->m_vertices);
+    AssertNew(self->m_indices);
+
+    return self;
+}
+
+void SpriteBatch_destroy(SpriteBatch* self)
+{
+    if (!self) return;
+    free(self->m_vertices);
+    free(self->m_indices);
+    free(self);
+}
+
+void SpriteBatch_flush(SpriteBatch* self)
+{
+    assert(self && "The SpriteBatch must be created");
+    if (self->m_indexCount == 0) return;
+
+    bool success = true;
+    if (self->m_texture)
+    {
+        success = SDL_RenderGeometry(
+            self->m_renderer, self->m_texture,
+            self->m_vertices, self->m_vertexCount,
+            self->m_indices, self->m_indexCount
+        );
+    }
+    else
+    {
+        // Sans texture, SDL utilise le mode de fusion du moteur de rendu
+        SDL_BlendMode prevBlendMode = SDL_BLENDMODE_NONE;
+        SDL_GetRenderDrawBlendMode(self->m_renderer, &prevBlendMode);
+        SDL_SetRenderDrawBlendMode(self->m_renderer, self->m_blendMode);
+        success = SDL_RenderGeometry(
+            self->m_renderer, NULL,
+            self->m_vertices, self->m_vertexCount,
+            self->m_indices, self->m_indexCount
+        );
+        SDL_SetRenderDrawBlendMode(self->m_renderer, prevBlendMode);
+    }
+    if (!success)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "SpriteBatch_flush");
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "%s", SDL_GetError());
+        assert(false);
+    }
+
+    self->m_stats.drawCallCount++;
+    self->m_vertexCount = 0;
+    self->m_indexCount = 0;
+}
+
+/// @brief Prépare l'ajout de sommets et d'indices.
+/// Le batch est vidé si la texture ou le mode de fusion change.
+/// @return L'indice du premier sommet à écrire.
+static int SpriteBatch_prepare(
+    SpriteBatch* self, SDL_Texture* texture, int vertexCount, int indexCount)
+{
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    if (texture)
+    {
+        SDL_GetTextureBlendMode(texture, &blendMode);
+    }
+    else
+    {
+        SDL_GetRenderDrawBlendMode(self->m_renderer, &blendMode);
+    }
+
+    if (texture != self->m_texture || blendMode != self->m_blendMode)
+    {
+        SpriteBatch_flush(self);
+        self->m_texture = texture;
+        self->m_blendMode = blendMode;
+        self->m_textureWidth = 1.f;
+        self->m_textureHeight = 1.f;
+        if (texture)
+        {
+            SDL_GetTextureSize(texture, &self->m_textureWidth, &self->m_textureHeight);
+        }
+    }
+
+    if (self->m_vertexCount + vertexCount > self->m_vertexCapacity)
+    {
+        int newCapacity = self->m_vertexCapacity;
+        while (self->m_vertexCount + vertexCount > newCapacity) newCapacity *= 2;
+        SDL_Vertex* newVertices = (SDL_Vertex*)realloc(self->m_vertices, newCapacity * sizeof(SDL_Vertex));
+        AssertNew(newVertices);
+        self->m_vertices = newVertices;
+        self->m_vertexCapacity = newCapacity;
+    }
+    if (self->m_indexCount + indexCount > self->m_indexCapacity)
+    {
+        int newCapacity = self->m_indexCapacity;
+        while (self->m_indexCount + indexCount > newCapacity) newCapacity *= 2;
+        int* newIndices = (int*)realloc(self->m_indices, newCapacity * sizeof(int));
+        AssertNew(newIndices);
+        self->m_indices = newIndices;
+        self->m_indexCapacity = newCapacity;
+    }
+
+    return self->m_vertexCount;
+}
+
+static void SpriteBatch_pushIndices(SpriteBatch* self, int base, const int* indices, int indexCount)
+{
+    int* dst = self->m_indices + self->m_indexCount;
+    for (int i = 0; i < indexCount; i++)
+    {
+        dst[i] = base + indices[i];
+    }
+    self->m_indexCount += indexCount;
+}
+
+static void SpriteBatch_getTexCoords(
+    float textureWidth, float textureHeight, const SDL_FRect* srcRect,
+    float* u0, float* v0, float* u1, float* v1)
+{
+    if (srcRect == NULL)
+    {
+        *u0 = 0.f;
+        *v0 = 0.f;
+        *u1 = 1.f;
+        *v1 = 1.f;
+        return;
+    }
+    *u0 = srcRect->x / textureWidth;
+    *v0 = srcRect->y / textureHeight;
+    *u1 = (srcRect->x + srcRect->w) / textureWidth;
+    *v1 = (srcRect->y + srcRect->h) / textureHeight;
+}
+
+static void SpriteBatch_setVertex(SDL_Vertex* vertex, float x, float y, float u, float v, SDL_FColor color)
+{
+    vertex->position.x = x;
+    vertex->position.y = y;
+    vertex->tex_coord.x = u;
+    vertex->tex_coord.y = v;
+    vertex->color = color;
+}
+
+static const int s_quadIndices[SPRITE_BATCH_QUAD_INDEX_COUNT] = { 0, 1, 2, 0, 2, 3 };
+
+const int* SpriteBatch_getQuadIndices()
+{
+    return s_quadIndices;
+}
+
+void SpriteBatch_buildQuadVertices(
+    SDL_Vertex* vertices, float textureWidth, float textureHeight,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect, SDL_FColor color)
+{
+    assert(vertices && dstRect);
+    float u0, v0, u1, v1;
+    SpriteBatch_getTexCoords(textureWidth, textureHeight, srcRect, &u0, &v0, &u1, &v1);
+
+    const float x0 = dstRect->x;
+    const float y0 = dstRect->y;
+    const float x1 = dstRect->x + dstRect->w;
+    const float y1 = dstRect->y + dstRect->h;
+
+    SpriteBatch_setVertex(vertices + 0, x0, y0, u0, v0, color);
+    SpriteBatch_setVertex(vertices + 1, x1, y0, u1, v0, color);
+    SpriteBatch_setVertex(vertices + 2, x1, y1, u1, v1, color);
+    SpriteBatch_setVertex(vertices + 3, x0, y1, u0, v1, color);
+}
+
+void SpriteBatch_buildQuadRotatedVertices(
+    SDL_Vertex* vertices, float textureWidth, float textureHeight,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    double angle, const SDL_FPoint* center, SDL_FlipMode flip, SDL_FColor color)
+{
+    assert(vertices && dstRect);
+    float u0, v0, u1, v1;
+    SpriteBatch_getTexCoords(textureWidth, textureHeight, srcRect, &u0, &v0, &u1, &v1);
+    if (flip & SDL_FLIP_HORIZONTAL)
+    {
+        float tmp = u0; u0 = u1; u1 = tmp;
+    }
+    if (flip & SDL_FLIP_VERTICAL)
+    {
+        float tmp = v0; v0 = v1; v1 = tmp;
+    }
+
+    const float cx = center ? center->x : 0.5f * dstRect->w;
+    const float cy = center ? center->y : 0.5f * dstRect->h;
+    const float pivotX = dstRect->x + cx;
+    const float pivotY = dstRect->y + cy;
+    const float radians = (float)(angle * DEG_TO_RAD);
+    const float c = cosf(radians);
+    const float s = sinf(radians);
+
+    const float corners[4][2] = {
+        { -cx, -cy }, { dstRect->w - cx, -cy },
+        { dstRect->w - cx, dstRect->h - cy }, { -cx, dstRect->h - cy }
+    };
+    const float texCoords[4][2] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+
+    for (int i = 0; i < 4; i++)
+    {
+        float x = pivotX + c * corners[i][0] - s * corners[i][1];
+        float y = pivotY + s * corners[i][0] + c * corners[i][1];
+        SpriteBatch_setVertex(vertices + i, x, y, texCoords[i][0], texCoords[i][1], color);
+    }
+}
+
+void SpriteBatch_addQuad(
+    SpriteBatch* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect, SDL_FColor color)
+{
+    assert(self && "The SpriteBatch must be created");
+    assert(dstRect && "The dstRect must be valid");
+
+    int base = SpriteBatch_prepare(self, texture, 4, 6);
+    SpriteBatch_buildQuadVertices(
+        self->m_vertices + base, self->m_textureWidth, self->m_textureHeight,
+        srcRect, dstRect, color
+    );
+    self->m_vertexCount += 4;
+    SpriteBatch_pushIndices(self, base, s_quadIndices, SPRITE_BATCH_QUAD_INDEX_COUNT);
+    self->m_stats.quadCount++;
+}
+
+void SpriteBatch_addQuadRotated(
+    SpriteBatch* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    double angle, const SDL_FPoint* center, SDL_FlipMode flip, SDL_FColor color)
+{
+    assert(self && "The SpriteBatch must be created");
+    assert(dstRect && "The dstRect must be valid");
+
+    int base = SpriteBatch_prepare(self, texture, 4, 6);
+    SpriteBatch_buildQuadRotatedVertices(
+        self->m_vertices + base, self->m_textureWidth, self->m_textureHeight,
+        srcRect, dstRect, angle, center, flip, color
+    );
+    self->m_vertexCount += 4;
+    SpriteBatch_pushIndices(self, base, s_quadIndices, SPRITE_BATCH_QUAD_INDEX_COUNT);
+    self->m_stats.quadCount++;
+}
+
+static const int s_9GridIndices[SPRITE_BATCH_9GRID_INDEX_COUNT] = {
+     0,  1,  5,  0,  5,  4,
+     1,  2,  6,  1,  6,  5,
+     2,  3,  7,  2,  7,  6,
+     4,  5,  9,  4,  9,  8,
+     5,  6, 10,  5, 10,  9,
+     6,  7, 11,  6, 11, 10,
+     8,  9, 13,  8, 13, 12,
+     9, 10, 14,  9, 14, 13,
+    10, 11, 15, 10, 15, 14,
+};
+
+const int* SpriteBatch_get9GridIndices()
+{
+    return s_9GridIndices;
+}
+
+void SpriteBatch_build9GridVertices(
+    SDL_Vertex* vertices, float textureWidth, float textureHeight,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    float l, float r, float t, float b, float scale, SDL_FColor color)
+{
+    assert(vertices && srcRect && dstRect);
+    if (scale <= 0.f) scale = 1.f;
+
+    // Grille de 4 x 4 sommets partagés par les neuf parties
+    const float xs[4] = {
+        dstRect->x, dstRect->x + l * scale,
+        dstRect->x + dstRect->w - r * scale, dstRect->x + dstRect->w
+    };
+    const float ys[4] = {
+        dstRect->y, dstRect->y + t * scale,
+        dstRect->y + dstRect->h - b * scale, dstRect->y + dstRect->h
+    };
+    const float us[4] = {
+        srcRect->x / textureWidth,
+        (srcRect->x + l) / textureWidth,
+        (srcRect->x + srcRect->w - r) / textureWidth,
+        (srcRect->x + srcRect->w) / textureWidth
+    };
+    const float vs[4] = {
+        srcRect->y / textureHeight,
+        (srcRect->y + t) / textureHeight,
+        (srcRect->y + srcRect->h - b) / textureHeight,
+        (srcRect->y + srcRect->h) / textureHeight
+    };
+
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            SpriteBatch_setVertex(vertices + 4 * i + j, xs[j], ys[i], us[j], vs[i], color);
+        }
+    }
+}
+
+void SpriteBatch_add9Grid(
+    SpriteBatch* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    float l, float r, float t, float b, float scale, SDL_FColor color)
+{
+    assert(self && "The SpriteBatch must be created");
+    assert(srcRect && dstRect && "The rectangles must be valid");
+
+    int base = SpriteBatch_prepare(
+        self, texture, SPRITE_BATCH_9GRID_VERTEX_COUNT, SPRITE_BATCH_9GRID_INDEX_COUNT);
+
+    SpriteBatch_build9GridVertices(
+        self->m_vertices + base, self->m_textureWidth, self->m_textureHeight,
+        srcRect, dstRect, l, r, t, b, scale, color
+    );
+    self->m_vertexCount += SPRITE_BATCH_9GRID_VERTEX_COUNT;
+
+    SpriteBatch_pushIndices(self, base, s_9GridIndices, SPRITE_BATCH_9GRID_INDEX_COUNT);
+    self->m_stats.quadCount += 9;
+}
+
+void SpriteBatch_addFillRect(SpriteBatch* self, const SDL_FRect* dstRect, SDL_FColor color)
+{
+    assert(self && "The SpriteBatch must be created");
+
+    SDL_FRect rect = { 0 };
+    if (dstRect)
+    {
+        rect = *dstRect;
+    }
+    else
+    {
+        int w = 0, h = 0;
+        SDL_GetCurrentRenderOutputSize(self->m_renderer, &w, &h);
+        rect.w = (float)w;
+        rect.h = (float)h;
+    }
+    SpriteBatch_addQuad(self, NULL, NULL, &rect, color);
+}
+
+void SpriteBatch_addGeometry(
+    SpriteBatch* self, SDL_Texture* texture,
+    const SDL_Vertex* vertices, int vertexCount,
+    const int* indices, int indexCount)
+{
+    assert(self && "The SpriteBatch must be created");
+    assert(vertices && indices);
+
+    int base = SpriteBatch_prepare(self, texture, vertexCount, indexCount);
+    memcpy(self->m_vertices + base, vertices, vertexCount * sizeof(SDL_Vertex));
+    self->m_vertexCount += vertexCount;
+    SpriteBatch_pushIndices(self, base, indices, indexCount);
+    self->m_stats.quadCount += indexCount / 6;
+}
@@ -0,0 +1,193 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+/// @brief Nombre de sommets et d'indices d'un quad.
+#define SPRITE_BATCH_QUAD_VERTEX_COUNT 4
+#define SPRITE_BATCH_QUAD_INDEX_COUNT 6
+
+/// @brief Nombre de sommets et d'indices d'un sprite 9-slice.
+#define SPRITE_BATCH_9GRID_VERTEX_COUNT 16
+#define SPRITE_BATCH_9GRID_INDEX_COUNT 54
+
+/// @brief Statistiques de rendu d'un batch.
+typedef struct SpriteBatchStats
+{
+    /// @brief Nombre d'appels à SDL_RenderGeometry().
+    int drawCallCount;
+    /// @brief Nombre de quads soumis.
+    int quadCount;
+} SpriteBatchStats;
+
+/// @brief Structure accumulant des quads texturés dans un buffer de sommets
+/// pour les dessiner avec un seul appel à SDL_RenderGeometry() par suite de
+/// quads partageant la même texture et le même mode de fusion.
+/// Le batch est alimenté par la file de commandes de rendu (RenderQueue).
+/// La couleur est portée par les sommets : les modulations de couleur et
+/// d'opacité des textures ne sont pas utilisées.
+typedef struct SpriteBatch
+{
+    SDL_Renderer* m_renderer;
+
+    SDL_Vertex* m_vertices;
+    int m_vertexCount;
+    int m_vertexCapacity;
+
+    int* m_indices;
+    int m_indexCount;
+    int m_indexCapacity;
+
+    /// @brief Texture et mode de fusion de la suite de quads en cours.
+    SDL_Texture* m_texture;
+    SDL_BlendMode m_blendMode;
+    float m_textureWidth;
+    float m_textureHeight;
+
+    SpriteBatchStats m_stats;
+} SpriteBatch;
+
+/// @brief Crée un batch de sprites.
+/// @param renderer le moteur de rendu.
+/// @return Le batch créé.
+SpriteBatch* SpriteBatch_create(SDL_Renderer* renderer);
+
+/// @brief Détruit un batch de sprites.
+/// @param self le batch.
+void SpriteBatch_destroy(SpriteBatch* self);
+
+/// @brief Dessine les quads en attente.
+/// @param self le batch.
+void SpriteBatch_flush(SpriteBatch* self);
+
+/// @brief Ajoute un quad texturé.
+/// @param self le batch.
+/// @param texture la texture.
+/// @param srcRect le rectangle source dans la texture, ou NULL pour toute la texture.
+/// @param dstRect le rectangle de destination.
+/// @param color la couleur des sommets.
+void SpriteBatch_addQuad(
+    SpriteBatch* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect, SDL_FColor color);
+
+/// @brief Ajoute un quad texturé tourné.
+/// @param self le batch.
+/// @param texture la texture.
+/// @param srcRect le rectangle source dans la texture, ou NULL pour toute la texture.
+/// @param dstRect le rectangle de destination avant rotation.
+/// @param angle l'angle de rotation en degrés, dans le sens horaire.
+/// @param center le centre de rotation relatif à dstRect, ou NULL pour son centre.
+/// @param flip le retournement du quad.
+/// @param color la couleur des sommets.
+void SpriteBatch_addQuadRotated(
+    SpriteBatch* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    double angle, const SDL_FPoint* center, SDL_FlipMode flip, SDL_FColor color);
+
+/// @brief Ajoute un sprite découpé en neuf parties (9-slice).
+/// Les paramètres suivent la convention de SDL_RenderTexture9Grid().
+/// @param self le batch.
+/// @param texture la texture.
+/// @param srcRect le rectangle source dans la texture.
+/// @param dstRect le rectangle de destination.
+/// @param l la largeur du bord gauche dans la texture.
+/// @param r la largeur du bord droit dans la texture.
+/// @param t la hauteur du bord haut dans la texture.
+/// @param b la hauteur du bord bas dans la texture.
+/// @param scale l'échelle des coins, ou 0 pour une copie sans mise à l'échelle.
+/// @param color la couleur des sommets.
+void SpriteBatch_add9Grid(
+    SpriteBatch* self, SDL_Texture* texture,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    float l, float r, float t, float b, float scale, SDL_FColor color);
+
+/// @brief Calcule les sommets d'un quad texturé.
+/// Les sommets sont décrits par SpriteBatch_getQuadIndices().
+/// @param vertices le tableau de SPRITE_BATCH_QUAD_VERTEX_COUNT sommets à remplir.
+/// @param textureWidth la largeur de la texture en pixels.
+/// @param textureHeight la hauteur de la texture en pixels.
+/// @param srcRect le rectangle source dans la texture, ou NULL pour toute la texture.
+/// @param dstRect le rectangle de destination.
+/// @param color la couleur des sommets.
+void SpriteBatch_buildQuadVertices(
+    SDL_Vertex* vertices, float textureWidth, float textureHeight,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect, SDL_FColor color);
+
+/// @brief Calcule les sommets d'un quad texturé tourné.
+/// Les paramètres suivent ceux de SpriteBatch_addQuadRotated().
+void SpriteBatch_buildQuadRotatedVertices(
+    SDL_Vertex* vertices, float textureWidth, float textureHeight,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    double angle, const SDL_FPoint* center, SDL_FlipMode flip, SDL_FColor color);
+
+/// @brief Renvoie les SPRITE_BATCH_QUAD_INDEX_COUNT indices des triangles d'un quad.
+const int* SpriteBatch_getQuadIndices();
+
+/// @brief Calcule les sommets d'un sprite 9-slice.
+/// Les sommets forment une grille de 4 x 4 décrite par SpriteBatch_get9GridIndices().
+/// @param vertices le tableau de SPRITE_BATCH_9GRID_VERTEX_COUNT sommets à remplir.
+/// @param textureWidth la largeur de la texture en pixels.
+/// @param textureHeight la hauteur de la texture en pixels.
+/// @param srcRect le rectangle source dans la texture.
+/// @param dstRect le rectangle de destination.
+/// @param l la largeur du bord gauche dans la texture.
+/// @param r la largeur du bord droit dans la texture.
+/// @param t la hauteur du bord haut dans la texture.
+/// @param b la hauteur du bord bas dans la texture.
+/// @param scale l'échelle des coins, ou 0 pour une copie sans mise à l'échelle.
+/// @param color la couleur des sommets.
+void SpriteBatch_build9GridVertices(
+    SDL_Vertex* vertices, float textureWidth, float textureHeight,
+    const SDL_FRect* srcRect, const SDL_FRect* dstRect,
+    float l, float r, float t, float b, float scale, SDL_FColor color);
+
+/// @brief Renvoie les SPRITE_BATCH_9GRID_INDEX_COUNT indices des triangles
+/// d'un sprite 9-slice.
+const int* SpriteBatch_get9GridIndices();
+
+/// @brief Ajoute un rectangle plein non texturé.
+/// Le mode de fusion utilisé est celui du moteur de rendu.
+/// @param self le batch.
+/// @param dstRect le rectangle, ou NULL pour toute la cible de rendu.
+/// @param color la couleur du rectangle.
+void SpriteBatch_addFillRect(SpriteBatch* self, const SDL_FRect* dstRect, SDL_FColor color);
+
+/// @brief Ajoute des sommets et des indices quelconques.
+/// @param self le batch.
+/// @param texture la texture, ou NULL.
+/// @param vertices les sommets, en coordonnées de texture normalisées.
+/// @param vertexCount le nombre de sommets.
+/// @param indices les indices relatifs au premier sommet.
+/// @param indexCount le nombre d'indices.
+void SpriteBatch_addGeometry(
+    SpriteBatch* self, SDL_Texture* texture,
+    const SDL_Vertex* vertices, int vertexCount,
+    const int* indices, int indexCount);
+
+/// @brief Renvoie les statistiques du batch depuis le dernier appel à
+/// SpriteBatch_resetStats().
+INLINE SpriteBatchStats SpriteBatch_getStats(SpriteBatch* self)
+{
+    assert(self && "The SpriteBatch must be created");
+    return self->m_stats;
+}
+
+INLINE void SpriteBatch_resetStats(SpriteBatch* self)
+{
+    assert(self && "The SpriteBatch must be created");
+    self->m_stats.drawCallCount = 0;
+    self->m_stats.quadCount = 0;
+}
+
+INLINE SDL_FColor SpriteBatch_toFColor(SDL_Color color)
+{
+    SDL_FColor fColor = {
+        color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f
+    };
+    return fColor;
+}
@@ -6,6 +6,7 @@
 
 #include "core/sprite_sheet.h"
 #include "core/renderer.h"
+#include "core/render_queue.h"
 #include "game_engine_settings.h"
 #include "game_engine_common.h"
 #include "cJSON.h"
@@ -15,6 +16,44 @@ static void SpriteSheet_parseRect(SpriteSheet* self, cJSON* jRect, int i);
 static void SpriteSheet_parseGeometry(SpriteSheet* self, cJSON* jGeo);
 static void SpriteSheet_parseBorder(SpriteSheet* self, cJSON* jBorder);
 static void SpriteSheet_parseGroup(SpriteSheet* self, cJSON* jGroup, int i);
+static SpriteSheet* SpriteSheet_createFromBinary(const Uint8* desc, Uint64 descLength);
+static int SpriteSheet_getGroupTableCapacity(int groupCount);
+static void SpriteSheet_buildGroupIndex(SpriteSheet* self, int* table, int capacity);
+
+#define SPRITE_SHEET_BINARY_FLAG_PIXEL_ART (1 << 0)
+#define SPRITE_SHEET_BINARY_NO_NAME 0xFFFFFFFF
+#define SPRITE_SHEET_BLOCK_ALIGN(x) (((x) + 15) & ~(size_t)15)
+
+/// @brief En-tête du descripteur binaire. Il est suivi du tableau des sprites,
+/// du tableau des groupes, des indices des groupes et de la table des noms.
+typedef struct SpriteSheetBinaryHeader
+{
+    Uint32 magic;
+    Uint32 version;
+    Uint32 spriteCount;
+    Uint32 groupCount;
+    Uint32 indexCount;
+    Uint32 nameSize;
+    Uint32 flags;
+    Uint32 reserved;
+} SpriteSheetBinaryHeader;
+
+typedef struct SpriteSheetBinarySprite
+{
+    float x, y, w, h;
+    float left, right, top, bottom;
+    float scale;
+    Uint32 hasBorders;
+} SpriteSheetBinarySprite;
+
+typedef struct SpriteSheetBinaryGroup
+{
+    /// @brief Position du nom dans la table des noms.
+    Uint32 nameOffset;
+    Uint32 firstIndex;
+    Uint32 indexCount;
+    Uint32 reserved;
+} SpriteSheetBinaryGroup;
 
 SpriteGroup* SpriteGroup_create(SpriteSheet* spriteSheet)
 {
@@ -33,6 +72,7 @@ void SpriteGroup_destroy(SpriteGroup* self)
     {
         SDL_free(self->m_name);
     }
+    free(self->m_spriteIndices);
     free(self);
 }
 
@@ -40,11 +80,24 @@ SpriteSheet* SpriteSheet_create(SDL_Texture* texture, const char* desc, Uint64 d
 {
     assert(texture && "The texture must be valid");
 
+    SpriteSheet* self = SpriteSheet_createFromDesc(desc, descLength);
+    if (self == NULL) return NULL;
+
+    SpriteSheet_setTexture(self, texture);
+
+    return self;
+}
+
+SpriteSheet* SpriteSheet_createFromDesc(const char* desc, Uint64 descLength)
+{
+    if (SpriteSheet_isBinaryDesc(desc, descLength))
+    {
+        return SpriteSheet_createFromBinary((const Uint8*)desc, descLength);
+    }
+
     SpriteSheet* self = (SpriteSheet*)calloc(1, sizeof(SpriteSheet));
     AssertNew(self);
 
-    self->m_texture = texture;
-
     cJSON* root = cJSON_ParseWithLength(desc, (size_t)descLength);
     AssertNew(root);
 
@@ -53,13 +106,37 @@ SpriteSheet* SpriteSheet_create(SDL_Texture* texture, const char* desc, Uint64 d
     cJSON_Delete(root);
     root = NULL;
 
+    int capacity = SpriteSheet_getGroupTableCapacity(self->m_groupCount);
+    int* table = (int*)calloc(capacity, sizeof(int));
+    AssertNew(table);
+    SpriteSheet_buildGroupIndex(self, table, capacity);
+
+    return self;
+}
+
+void SpriteSheet_setTexture(SpriteSheet* self, SDL_Texture* texture)
+{
+    assert(self && "The SpriteSheet must be valid");
+    assert(texture && "The texture must be valid");
+    assert(self->m_texture == NULL && "The SpriteSheet already has a texture");
+
+    self->m_texture = texture;
+
+    // La texture est partagée : le mode de fusion est fixé ici une fois pour
+    // toutes afin que l'opacité portée par les sommets soit prise en compte
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    SDL_GetTextureBlendMode(texture, &blendMode);
+    if (blendMode == SDL_BLENDMODE_NONE)
+    {
+        bool success = SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        assert(success && "Unable to set texture blend mode");
+    }
+
     if (self->m_pixelArt)
     {
         bool success = SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
         assert(success && "Unable to set texture scale mode");
     }
-
-    return self;
 }
 
 void SpriteSheet_destroy(SpriteSheet* self)
@@ -70,6 +147,13 @@ void SpriteSheet_destroy(SpriteSheet* self)
     {
         SDL_DestroyTexture(self->m_texture);
     }
+    if (self->m_singleAllocation)
+    {
+        // Les groupes, les sprites, les noms et l'index font partie du même bloc
+        free(self);
+        return;
+    }
+    free(self->m_groupTable);
     if (self->m_groups)
     {
         for (int i = 0; i < self->m_groupCount; ++i)
@@ -79,19 +163,305 @@ void SpriteSheet_destroy(SpriteSheet* self)
         free(self->m_groups);
     }
     free(self->m_sprites);
+    free(self);
+}
+
+bool SpriteSheet_isBinaryDesc(const void* desc, Uint64 descLength)
+{
+    if (desc == NULL || descLength < sizeof(SpriteSheetBinaryHeader)) return false;
+
+    SpriteSheetBinaryHeader header = { 0 };
+    memcpy(&header, desc, sizeof(header));
+    return header.magic == SPRITE_SHEET_BINARY_MAGIC
+        && header.version == SPRITE_SHEET_BINARY_VERSION;
+}
+
+/// @brief Vérifie les indices, les groupes et la table des noms d'un descripteur
+/// binaire dont les tailles ont déjà été vérifiées.
+static bool SpriteSheet_validateBinary(
+    const SpriteSheetBinaryHeader* header, const SpriteSheetBinaryGroup* groups,
+    const Uint32* indices, const char* names)
+{
+    for (Uint32 i = 0; i < header->indexCount; i++)
+    {
+        if (indices[i] >= header->spriteCount) return false;
+    }
+    if (header->nameSize > 0 && names[header->nameSize - 1] != '\0') return false;
+
+    for (Uint32 i = 0; i < header->groupCount; i++)
+    {
+        const SpriteSheetBinaryGroup* group = groups + i;
+        if ((Uint64)group->firstIndex + group->indexCount > header->indexCount) return false;
+        if (group->nameOffset != SPRITE_SHEET_BINARY_NO_NAME && group->nameOffset >= header->nameSize) return false;
+    }
+    return true;
+}
+
+static SpriteSheet* SpriteSheet_createFromBinary(const Uint8* desc, Uint64 descLength)
+{
+    const SpriteSheetBinaryHeader* header = (const SpriteSheetBinaryHeader*)desc;
+    const Uint64 spritesOffset = sizeof(SpriteSheetBinaryHeader);
+    const Uint64 groupsOffset = spritesOffset + (Uint64)header->spriteCount * sizeof(SpriteSheetBinarySprite);
+    const Uint64 indicesOffset = groupsOffset + (Uint64)header->groupCount * sizeof(SpriteSheetBinaryGroup);
+    const Uint64 namesOffset = indicesOffset + (Uint64)header->indexCount * sizeof(Uint32);
+    if (namesOffset + header->nameSize > descLength || header->spriteCount == 0)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid binary sprite sheet descriptor");
+        return NULL;
+    }
+
+    const SpriteSheetBinarySprite* srcSprites = (const SpriteSheetBinarySprite*)(desc + spritesOffset);
+    const SpriteSheetBinaryGroup* srcGroups = (const SpriteSheetBinaryGroup*)(desc + groupsOffset);
+    const Uint32* srcIndices = (const Uint32*)(desc + indicesOffset);
+    const char* srcNames = (const char*)(desc + namesOffset);
+
+    // Le descripteur peut provenir d'un fichier corrompu : les positions sont
+    // vérifiées avant d'être utilisées, y compris dans une version release
+    if (!SpriteSheet_validateBinary(header, srcGroups, srcIndices, srcNames))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid binary sprite sheet descriptor");
+        return NULL;
+    }
+
+    // Une seule allocation pour la sprite sheet et toutes ses données
+    size_t blockSize = SPRITE_SHEET_BLOCK_ALIGN(sizeof(SpriteSheet));
+    const size_t groupPtrsOffset = blockSize;
+    blockSize = SPRITE_SHEET_BLOCK_ALIGN(blockSize + header->groupCount * sizeof(SpriteGroup*));
+    const size_t groupDataOffset = blockSize;
+    blockSize = SPRITE_SHEET_BLOCK_ALIGN(blockSize + header->groupCount * sizeof(SpriteGroup));
+    const size_t spriteDataOffset = blockSize;
+    blockSize = SPRITE_SHEET_BLOCK_ALIGN(blockSize + header->spriteCount * sizeof(Sprite));
+    const size_t indexDataOffset = blockSize;
+    blockSize = SPRITE_SHEET_BLOCK_ALIGN(blockSize + header->indexCount * sizeof(int));
+    const size_t tableDataOffset = blockSize;
+    const int tableCapacity = SpriteSheet_getGroupTableCapacity((int)header->groupCount);
+    blockSize = SPRITE_SHEET_BLOCK_ALIGN(blockSize + tableCapacity * sizeof(int));
+    const size_t nameDataOffset = blockSize;
+    blockSize += header->nameSize;
+
+    Uint8* block = (Uint8*)calloc(1, blockSize);
+    AssertNew(block);
+
+    SpriteSheet* self = (SpriteSheet*)block;
+    SpriteGroup** groupPtrs = (SpriteGroup**)(block + groupPtrsOffset);
+    SpriteGroup* groups = (SpriteGroup*)(block + groupDataOffset);
+    int* indices = (int*)(block + indexDataOffset);
+    char* names = (char*)(block + nameDataOffset);
+
+    self->m_singleAllocation = true;
+    self->m_pixelArt = (header->flags & SPRITE_SHEET_BINARY_FLAG_PIXEL_ART) != 0;
+    self->m_sprites = (Sprite*)(block + spriteDataOffset);
+    self->m_spriteCount = (int)header->spriteCount;
+    self->m_groups = groupPtrs;
+    self->m_groupCount = (int)header->groupCount;
+
+    for (int i = 0; i < self->m_spriteCount; i++)
+    {
+        const SpriteSheetBinarySprite* src = srcSprites + i;
+        Sprite* sprite = self->m_sprites + i;
+        sprite->srcRect.x = src->x;
+        sprite->srcRect.y = src->y;
+        sprite->srcRect.w = src->w;
+        sprite->srcRect.h = src->h;
+        sprite->hasBorders = (src->hasBorders != 0);
+        sprite->left = src->left;
+        sprite->right = src->right;
+        sprite->top = src->top;
+        sprite->bottom = src->bottom;
+        sprite->scale = src->scale;
+    }
+
+    for (Uint32 i = 0; i < header->indexCount; i++)
+    {
+        indices[i] = (int)srcIndices[i];
+    }
+    memcpy(names, srcNames, header->nameSize);
+
+    for (int i = 0; i < self->m_groupCount; i++)
+    {
+        const SpriteSheetBinaryGroup* src = srcGroups + i;
+
+        SpriteGroup* group = groups + i;
+        group->m_spriteSheet = self;
+        group->m_spriteIndices = indices + src->firstIndex;
+        group->m_spriteCount = (int)src->indexCount;
+        if (src->nameOffset != SPRITE_SHEET_BINARY_NO_NAME)
+        {
+            group->m_name = names + src->nameOffset;
+            group->m_nameID = StringID_intern(group->m_name);
+        }
+        groupPtrs[i] = group;
+    }
+
+    SpriteSheet_buildGroupIndex(self, (int*)(block + tableDataOffset), tableCapacity);
+
+    return self;
+}
+
+bool SpriteSheet_compileDesc(const char* desc, Uint64 descLength, void** outBuffer, Uint64* outSize)
+{
+    assert(outBuffer && outSize && "The output buffer and size must be valid");
+
+    cJSON* root = cJSON_ParseWithLength(desc, (size_t)descLength);
+    if (root == NULL) return false;
+
+    SpriteSheet* sheet = (SpriteSheet*)calloc(1, sizeof(SpriteSheet));
+    AssertNew(sheet);
+    SpriteSheet_parseJSON(sheet, root);
+    cJSON_Delete(root);
+    root = NULL;
+
+    SpriteSheetBinaryHeader header = { 0 };
+    header.magic = SPRITE_SHEET_BINARY_MAGIC;
+    header.version = SPRITE_SHEET_BINARY_VERSION;
+    header.spriteCount = (Uint32)sheet->m_spriteCount;
+    header.groupCount = (Uint32)sheet->m_groupCount;
+    header.flags = sheet->m_pixelArt ? SPRITE_SHEET_BINARY_FLAG_PIXEL_ART : 0;
+    for (int i = 0; i < sheet->m_groupCount; i++)
+    {
+        SpriteGroup* group = sheet->m_groups[i];
+        header.indexCount += (Uint32)group->m_spriteCount;
+        if (group->m_name)
+        {
+            header.nameSize += (Uint32)strlen(group->m_name) + 1;
+        }
+    }
+
+    const Uint64 spritesOffset = sizeof(SpriteSheetBinaryHeader);
+    const Uint64 groupsOffset = spritesOffset + (Uint64)header.spriteCount * sizeof(SpriteSheetBinarySprite);
+    const Uint64 indicesOffset = groupsOffset + (Uint64)header.groupCount * sizeof(SpriteSheetBinaryGroup);
+    const Uint64 namesOffset = indicesOffset + (Uint64)header.indexCount * sizeof(Uint32);
+    const Uint64 size = namesOffset + header.nameSize;
+
+    Uint8* buffer = (Uint8*)SDL_calloc(1, (size_t)size);
+    AssertNew(buffer);
+    memcpy(buffer, &header, sizeof(header));
+
+    SpriteSheetBinarySprite* dstSprites = (SpriteSheetBinarySprite*)(buffer + spritesOffset);
+    for (int i = 0; i < sheet->m_spriteCount; i++)
+    {
+        const Sprite* sprite = sheet->m_sprites + i;
+        SpriteSheetBinarySprite* dst = dstSprites + i;
+        dst->x = sprite->srcRect.x;
+        dst->y = sprite->srcRect.y;
+        dst->w = sprite->srcRect.w;
+        dst->h = sprite->srcRect.h;
+        dst->left = sprite->left;
+        dst->right = sprite->right;
+        dst->top = sprite->top;
+        dst->bottom = sprite->bottom;
+        dst->scale = sprite->scale;
+        dst->hasBorders = sprite->hasBorders ? 1 : 0;
+    }
+
+    SpriteSheetBinaryGroup* dstGroups = (SpriteSheetBinaryGroup*)(buffer + groupsOffset);
+    Uint32* dstIndices = (Uint32*)(buffer + indicesOffset);
+    char* dstNames = (char*)(buffer + namesOffset);
+    Uint32 indexCount = 0;
+    Uint32 nameSize = 0;
+    for (int i = 0; i < sheet->m_groupCount; i++)
+    {
+        const SpriteGroup* group = sheet->m_groups[i];
+        SpriteSheetBinaryGroup* dst = dstGroups + i;
+        dst->firstIndex = indexCount;
+        dst->indexCount = (Uint32)group->m_spriteCount;
+        dst->nameOffset = SPRITE_SHEET_BINARY_NO_NAME;
+
+        for (int j = 0; j < group->m_spriteCount; j++)
+        {
+            dstIndices[indexCount++] = (Uint32)group->m_spriteIndices[j];
+        }
+        if (group->m_name)
+        {
+            size_t nameLength = strlen(group->m_name) + 1;
+            dst->nameOffset = nameSize;
+            memcpy(dstNames + nameSize, group->m_name, nameLength);
+            nameSize += (Uint32)nameLength;
+        }
+    }
+
+    SpriteSheet_destroy(sheet);
+
+    *outBuffer = buffer;
+    *outSize = size;
+    return true;
 }
 
 SpriteGroup* SpriteSheet_getGroupByName(SpriteSheet* self, const char* name)
 {
     assert(self && "The SpriteSheet must be valid");
-    for (int i = 0; i < self->m_groupCount; ++i)
+    int handle = SpriteSheet_getGroupHandle(self, name);
+    return (handle >= 0) ? self->m_groups[handle] : NULL;
+}
+
+SpriteGroup* SpriteSheet_getGroupByID(SpriteSheet* self, StringID nameID)
+{
+    assert(self && "The SpriteSheet must be valid");
+    int handle = SpriteSheet_getGroupHandleByID(self, nameID);
+    return (handle >= 0) ? self->m_groups[handle] : NULL;
+}
+
+int SpriteSheet_getGroupHandle(SpriteSheet* self, const char* name)
+{
+    assert(self && "The SpriteSheet must be valid");
+    assert(name && "The name must be valid");
+
+    // Un nom jamais interné ne peut pas être celui d'un groupe
+    return SpriteSheet_getGroupHandleByID(self, StringID_find(name));
+}
+
+int SpriteSheet_getGroupHandleByID(SpriteSheet* self, StringID nameID)
+{
+    assert(self && "The SpriteSheet must be valid");
+    if (nameID == STRING_ID_INVALID || self->m_groupTableCapacity == 0) return -1;
+
+    const int mask = self->m_groupTableCapacity - 1;
+    int slot = (int)((nameID * 0x9E3779B1u) >> 7) & mask;
+    while (self->m_groupTable[slot] >= 0)
+    {
+        int index = self->m_groupTable[slot];
+        if (self->m_groups[index]->m_nameID == nameID) return index;
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+static int SpriteSheet_getGroupTableCapacity(int groupCount)
+{
+    int capacity = 4;
+    while (capacity < 2 * groupCount)
     {
-        if (SDL_strcmp(name, self->m_groups[i]->m_name) == 0)
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static void SpriteSheet_buildGroupIndex(SpriteSheet* self, int* table, int capacity)
+{
+    assert((capacity & (capacity - 1)) == 0 && "The capacity must be a power of two");
+    self->m_groupTable = table;
+    self->m_groupTableCapacity = capacity;
+    for (int i = 0; i < capacity; i++)
+    {
+        table[i] = -1;
+    }
+
+    const int mask = capacity - 1;
+    for (int i = 0; i < self->m_groupCount; i++)
+    {
+        StringID nameID = self->m_groups[i]->m_nameID;
+        if (nameID == STRING_ID_INVALID) continue;
+
+        // En cas de doublon, le premier groupe est conservé
+        if (SpriteSheet_getGroupHandleByID(self, nameID) >= 0) continue;
+
+        int slot = (int)((nameID * 0x9E3779B1u) >> 7) & mask;
+        while (table[slot] >= 0)
         {
-            return self->m_groups[i];
+            slot = (slot + 1) & mask;
         }
+        table[slot] = i;
     }
-    return NULL;
 }
 
 SpriteGroup* SpriteSheet_getGroupByIndex(SpriteSheet* self, int index)
@@ -302,6 +672,7 @@ static void SpriteSheet_parseGroup(SpriteSheet* self, cJSON* jGroup, int i)
     if (cJSON_IsString(jTmp))
     {
         group->m_name = SDL_strdup(cJSON_GetStringValue(jTmp));
+        group->m_nameID = StringID_intern(group->m_name);
     }
 
     jTmp = cJSON_GetObjectItem(jGroup, "frames");
@@ -325,6 +696,50 @@ static void SpriteSheet_parseGroup(SpriteSheet* self, cJSON* jGroup, int i)
     }
 }
 
+static SDL_FColor SpriteGroup_getTextureColor(SDL_Texture* texture)
+{
+    SDL_FColor color = { 1.f, 1.f, 1.f, 1.f };
+    SDL_GetTextureColorModFloat(texture, &color.r, &color.g, &color.b);
+    SDL_GetTextureAlphaModFloat(texture, &color.a);
+    return color;
+}
+
+static void SpriteGroup_submitToQueue(
+    SpriteGroup* self, RenderQueue* queue, int index,
+    const SDL_FRect* dstRect, Vec2 anchor, float scale, SDL_FColor color)
+{
+    const SpriteSheet* spriteSheet = self->m_spriteSheet;
+    const Sprite* sprite = spriteSheet->m_sprites + self->m_spriteIndices[index];
+
+    SDL_FRect dst = { 0 };
+    if (dstRect)
+    {
+        dst = *dstRect;
+        dst.x -= anchor.x * dst.w;
+        dst.y -= (1.f - anchor.y) * dst.h;
+    }
+    else
+    {
+        int w = 0, h = 0;
+        SDL_GetCurrentRenderOutputSize(g_renderer, &w, &h);
+        dst.w = (float)w;
+        dst.h = (float)h;
+    }
+
+    if (sprite->hasBorders)
+    {
+        RenderQueue_add9Grid(
+            queue, spriteSheet->m_texture, &(sprite->srcRect), &dst,
+            sprite->left, sprite->right, sprite->top, sprite->bottom,
+            SDL_roundf(sprite->scale * scale), color
+        );
+    }
+    else
+    {
+        RenderQueue_addQuad(queue, spriteSheet->m_texture, &(sprite->srcRect), &dst, color);
+    }
+}
+
 void SpriteGroup_render(SpriteGroup* self, int index, const SDL_FRect* dstRect, Vec2 anchor, float scale)
 {
     assert(self && self->m_spriteSheet);
@@ -335,6 +750,14 @@ void SpriteGroup_render(SpriteGroup* self, int index, const SDL_FRect* dstRect,
     const SDL_FRect* srcRect = &(sprite->srcRect);
     bool success = true;
 
+    RenderQueue* queue = RenderQueue_getCurrent();
+    if (queue)
+    {
+        SDL_FColor color = SpriteGroup_getTextureColor(spriteSheet->m_texture);
+        SpriteGroup_submitToQueue(self, queue, index, dstRect, anchor, scale, color);
+        return;
+    }
+
     if (sprite->hasBorders)
     {
         success = RenderTexture9Grid(
@@ -356,6 +779,89 @@ void SpriteGroup_render(SpriteGroup* self, int index, const SDL_FRect* dstRect,
     }
 }
 
+void SpriteGroup_renderWithColor(
+    SpriteGroup* self, int index,
+    const SDL_FRect* dstRect, Vec2 anchor,
+    float scale, SDL_FColor color)
+{
+    assert(self && self->m_spriteSheet);
+    assert(index >= 0);
+    index = index % self->m_spriteCount;
+
+    RenderQueue* queue = RenderQueue_getCurrent();
+    if (queue)
+    {
+        SpriteGroup_submitToQueue(self, queue, index, dstRect, anchor, scale, color);
+        return;
+    }
+
+    SpriteGroup_setColorModFloat(self, color.r, color.g, color.b);
+    SpriteGroup_setOpacityFloat(self, color.a);
+    SpriteGroup_render(self, index, dstRect, anchor, scale);
+}
+
+void SpriteGroup_renderCached(
+    SpriteGroup* self, int index,
+    const SDL_FRect* dstRect, Vec2 anchor,
+    float scale, SDL_FColor color, SpriteGeometry* geometry)
+{
+    assert(self && self->m_spriteSheet);
+    assert(index >= 0);
+    assert(geometry && dstRect);
+    index = index % self->m_spriteCount;
+    const SpriteSheet* spriteSheet = self->m_spriteSheet;
+    const Sprite* sprite = spriteSheet->m_sprites + self->m_spriteIndices[index];
+    SDL_Texture* texture = spriteSheet->m_texture;
+
+    if (sprite->hasBorders == false)
+    {
+        SpriteGroup_renderWithColor(self, index, dstRect, anchor, scale, color);
+        return;
+    }
+
+    const float borderScale = SDL_roundf(sprite->scale * scale);
+    if ((geometry->m_sprite != sprite) ||
+        (geometry->m_texture != texture) ||
+        (geometry->m_width != dstRect->w) ||
+        (geometry->m_height != dstRect->h) ||
+        (geometry->m_scale != borderScale))
+    {
+        float textureWidth = 1.f, textureHeight = 1.f;
+        SDL_GetTextureSize(texture, &textureWidth, &textureHeight);
+
+        SDL_FRect localRect = { 0.f, 0.f, dstRect->w, dstRect->h };
+        SDL_FColor white = { 1.f, 1.f, 1.f, 1.f };
+        SpriteBatch_build9GridVertices(
+            geometry->m_vertices, textureWidth, textureHeight,
+            &(sprite->srcRect), &localRect,
+            sprite->left, sprite->right, sprite->top, sprite->bottom,
+            borderScale, white
+        );
+        geometry->m_sprite = sprite;
+        geometry->m_texture = texture;
+        geometry->m_width = dstRect->w;
+        geometry->m_height = dstRect->h;
+        geometry->m_scale = borderScale;
+    }
+
+    const float x = dstRect->x - anchor.x * dstRect->w;
+    const float y = dstRect->y - (1.f - anchor.y) * dstRect->h;
+    SDL_Vertex vertices[SPRITE_BATCH_9GRID_VERTEX_COUNT];
+    for (int i = 0; i < SPRITE_BATCH_9GRID_VERTEX_COUNT; i++)
+    {
+        vertices[i] = geometry->m_vertices[i];
+        vertices[i].position.x += x;
+        vertices[i].position.y += y;
+        vertices[i].color = color;
+    }
+
+    RenderQueue_drawGeometry(
+        texture,
+        vertices, SPRITE_BATCH_9GRID_VERTEX_COUNT,
+        SpriteBatch_get9GridIndices(), SPRITE_BATCH_9GRID_INDEX_COUNT
+    );
+}
+
 void SpriteGroup_renderRotated(
     SpriteGroup* self, int index,
     const SDL_FRect* dstRect, Vec2 anchor,
@@ -368,6 +874,36 @@ void SpriteGroup_renderRotated(
     const Sprite* sprite = spriteSheet->m_sprites + self->m_spriteIndices[index];
     const SDL_FRect* srcRect = &(sprite->srcRect);
 
+    RenderQueue* queue = RenderQueue_getCurrent();
+    if (queue)
+    {
+        SDL_FColor color = SpriteGroup_getTextureColor(spriteSheet->m_texture);
+        if (dstRect == NULL)
+        {
+            // Comme SDL_RenderTextureRotated(), rotation autour du centre de la cible
+            SDL_FRect dst = { 0 };
+            int w = 0, h = 0;
+            SDL_GetCurrentRenderOutputSize(g_renderer, &w, &h);
+            dst.w = (float)w;
+            dst.h = (float)h;
+            RenderQueue_addQuadRotated(
+                queue, spriteSheet->m_texture, srcRect, &dst,
+                angle, NULL, flip, color
+            );
+            return;
+        }
+
+        SDL_FPoint pivot = { anchor.x * dstRect->w, (1.f - anchor.y) * dstRect->h };
+        SDL_FRect dst = *dstRect;
+        dst.x -= pivot.x;
+        dst.y -= pivot.y;
+        RenderQueue_addQuadRotated(
+            queue, spriteSheet->m_texture, srcRect, &dst,
+            angle, &pivot, flip, color
+        );
+        return;
+    }
+
     bool success = RenderTextureRotated(
         g_renderer, spriteSheet->m_texture, srcRect, dstRect, anchor,
         angle, flip
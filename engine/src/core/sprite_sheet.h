@@ -8,6 +8,8 @@
 
 #include "game_engine_settings.h"
 #include "utils/utils.h"
+#include "utils/string_id.h"
+#include "core/sprite_batch.h"
 
 typedef struct SpriteSheet SpriteSheet;
 
@@ -23,10 +25,33 @@ typedef struct SpriteGroup
 {
     SpriteSheet* m_spriteSheet;
     char* m_name;
+    StringID m_nameID;
     int* m_spriteIndices;
     int m_spriteCount;
 } SpriteGroup;
 
+/// @brief Géométrie précalculée d'un sprite 9-slice.
+/// Les sommets sont calculés pour un rectangle de destination placé à
+/// l'origine puis translatés à chaque rendu. Ils ne sont recalculés que
+/// lorsque le sprite, la taille de destination ou l'échelle changent.
+/// Une structure initialisée à zéro est vide.
+typedef struct SpriteGeometry
+{
+    const Sprite* m_sprite;
+    SDL_Texture* m_texture;
+    float m_width;
+    float m_height;
+    float m_scale;
+    SDL_Vertex m_vertices[SPRITE_BATCH_9GRID_VERTEX_COUNT];
+} SpriteGeometry;
+
+/// @brief Invalide une géométrie précalculée.
+/// @param self la géométrie.
+INLINE void SpriteGeometry_invalidate(SpriteGeometry* self)
+{
+    self->m_sprite = NULL;
+}
+
 SpriteGroup* SpriteGroup_create(SpriteSheet* spriteSheet);
 void SpriteGroup_destroy(SpriteGroup* self);
 
@@ -35,6 +60,36 @@ void SpriteGroup_render(
     const SDL_FRect* dstRect, Vec2 anchor,
     float scale);
 
+/// @brief Dessine un sprite avec une couleur de modulation explicite.
+/// Lorsqu'un SpriteBatch est actif, la couleur est portée par les sommets
+/// et la texture partagée de l'atlas n'est pas modifiée.
+/// @param self le groupe de sprites.
+/// @param index l'indice du sprite dans le groupe.
+/// @param dstRect le rectangle de destination.
+/// @param anchor l'ancre du rectangle de destination.
+/// @param scale l'échelle des bords pour les sprites 9-slice.
+/// @param color la couleur de modulation, opacité comprise.
+void SpriteGroup_renderWithColor(
+    SpriteGroup* self, int index,
+    const SDL_FRect* dstRect, Vec2 anchor,
+    float scale, SDL_FColor color);
+
+/// @brief Dessine un sprite avec une couleur de modulation explicite en
+/// réutilisant la géométrie 9-slice précalculée de l'appelant.
+/// La géométrie est émise avec une seule soumission de sommets.
+/// Les sprites sans bords sont dessinés comme avec SpriteGroup_renderWithColor().
+/// @param self le groupe de sprites.
+/// @param index l'indice du sprite dans le groupe.
+/// @param dstRect le rectangle de destination.
+/// @param anchor l'ancre du rectangle de destination.
+/// @param scale l'échelle des bords.
+/// @param color la couleur de modulation, opacité comprise.
+/// @param geometry la géométrie précalculée, mise à jour si nécessaire.
+void SpriteGroup_renderCached(
+    SpriteGroup* self, int index,
+    const SDL_FRect* dstRect, Vec2 anchor,
+    float scale, SDL_FColor color, SpriteGeometry* geometry);
+
 void SpriteGroup_renderRotated(
     SpriteGroup* self, int index,
     const SDL_FRect* dstRect, Vec2 anchor,
@@ -56,11 +111,77 @@ typedef struct SpriteSheet
     int m_spriteCount;
 
     bool m_pixelArt;
+
+    /// @brief Indique si la sprite sheet, ses groupes et ses sprites sont
+    /// stockés dans une seule allocation (descripteur binaire).
+    bool m_singleAllocation;
+
+    /// @brief Index des groupes par nom : table à adressage ouvert, indexée
+    /// par l'identifiant interné du nom et contenant l'indice du groupe ou -1.
+    int* m_groupTable;
+    int m_groupTableCapacity;
 } SpriteSheet;
 
+#define SPRITE_SHEET_BINARY_MAGIC 0x44535347 // "GSSD"
+#define SPRITE_SHEET_BINARY_VERSION 1
+
 SpriteSheet* SpriteSheet_create(SDL_Texture* texture, const char* desc, Uint64 descLength);
 void SpriteSheet_destroy(SpriteSheet* self);
 
+/// @brief Crée une sprite sheet à partir de son descripteur, sans texture.
+/// Le descripteur peut être au format JSON ou au format binaire produit par
+/// SpriteSheet_compileDesc(), chargé sans analyse en une seule allocation.
+/// Cette fonction n'utilise pas le moteur de rendu et peut être appelée
+/// depuis un autre thread que le thread principal.
+/// @param desc le descripteur de la sprite sheet.
+/// @param descLength la taille du descripteur.
+/// @return La sprite sheet créée ou NULL si le descripteur binaire n'est pas valide.
+SpriteSheet* SpriteSheet_createFromDesc(const char* desc, Uint64 descLength);
+
+/// @brief Compile un descripteur JSON au format binaire.
+/// Le format binaire contient un en-tête, le tableau des sprites, les groupes,
+/// les indices des groupes et la table des noms.
+/// @param desc le descripteur JSON.
+/// @param descLength la taille du descripteur.
+/// @param outBuffer le descripteur binaire, à libérer avec SDL_free().
+/// @param outSize la taille du descripteur binaire.
+/// @return true si le descripteur a été compilé, false s'il n'est pas valide.
+bool SpriteSheet_compileDesc(const char* desc, Uint64 descLength, void** outBuffer, Uint64* outSize);
+
+/// @brief Indique si un descripteur est au format binaire.
+/// @param desc le descripteur.
+/// @param descLength la taille du descripteur.
+/// @return true si le descripteur est au format binaire.
+bool SpriteSheet_isBinaryDesc(const void* desc, Uint64 descLength);
+
+/// @brief Associe la texture de l'atlas à une sprite sheet.
+/// La sprite sheet devient propriétaire de la texture. Une texture opaque
+/// passe en mode de fusion SDL_BLENDMODE_BLEND.
+/// @param self la sprite sheet.
+/// @param texture la texture.
+void SpriteSheet_setTexture(SpriteSheet* self, SDL_Texture* texture);
+
 SpriteGroup* SpriteSheet_getGroupByName(SpriteSheet* self, const char* name);
 SpriteGroup* SpriteSheet_getGroupByIndex(SpriteSheet* self, int index);
 
+/// @brief Renvoie le groupe associé à un nom interné.
+/// La recherche ne calcule aucun hash de chaîne.
+/// @param self la sprite sheet.
+/// @param nameID l'identifiant du nom obtenu avec StringID_intern().
+/// @return Le groupe ou NULL s'il n'existe pas.
+SpriteGroup* SpriteSheet_getGroupByID(SpriteSheet* self, StringID nameID);
+
+/// @brief Résout une fois le nom d'un groupe en un handle stable.
+/// Le handle reste valide pendant toute la durée de vie de la sprite sheet
+/// et s'utilise avec SpriteSheet_getGroupByIndex().
+/// @param self la sprite sheet.
+/// @param name le nom du groupe.
+/// @return Le handle du groupe ou -1 s'il n'existe pas.
+int SpriteSheet_getGroupHandle(SpriteSheet* self, const char* name);
+
+/// @brief Résout un nom interné en un handle stable.
+/// @param self la sprite sheet.
+/// @param nameID l'identifiant du nom.
+/// @return Le handle du groupe ou -1 s'il n'existe pas.
+int SpriteSheet_getGroupHandleByID(SpriteSheet* self, StringID nameID);
+
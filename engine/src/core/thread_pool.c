@@ -0,0 +1,155 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/thread_pool.h"
+
+static int SDLCALL ThreadPool_workerMain(void* data);
+
+ThreadPool* ThreadPool_create(int threadCount)
+{
+    ThreadPool* self = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    AssertNew(self);
+
+    if (threadCount <= 0)
+    {
+        threadCount = SDL_GetNumLogicalCPUCores() - 1;
+        threadCount = (threadCount > 1) ? threadCount : 1;
+    }
+
+    self->m_mutex = SDL_CreateMutex();
+    self->m_taskCond = SDL_CreateCondition();
+    self->m_idleCond = SDL_CreateCondition();
+    AssertNew(self->m_mutex);
+    AssertNew(self->m_taskCond);
+    AssertNew(self->m_idleCond);
+
+    self->m_taskCapacity = 64;
+    self->m_tasks = (ThreadPoolTask*)calloc(self->m_taskCapacity, sizeof(ThreadPoolTask));
+    AssertNew(self->m_tasks);
+
+    self->m_threads = (SDL_Thread**)calloc(threadCount, sizeof(SDL_Thread*));
+    AssertNew(self->m_threads);
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        char name[32] = { 0 };
+        SDL_snprintf(name, sizeof(name), "ThreadPool_%d", i);
+        SDL_Thread* thread = SDL_CreateThread(ThreadPool_workerMain, name, self);
+        if (thread == NULL)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to create thread %s", name);
+            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
+            break;
+        }
+        self->m_threads[self->m_threadCount++] = thread;
+    }
+    assert(self->m_threadCount > 0 && "The ThreadPool must have at least one thread");
+
+    return self;
+}
+
+void ThreadPool_destroy(ThreadPool* self)
+{
+    if (!self) return;
+
+    SDL_LockMutex(self->m_mutex);
+    self->m_stopping = true;
+    SDL_BroadcastCondition(self->m_taskCond);
+    SDL_UnlockMutex(self->m_mutex);
+
+    for (int i = 0; i < self->m_threadCount; i++)
+    {
+        SDL_WaitThread(self->m_threads[i], NULL);
+    }
+
+    SDL_DestroyCondition(self->m_idleCond);
+    SDL_DestroyCondition(self->m_taskCond);
+    SDL_DestroyMutex(self->m_mutex);
+    free(self->m_threads);
+    free(self->m_tasks);
+    free(self);
+}
+
+void ThreadPool_submit(ThreadPool* self, ThreadPoolTaskFunc function, void* userData)
+{
+    assert(self && "The ThreadPool must be created");
+    assert(function && "The task function must be valid");
+
+    SDL_LockMutex(self->m_mutex);
+    assert(self->m_stopping == false && "The ThreadPool is stopping");
+
+    if (self->m_taskCount >= self->m_taskCapacity)
+    {
+        // Agrandit la file en remettant les tâches dans l'ordre
+        int newCapacity = 2 * self->m_taskCapacity;
+        ThreadPoolTask* newTasks = (ThreadPoolTask*)calloc(newCapacity, sizeof(ThreadPoolTask));
+        AssertNew(newTasks);
+        for (int i = 0; i < self->m_taskCount; i++)
+        {
+            newTasks[i] = self->m_tasks[(self->m_taskHead + i) % self->m_taskCapacity];
+        }
+        free(self->m_tasks);
+        self->m_tasks = newTasks;
+        self->m_taskCapacity = newCapacity;
+        self->m_taskHead = 0;
+    }
+
+    int index = (self->m_taskHead + self->m_taskCount) % self->m_taskCapacity;
+    self->m_tasks[index].function = function;
+    self->m_tasks[index].userData = userData;
+    self->m_taskCount++;
+
+    SDL_SignalCondition(self->m_taskCond);
+    SDL_UnlockMutex(self->m_mutex);
+}
+
+void ThreadPool_wait(ThreadPool* self)
+{
+    assert(self && "The ThreadPool must be created");
+
+    SDL_LockMutex(self->m_mutex);
+    while (self->m_taskCount > 0 || self->m_activeCount > 0)
+    {
+        SDL_WaitCondition(self->m_idleCond, self->m_mutex);
+    }
+    SDL_UnlockMutex(self->m_mutex);
+}
+
+static int SDLCALL ThreadPool_workerMain(void* data)
+{
+    ThreadPool* self = (ThreadPool*)data;
+
+    SDL_LockMutex(self->m_mutex);
+    while (true)
+    {
+        while (self->m_taskCount == 0 && self->m_stopping == false)
+        {
+            SDL_WaitCondition(self->m_taskCond, self->m_mutex);
+        }
+        if (self->m_taskCount == 0 && self->m_stopping)
+        {
+            break;
+        }
+
+        ThreadPoolTask task = self->m_tasks[self->m_taskHead];
+        self->m_taskHead = (self->m_taskHead + 1) % self->m_taskCapacity;
+        self->m_taskCount--;
+        self->m_activeCount++;
+        SDL_UnlockMutex(self->m_mutex);
+
+        task.function(task.userData);
+
+        SDL_LockMutex(self->m_mutex);
+        self->m_activeCount--;
+        if (self->m_taskCount == 0 && self->m_activeCount == 0)
+        {
+            SDL_BroadcastCondition(self->m_idleCond);
+        }
+    }
+    SDL_UnlockMutex(self->m_mutex);
+
+    return 0;
+}
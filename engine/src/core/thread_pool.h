@@ -0,0 +1,66 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+/// @brief Fonction exécutée par un thread du pool.
+typedef void (*ThreadPoolTaskFunc)(void* userData);
+
+typedef struct ThreadPoolTask
+{
+    ThreadPoolTaskFunc function;
+    void* userData;
+} ThreadPoolTask;
+
+/// @brief Structure représentant un ensemble de threads exécutant des tâches.
+typedef struct ThreadPool
+{
+    SDL_Thread** m_threads;
+    int m_threadCount;
+
+    SDL_Mutex* m_mutex;
+    SDL_Condition* m_taskCond;
+    SDL_Condition* m_idleCond;
+
+    /// @brief File circulaire des tâches en attente.
+    ThreadPoolTask* m_tasks;
+    int m_taskCapacity;
+    int m_taskHead;
+    int m_taskCount;
+
+    /// @brief Nombre de tâches en cours d'exécution.
+    int m_activeCount;
+    bool m_stopping;
+} ThreadPool;
+
+/// @brief Crée un pool de threads.
+/// @param threadCount le nombre de threads, ou une valeur négative ou nulle
+///     pour utiliser le nombre de coeurs logiques moins un.
+/// @return Le pool créé.
+ThreadPool* ThreadPool_create(int threadCount);
+
+/// @brief Détruit un pool de threads.
+/// Les tâches déjà soumises sont exécutées avant l'arrêt des threads.
+/// @param self le pool.
+void ThreadPool_destroy(ThreadPool* self);
+
+/// @brief Ajoute une tâche à la file du pool.
+/// @param self le pool.
+/// @param function la fonction à exécuter.
+/// @param userData le paramètre transmis à la fonction.
+void ThreadPool_submit(ThreadPool* self, ThreadPoolTaskFunc function, void* userData);
+
+/// @brief Attend que toutes les tâches soumises soient terminées.
+/// @param self le pool.
+void ThreadPool_wait(ThreadPool* self);
+
+INLINE int ThreadPool_getThreadCount(ThreadPool* self)
+{
+    assert(self && "The ThreadPool must be created");
+    return self->m_threadCount;
+}
@@ -19,8 +19,14 @@ Timer* Timer_create()
     self->m_elapsed = 0;
     self->m_unscaledElapsed = 0;
 
-    self->m_maxDelta = 100;
+    self->m_maxDelta = SDL_MS_TO_NS(100);
     self->m_scale = 1.0f;
+    self->m_scaleRemainder = 0.0;
+
+    self->m_fixedStep = 0;
+    self->m_fixedAccumulator = 0;
+    self->m_fixedStepCount = 0;
+    self->m_maxFixedSteps = 1;
 
     return self;
 }
@@ -34,24 +40,61 @@ void Timer_destroy(Timer* self)
 void Timer_start(Timer* self)
 {
     assert(self && "The Timer must be created");
-    self->m_currentTime = SDL_GetTicks();
-    self->m_previousTime = SDL_GetTicks();
+    self->m_startTime = SDL_GetTicksNS();
+    self->m_currentTime = self->m_startTime;
+    self->m_previousTime = self->m_startTime;
     self->m_delta = 0;
+    self->m_unscaledDelta = 0;
+    self->m_elapsed = 0;
+    self->m_unscaledElapsed = 0;
+    self->m_scaleRemainder = 0.0;
+    self->m_fixedAccumulator = 0;
+    self->m_fixedStepCount = 0;
+}
+
+void Timer_setFixedStep(Timer* self, double step, int maxSteps)
+{
+    assert(self && "The Timer must be created");
+    assert(step >= 0.0 && maxSteps > 0);
+    self->m_fixedStep = (Uint64)(step * 1e9 + 0.5);
+    self->m_maxFixedSteps = maxSteps;
+    self->m_fixedAccumulator = 0;
+    self->m_fixedStepCount = 0;
 }
 
 void Timer_update(Timer* self)
 {
     assert(self && "The Timer must be created");
     self->m_previousTime = self->m_currentTime;
-    self->m_currentTime = SDL_GetTicks();
+    self->m_currentTime = SDL_GetTicksNS();
 
     self->m_unscaledDelta = self->m_currentTime - self->m_previousTime;
     if (self->m_unscaledDelta > self->m_maxDelta)
     {
         self->m_unscaledDelta = self->m_maxDelta;
     }
-    self->m_delta = (Uint64)(self->m_scale * (double)self->m_unscaledDelta);
+
+    // La partie fractionnaire est reportée pour que le temps mis à l'échelle
+    // cumulé ne dérive pas par rapport au temps réel
+    const double scaled = self->m_scale * (double)self->m_unscaledDelta + self->m_scaleRemainder;
+    self->m_delta = (Uint64)scaled;
+    self->m_scaleRemainder = scaled - (double)self->m_delta;
 
     self->m_unscaledElapsed += self->m_unscaledDelta;
     self->m_elapsed += self->m_delta;
+
+    if (self->m_fixedStep > 0)
+    {
+        self->m_fixedAccumulator += self->m_delta;
+        Uint64 stepCount = self->m_fixedAccumulator / self->m_fixedStep;
+        if (stepCount > (Uint64)self->m_maxFixedSteps)
+        {
+            // La simulation ne rattrape pas son retard : le temps en excès est abandonné
+            stepCount = (Uint64)self->m_maxFixedSteps;
+            self->m_fixedAccumulator = stepCount * self->m_fixedStep
+                + self->m_fixedAccumulator % self->m_fixedStep;
+        }
+        self->m_fixedAccumulator -= stepCount * self->m_fixedStep;
+        self->m_fixedStepCount = (int)stepCount;
+    }
 }
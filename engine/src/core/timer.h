@@ -9,48 +9,70 @@
 #include "game_engine_settings.h"
 
 /// @brief Structure représentant un chronomètre.
+/// Les temps sont mesurés en nanosecondes avec SDL_GetTicksNS(). Le temps
+/// mis à l'échelle est accumulé en nanosecondes entières, la partie
+/// fractionnaire de chaque écart étant reportée sur la mise à jour suivante.
 typedef struct Timer
 {
     /// @brief Temps de départ.
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_startTime;
 
     /// @brief Temps du dernier appel à Timer_update().
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_currentTime;
 
     /// @brief Temps de l'avant dernier appel à Timer_update().
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_previousTime;
 
     /// @brief Ecart entre les deux derniers appels à Timer_update().
     /// Ce membre est affecté par le facteur d'échelle.
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_delta;
 
     /// @brief Ecart entre les deux derniers appels à Timer_update().
     /// Ce membre n'est pas affecté par le facteur d'échelle.
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_unscaledDelta;
 
     /// @brief Facteur d'échelle appliqué au temps.
     float m_scale;
 
+    /// @brief Partie fractionnaire du temps mis à l'échelle, reportée sur
+    /// la mise à jour suivante.
+    /// Exprimée en nanosecondes.
+    double m_scaleRemainder;
+
     /// @brief Ecart de temps maximum entre deux appels à Timer_update().
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_maxDelta;
 
     /// @brief Ecart entre le lancement du timer Timer_start()
     /// et le dernier appel à Timer_update().
     /// Ce membre est affecté par le facteur d'échelle.
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_elapsed;
 
     /// @brief Ecart entre le lancement du timer Timer_start()
     /// et le dernier appel à Timer_update().
     /// Ce membre n'est pas affecté par le facteur d'échelle.
-    /// Exprimé en millisecondes.
+    /// Exprimé en nanosecondes.
     Uint64 m_unscaledElapsed;
+
+    /// @brief Durée d'un pas de simulation fixe, ou 0 si le pas fixe est désactivé.
+    /// Exprimée en nanosecondes.
+    Uint64 m_fixedStep;
+
+    /// @brief Temps mis à l'échelle non encore consommé par des pas fixes.
+    /// Exprimé en nanosecondes.
+    Uint64 m_fixedAccumulator;
+
+    /// @brief Nombre de pas fixes à exécuter depuis le dernier appel à Timer_update().
+    int m_fixedStepCount;
+
+    /// @brief Nombre maximal de pas fixes par mise à jour.
+    int m_maxFixedSteps;
 } Timer;
 
 /// @brief Crée un nouveau timer.
@@ -97,7 +119,7 @@ INLINE float Timer_getTimeScale(Timer* self)
 INLINE float Timer_getDelta(Timer* self)
 {
     assert(self && "The Timer must be created");
-    return (float)(self->m_delta) / 1000.f;
+    return (float)((double)self->m_delta * 1e-9);
 }
 
 /// @brief Renvoie l'écart de temps (en millisecondes) entre les deux derniers
@@ -107,7 +129,7 @@ INLINE float Timer_getDelta(Timer* self)
 INLINE Uint64 Timer_getDeltaMS(Timer* self)
 {
     assert(self && "The Timer must be created");
-    return self->m_delta;
+    return self->m_delta / 1000000;
 }
 
 /// @brief Renvoie l'écart de temps (en secondes) entre les deux derniers
@@ -119,7 +141,7 @@ INLINE Uint64 Timer_getDeltaMS(Timer* self)
 INLINE float Timer_getUnscaledDelta(Timer* self)
 {
     assert(self && "The Timer must be created");
-    return (float)(self->m_unscaledDelta) / 1000.f;
+    return (float)((double)self->m_unscaledDelta * 1e-9);
 }
 
 /// @brief Renvoie l'écart de temps (en millisecondes) entre les deux derniers
@@ -131,7 +153,7 @@ INLINE float Timer_getUnscaledDelta(Timer* self)
 INLINE Uint64 Timer_getUnscaledDeltaMS(Timer* self)
 {
     assert(self && "The Timer must be created");
-    return self->m_unscaledDelta;
+    return self->m_unscaledDelta / 1000000;
 }
 
 /// @brief Renvoie l'écart de temps (en secondes) entre le lancement du timer
@@ -141,7 +163,7 @@ INLINE Uint64 Timer_getUnscaledDeltaMS(Timer* self)
 INLINE float Timer_getElapsed(Timer* self)
 {
     assert(self && "The Timer must be created");
-    return (float)(self->m_elapsed) / 1000.f;
+    return (float)((double)self->m_elapsed * 1e-9);
 }
 
 /// @brief Renvoie l'écart de temps (en millisecondes) entre le lancement du timer
@@ -151,7 +173,7 @@ INLINE float Timer_getElapsed(Timer* self)
 INLINE Uint64 Timer_getElapsedMS(Timer* self)
 {
     assert(self && "The Timer must be created");
-    return self->m_elapsed;
+    return self->m_elapsed / 1000000;
 }
 
 /// @brief Renvoie l'écart de temps (en secondes) entre le lancement du timer
@@ -163,7 +185,7 @@ INLINE Uint64 Timer_getElapsedMS(Timer* self)
 INLINE float Timer_getUnscaledElapsed(Timer* self)
 {
     assert(self && "The Timer must be created");
-    return (float)(self->m_unscaledElapsed) / 1000.f;
+    return (float)((double)self->m_unscaledElapsed * 1e-9);
 }
 
 /// @brief Renvoie l'écart de temps (en millisecondes) entre le lancement du timer
@@ -175,5 +197,80 @@ INLINE float Timer_getUnscaledElapsed(Timer* self)
 INLINE Uint64 Timer_getUnscaledElapsedMS(Timer* self)
 {
     assert(self && "The Timer must be created");
-    return self->m_unscaledElapsed;
+    return self->m_unscaledElapsed / 1000000;
+}
+
+/// @brief Renvoie l'écart de temps (en nanosecondes) entre les deux derniers
+/// appels à la fonction Timer_update().
+/// @param self le timer.
+/// @return L'écart de temps entre les deux dernières mises à jour.
+INLINE Uint64 Timer_getDeltaNS(Timer* self)
+{
+    assert(self && "The Timer must be created");
+    return self->m_delta;
+}
+
+/// @brief Renvoie l'écart de temps (en nanosecondes) entre les deux derniers
+/// appels à la fonction Timer_update().
+/// Cette méthode ne tient pas compte de l'échelle de temps du timer.
+/// @param self le timer.
+/// @return L'écart de temps entre les deux dernières mises à jour
+/// (sans échelle de temps).
+INLINE Uint64 Timer_getUnscaledDeltaNS(Timer* self)
+{
+    assert(self && "The Timer must be created");
+    return self->m_unscaledDelta;
+}
+
+/// @brief Renvoie l'écart de temps (en nanosecondes) entre le lancement du timer
+/// avec Timer_start() et le dernier appel à la fonction Timer_update().
+/// @param self le timer.
+/// @return Le nombre de nanosecondes écoulées depuis le lancement du timer et la dernière mise à jour.
+INLINE Uint64 Timer_getElapsedNS(Timer* self)
+{
+    assert(self && "The Timer must be created");
+    return self->m_elapsed;
+}
+
+/// @brief Active un pas de simulation fixe.
+/// A chaque appel à Timer_update(), le temps mis à l'échelle est accumulé et
+/// découpé en pas de durée fixe. La simulation exécute Timer_getFixedStepCount()
+/// pas de Timer_getFixedDelta() secondes, indépendamment de la fréquence de
+/// rendu, puis le rendu interpole entre les deux derniers états avec
+/// Timer_getFixedAlpha().
+/// @param self le timer.
+/// @param step la durée d'un pas en secondes, ou 0 pour désactiver le pas fixe.
+/// @param maxSteps le nombre maximal de pas par mise à jour. Le temps en excès
+/// est abandonné, ce qui évite que la simulation ne prenne un retard croissant.
+void Timer_setFixedStep(Timer* self, double step, int maxSteps);
+
+/// @brief Renvoie le nombre de pas fixes à exécuter depuis le dernier appel
+/// à Timer_update().
+/// @param self le timer.
+/// @return Le nombre de pas fixes.
+INLINE int Timer_getFixedStepCount(Timer* self)
+{
+    assert(self && "The Timer must be created");
+    return self->m_fixedStepCount;
+}
+
+/// @brief Renvoie la durée (en secondes) d'un pas fixe.
+/// @param self le timer.
+/// @return La durée d'un pas fixe.
+INLINE float Timer_getFixedDelta(Timer* self)
+{
+    assert(self && "The Timer must be created");
+    return (float)((double)self->m_fixedStep * 1e-9);
+}
+
+/// @brief Renvoie la fraction de pas fixe écoulée depuis le dernier pas exécuté.
+/// Le rendu interpole l'état de la simulation entre l'avant-dernier et le
+/// dernier pas avec ce coefficient.
+/// @param self le timer.
+/// @return Le coefficient d'interpolation, dans [0, 1[.
+INLINE float Timer_getFixedAlpha(Timer* self)
+{
+    assert(self && "The Timer must be created");
+    if (self->m_fixedStep == 0) return 0.f;
+    return (float)((double)self->m_fixedAccumulator / (double)self->m_fixedStep);
 }
@@ -11,12 +11,19 @@
 
 #include "utils/utils.h"
 #include "utils/colors.h"
+#include "utils/memory_arena.h"
+#include "utils/string_id.h"
 
 #include "core/asset_manager.h"
+#include "core/asset_pack.h"
 #include "core/camera.h"
+#include "core/profiler.h"
+#include "core/render_queue.h"
 #include "core/renderer.h"
 #include "core/sprite_anim.h"
+#include "core/sprite_batch.h"
 #include "core/sprite_sheet.h"
+#include "core/thread_pool.h"
 #include "core/timer.h"
 
 #include "ui/ui_button.h"
@@ -28,6 +35,8 @@
 #include "ui/ui_input.h"
 #include "ui/ui_label.h"
 #include "ui/ui_list.h"
+#include "ui/ui_list_view.h"
 #include "ui/ui_object.h"
 #include "ui/ui_selectable.h"
+#include "ui/ui_spatial_index.h"
 #include "ui/ui_utils.h"
@@ -5,11 +5,30 @@
 */
 
 #include "game_engine_common.h"
+#include "core/asset_pack.h"
+#include "core/profiler.h"
+#include "core/render_queue.h"
+#include "core/sprite_batch.h"
+#include "core/sprite_sheet.h"
+#include "core/thread_pool.h"
+#include "ui/ui_object.h"
+#include "utils/string_id.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define GAME_OBFUSCATION_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define GAME_OBFUSCATION_NEON
+#endif
 
 Timer* g_time = NULL;
 SDL_Renderer* g_renderer = NULL;
 SDL_Window* g_window = NULL;
 TTF_TextEngine* g_textEngine = NULL;
+SpriteBatch* g_spriteBatch = NULL;
+RenderQueue* g_renderQueue = NULL;
+RenderQueue* g_uiCacheQueue = NULL;
 GamePaths g_paths = { 0 };
 bool g_drawUIGizmos = false;
 GameSizes g_sizes = { 0 };
@@ -61,6 +80,11 @@ SDL_AppResult Game_init(const GameInitParams* params)
         return SDL_APP_FAILURE;
     }
 
+    Profiler_init();
+
+    // Les objets de l'interface créés hors d'une page sont alloués dans des pools
+    UIObject_setPoolingEnabled(true);
+
     // Crée le temps global du jeu
     g_time = Timer_create();
     AssertNew(g_time);
@@ -135,6 +159,10 @@ SDL_AppResult Game_createRenderer(int width, int height)
         return SDL_APP_FAILURE;
     }
 
+    g_spriteBatch = SpriteBatch_create(g_renderer);
+    g_renderQueue = RenderQueue_create(g_renderer, g_spriteBatch);
+    g_uiCacheQueue = RenderQueue_create(g_renderer, g_spriteBatch);
+
     return SDL_APP_CONTINUE;
 }
 
@@ -143,6 +171,12 @@ void Game_destroyRenderer()
     if (!g_renderer) return;
     assert(g_textEngine);
 
+    RenderQueue_destroy(g_uiCacheQueue);
+    g_uiCacheQueue = NULL;
+    RenderQueue_destroy(g_renderQueue);
+    g_renderQueue = NULL;
+    SpriteBatch_destroy(g_spriteBatch);
+    g_spriteBatch = NULL;
     TTF_DestroyRendererTextEngine(g_textEngine);
     g_textEngine = NULL;
     SDL_DestroyRenderer(g_renderer);
@@ -165,6 +199,10 @@ void Game_quit()
     Timer_destroy(g_time);
     g_time = NULL;
 
+    StringID_clear();
+    UIObject_destroyPools();
+    Profiler_quit();
+
     TTF_Quit();
     SDL_Quit();
 }
@@ -193,23 +231,58 @@ char* Strdup(const char* src)
     return dst;
 }
 
+#define ASSET_MANIFEST_FILE_NAME ".asset_manifest"
+#define ASSET_MANIFEST_HEADER "# asset manifest v3"
+#define SPRITE_SHEET_DESC_SUFFIX "_desc.json"
+#define ASSET_BUILD_PATH_SIZE 256
+
+/// @brief Etat d'un fichier source enregistré dans le manifeste.
+typedef struct AssetManifestEntry
+{
+    char path[ASSET_BUILD_PATH_SIZE];
+    Uint64 size;
+    SDL_Time modifyTime;
+    Uint64 hash;
+    bool used;
+} AssetManifestEntry;
+
+typedef enum AssetBuildResult
+{
+    ASSET_BUILD_SKIPPED,
+    ASSET_BUILD_REBUILT,
+    ASSET_BUILD_FAILED,
+} AssetBuildResult;
+
+typedef struct AssetBuildJob
+{
+    char srcPath[ASSET_BUILD_PATH_SIZE];
+    char dstPath[ASSET_BUILD_PATH_SIZE];
+    Uint64 size;
+    SDL_Time modifyTime;
+    Uint64 hash;
+
+    /// @brief Hash enregistré lors de la construction précédente, si elle existe.
+    const AssetManifestEntry* previous;
+    AssetBuildResult result;
+
+    struct ObfuscateAssetsContext* context;
+} AssetBuildJob;
+
 typedef struct ObfuscateAssetsContext
 {
     SDL_Storage* srcStorage;
     SDL_Storage* dstStorage;
+
+    /// @brief Fichiers sources trouvés lors du parcours de assets_dev.
+    AssetBuildJob* jobs;
+    int jobCount;
+    int jobCapacity;
 } ObfuscateAssetsContext;
 
-static SDL_EnumerationResult Game_createAssetsFromDevCB(void* userdata, const char* dirname, const char* fname)
+static void Game_makeAssetDatPath(const char* srcPath, char* dstPath, size_t dstSize)
 {
-    ObfuscateAssetsContext* context = (ObfuscateAssetsContext*)userdata;
-    bool success = false;
-    SDL_PathInfo info = { 0 };
-    char srcPath[256] = { 0 };
-    char dstPath[256] = { 0 };
-    SDL_strlcat(srcPath, dirname, sizeof(srcPath));
-    SDL_strlcat(srcPath, fname, sizeof(srcPath));
-    SDL_strlcat(dstPath, dirname, sizeof(dstPath));
-    SDL_strlcat(dstPath, fname, sizeof(dstPath));
+    dstPath[0] = '\0';
+    SDL_strlcat(dstPath, srcPath, dstSize);
     int extIndex = -1;
     for (int i = (int)strlen(dstPath); i >= 0; i--)
     {
@@ -221,64 +294,269 @@ static SDL_EnumerationResult Game_createAssetsFromDevCB(void* userdata, const ch
         }
     }
     if (extIndex != -1) dstPath[extIndex] = '\0';
-    SDL_strlcat(dstPath, ".dat", sizeof(dstPath));
+    SDL_strlcat(dstPath, ".dat", dstSize);
+}
 
-    success = SDL_GetStoragePathInfo(context->srcStorage, srcPath, &info);
-    if (!success)
+/// @brief Hash rapide du contenu d'un fichier, traité par mots de 64 bits.
+static Uint64 Game_hashContent(const void* memory, Uint64 size)
+{
+    const Uint8* data = (const Uint8*)memory;
+    Uint64 hash = 0x9E3779B97F4A7C15ULL ^ size;
+    Uint64 i = 0;
+    for (; i + 8 <= size; i += 8)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to get path info %s", SDL_GetError());
-        return SDL_ENUM_FAILURE;
+        Uint64 word;
+        memcpy(&word, data + i, sizeof(Uint64));
+        hash = (hash ^ (word * 0xBF58476D1CE4E5B9ULL)) * 0x94D049BB133111EBULL;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 0x100000001B3ULL;
     }
+    hash ^= hash >> 32;
+    return hash;
+}
 
-    if (info.type == SDL_PATHTYPE_DIRECTORY)
+/// @brief Ecrit un fichier de manière atomique : les données sont écrites dans
+/// un fichier temporaire qui remplace ensuite le fichier de destination.
+static bool Game_writeStorageFileAtomic(SDL_Storage* storage, const char* path, const void* buffer, Uint64 size)
+{
+    char tmpPath[ASSET_BUILD_PATH_SIZE + 8] = { 0 };
+    SDL_strlcat(tmpPath, path, sizeof(tmpPath));
+    SDL_strlcat(tmpPath, ".tmp", sizeof(tmpPath));
+
+    bool success = SDL_WriteStorageFile(storage, tmpPath, buffer, size);
+    if (success)
     {
-        SDL_LogInfo(SDL_LOG_CATEGORY_SYSTEM, "Found directory: %s\n", srcPath);
-        success = SDL_CreateStorageDirectory(context->dstStorage, srcPath);
+        success = SDL_RenameStoragePath(storage, tmpPath, path);
         if (!success)
         {
-            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to create directory %s", SDL_GetError());
-            return SDL_ENUM_FAILURE;
+            SDL_RemoveStoragePath(storage, tmpPath);
         }
-        SDL_EnumerateStorageDirectory(context->srcStorage, srcPath, Game_createAssetsFromDevCB, (void*)context);
     }
-    else if (info.type == SDL_PATHTYPE_FILE)
+    if (!success)
     {
-        SDL_LogInfo(SDL_LOG_CATEGORY_SYSTEM, "Found file: %s\n", srcPath);
-        Uint64 length = 0;
-        success = SDL_GetStorageFileSize(context->srcStorage, srcPath, &length);
-        if (!success)
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to write file %s %s", path, SDL_GetError());
+    }
+    return success;
+}
+
+/// @brief Compile les descripteurs de sprite sheets au format binaire.
+/// Les autres fichiers sont conservés tels quels.
+static void Game_compileAsset(const char* srcPath, void** buffer, Uint64* length)
+{
+    size_t pathLength = strlen(srcPath);
+    size_t suffixLength = strlen(SPRITE_SHEET_DESC_SUFFIX);
+    if (pathLength < suffixLength) return;
+    if (SDL_strcasecmp(srcPath + pathLength - suffixLength, SPRITE_SHEET_DESC_SUFFIX) != 0) return;
+
+    void* compiled = NULL;
+    Uint64 compiledSize = 0;
+    if (SpriteSheet_compileDesc((const char*)(*buffer), *length, &compiled, &compiledSize) == false)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_SYSTEM, "Unable to compile %s, the JSON is kept", srcPath);
+        return;
+    }
+    SDL_free(*buffer);
+    *buffer = compiled;
+    *length = compiledSize;
+}
+
+static void Game_addAssetBuildJob(ObfuscateAssetsContext* context, const char* srcPath, const SDL_PathInfo* info)
+{
+    if (context->jobCount >= context->jobCapacity)
+    {
+        int newCapacity = (context->jobCapacity > 0) ? 2 * context->jobCapacity : 64;
+        AssetBuildJob* newJobs = (AssetBuildJob*)realloc(context->jobs, newCapacity * sizeof(AssetBuildJob));
+        AssertNew(newJobs);
+        context->jobs = newJobs;
+        context->jobCapacity = newCapacity;
+    }
+
+    AssetBuildJob* job = &(context->jobs[context->jobCount++]);
+    memset(job, 0, sizeof(AssetBuildJob));
+    SDL_strlcat(job->srcPath, srcPath, sizeof(job->srcPath));
+    Game_makeAssetDatPath(srcPath, job->dstPath, sizeof(job->dstPath));
+    job->size = info->size;
+    job->modifyTime = info->modify_time;
+    job->context = context;
+}
+
+static void Game_buildAssetJob(void* userData)
+{
+    AssetBuildJob* job = (AssetBuildJob*)userData;
+    ObfuscateAssetsContext* context = job->context;
+    job->result = ASSET_BUILD_FAILED;
+
+    void* buffer = SDL_malloc((size_t)job->size);
+    AssertNew(buffer);
+    bool success = SDL_ReadStorageFile(context->srcStorage, job->srcPath, buffer, job->size);
+    if (!success)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to read file %s %s", job->srcPath, SDL_GetError());
+        SDL_free(buffer);
+        return;
+    }
+
+    // Seule la date a changé : le fichier de sortie est conservé
+    job->hash = Game_hashContent(buffer, job->size);
+    if (job->previous && job->previous->hash == job->hash)
+    {
+        SDL_PathInfo info = { 0 };
+        if (SDL_GetStoragePathInfo(context->dstStorage, job->dstPath, &info))
         {
-            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to get file size %s", SDL_GetError());
-            return SDL_ENUM_FAILURE;
+            SDL_free(buffer);
+            job->result = ASSET_BUILD_SKIPPED;
+            return;
         }
+    }
 
-        void* buffer = SDL_malloc(length);
-        success = SDL_ReadStorageFile(context->srcStorage, srcPath, buffer, length);
-        if (!success)
+    Uint64 length = job->size;
+    Game_compileAsset(job->srcPath, &buffer, &length);
+
+    Uint64 obfuscatedSize = Game_getObfuscatedSizeV2(length);
+    void* obfuscated = SDL_malloc((size_t)obfuscatedSize);
+    AssertNew(obfuscated);
+    Game_obfuscateMemV2(obfuscated, buffer, length, AssetPack_hashName(job->dstPath));
+    SDL_free(buffer);
+
+    success = Game_writeStorageFileAtomic(context->dstStorage, job->dstPath, obfuscated, obfuscatedSize);
+    SDL_free(obfuscated);
+
+    job->result = success ? ASSET_BUILD_REBUILT : ASSET_BUILD_FAILED;
+}
+
+static int Game_compareManifestEntries(const void* a, const void* b)
+{
+    return strcmp(((const AssetManifestEntry*)a)->path, ((const AssetManifestEntry*)b)->path);
+}
+
+static AssetManifestEntry* Game_loadAssetManifest(SDL_Storage* storage, int* outCount)
+{
+    *outCount = 0;
+    Uint64 fileSize = 0;
+    if (!SDL_GetStorageFileSize(storage, ASSET_MANIFEST_FILE_NAME, &fileSize)) return NULL;
+
+    char* text = (char*)SDL_malloc((size_t)fileSize + 1);
+    AssertNew(text);
+    if (!SDL_ReadStorageFile(storage, ASSET_MANIFEST_FILE_NAME, text, fileSize))
+    {
+        SDL_free(text);
+        return NULL;
+    }
+    text[fileSize] = '\0';
+
+    // Un manifeste d'une autre version impose de tout reconstruire
+    if (SDL_strncmp(text, ASSET_MANIFEST_HEADER "\n", strlen(ASSET_MANIFEST_HEADER) + 1) != 0)
+    {
+        SDL_free(text);
+        return NULL;
+    }
+
+    int capacity = 1;
+    for (Uint64 i = 0; i < fileSize; i++)
+    {
+        if (text[i] == '\n') capacity++;
+    }
+    AssetManifestEntry* entries = (AssetManifestEntry*)calloc(capacity, sizeof(AssetManifestEntry));
+    AssertNew(entries);
+
+    // Format d'une ligne : chemin\ttaille\tdate\thash
+    int count = 0;
+    char* line = text;
+    while (line && *line)
+    {
+        char* next = strchr(line, '\n');
+        if (next) *next++ = '\0';
+
+        char* tab = strchr(line, '\t');
+        if (line[0] != '#' && tab && tab - line < ASSET_BUILD_PATH_SIZE)
         {
-            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to read file %s", SDL_GetError());
-            SDL_free(buffer);
-            return SDL_ENUM_FAILURE;
+            AssetManifestEntry* entry = &(entries[count]);
+            *tab = '\0';
+            SDL_strlcpy(entry->path, line, sizeof(entry->path));
+            unsigned long long size = 0, hash = 0;
+            long long modifyTime = 0;
+            if (SDL_sscanf(tab + 1, "%llu\t%lld\t%llx", &size, &modifyTime, &hash) == 3)
+            {
+                entry->size = size;
+                entry->modifyTime = modifyTime;
+                entry->hash = hash;
+                count++;
+            }
         }
+        line = next;
+    }
+    SDL_free(text);
+
+    SDL_qsort(entries, count, sizeof(AssetManifestEntry), Game_compareManifestEntries);
+    *outCount = count;
+    return entries;
+}
 
-        Game_obfuscateMem(buffer, length);
-        success = SDL_WriteStorageFile(context->dstStorage, dstPath, buffer, length);
+static bool Game_saveAssetManifest(SDL_Storage* storage, const AssetBuildJob* jobs, int jobCount)
+{
+    size_t capacity = 64 + (size_t)jobCount * (ASSET_BUILD_PATH_SIZE + 64);
+    char* text = (char*)SDL_malloc(capacity);
+    AssertNew(text);
+
+    size_t length = (size_t)SDL_snprintf(text, capacity, "%s\n", ASSET_MANIFEST_HEADER);
+    for (int i = 0; i < jobCount; i++)
+    {
+        const AssetBuildJob* job = &(jobs[i]);
+        if (job->result == ASSET_BUILD_FAILED) continue;
+
+        length += (size_t)SDL_snprintf(
+            text + length, capacity - length, "%s\t%llu\t%lld\t%016llx\n",
+            job->srcPath, (unsigned long long)job->size,
+            (long long)job->modifyTime, (unsigned long long)job->hash
+        );
+    }
+
+    bool success = Game_writeStorageFileAtomic(storage, ASSET_MANIFEST_FILE_NAME, text, length);
+    SDL_free(text);
+    return success;
+}
+
+static SDL_EnumerationResult Game_createAssetsFromDevCB(void* userdata, const char* dirname, const char* fname)
+{
+    ObfuscateAssetsContext* context = (ObfuscateAssetsContext*)userdata;
+    bool success = false;
+    SDL_PathInfo info = { 0 };
+    char srcPath[ASSET_BUILD_PATH_SIZE] = { 0 };
+    SDL_strlcat(srcPath, dirname, sizeof(srcPath));
+    SDL_strlcat(srcPath, fname, sizeof(srcPath));
+
+    success = SDL_GetStoragePathInfo(context->srcStorage, srcPath, &info);
+    if (!success)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to get path info %s", SDL_GetError());
+        return SDL_ENUM_FAILURE;
+    }
+
+    if (info.type == SDL_PATHTYPE_DIRECTORY)
+    {
+        success = SDL_CreateStorageDirectory(context->dstStorage, srcPath);
         if (!success)
         {
-            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to write file %s", SDL_GetError());
-            SDL_free(buffer);
+            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to create directory %s", SDL_GetError());
             return SDL_ENUM_FAILURE;
         }
-        SDL_free(buffer);
-        buffer = NULL;
+        SDL_EnumerateStorageDirectory(context->srcStorage, srcPath, Game_createAssetsFromDevCB, (void*)context);
+    }
+    else if (info.type == SDL_PATHTYPE_FILE)
+    {
+        // Les fichiers sont construits après le parcours, en parallèle
+        Game_addAssetBuildJob(context, srcPath, &info);
     }
 
     return SDL_ENUM_CONTINUE;
 }
 
-void Game_createAssetsFromDev()
+int Game_createAssetsFromDev()
 {
-    SDL_LogInfo(SDL_LOG_CATEGORY_SYSTEM, "Create assets from dev folder...\n");
+    Uint64 startTime = SDL_GetTicksNS();
     ObfuscateAssetsContext context = { 0 };
     char srcAssetsPath[256] = { 0 };
     char dstAssetsPath[256] = { 0 };
@@ -292,11 +570,195 @@ void Game_createAssetsFromDev()
     {
         SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to open storage %s\n", SDL_GetError());
         assert(false);
-        return;
+        return 0;
     }
     SDL_EnumerateStorageDirectory(context.srcStorage, NULL, Game_createAssetsFromDevCB, (void*)&context);
+
+    int manifestCount = 0;
+    AssetManifestEntry* manifest = Game_loadAssetManifest(context.dstStorage, &manifestCount);
+
+    // Seuls les fichiers dont la taille ou la date a changé sont relus
+    ThreadPool* threadPool = NULL;
+    for (int i = 0; i < context.jobCount; i++)
+    {
+        AssetBuildJob* job = &(context.jobs[i]);
+        AssetManifestEntry key = { 0 };
+        SDL_strlcpy(key.path, job->srcPath, sizeof(key.path));
+        AssetManifestEntry* entry = manifest ? (AssetManifestEntry*)SDL_bsearch(
+            &key, manifest, manifestCount, sizeof(AssetManifestEntry), Game_compareManifestEntries
+        ) : NULL;
+
+        if (entry)
+        {
+            entry->used = true;
+            job->previous = entry;
+
+            SDL_PathInfo info = { 0 };
+            if (entry->size == job->size && entry->modifyTime == job->modifyTime &&
+                SDL_GetStoragePathInfo(context.dstStorage, job->dstPath, &info))
+            {
+                job->hash = entry->hash;
+                job->result = ASSET_BUILD_SKIPPED;
+                continue;
+            }
+        }
+
+        if (threadPool == NULL)
+        {
+            threadPool = ThreadPool_create(0);
+        }
+        ThreadPool_submit(threadPool, Game_buildAssetJob, job);
+    }
+    if (threadPool)
+    {
+        ThreadPool_wait(threadPool);
+        ThreadPool_destroy(threadPool);
+    }
+    const bool someJobsRan = (threadPool != NULL);
+
+    // Supprime les fichiers dont la source n'existe plus
+    int removedCount = 0;
+    for (int i = 0; i < manifestCount; i++)
+    {
+        if (manifest[i].used) continue;
+
+        char dstPath[ASSET_BUILD_PATH_SIZE] = { 0 };
+        Game_makeAssetDatPath(manifest[i].path, dstPath, sizeof(dstPath));
+        SDL_RemoveStoragePath(context.dstStorage, dstPath);
+        removedCount++;
+    }
+
+    int skippedCount = 0, rebuiltCount = 0, failedCount = 0;
+    for (int i = 0; i < context.jobCount; i++)
+    {
+        switch (context.jobs[i].result)
+        {
+        case ASSET_BUILD_SKIPPED: skippedCount++; break;
+        case ASSET_BUILD_REBUILT: rebuiltCount++; break;
+        default: failedCount++; break;
+        }
+    }
+
+    // Le manifeste change dès qu'un fichier a été relu
+    bool manifestChanged = someJobsRan || (removedCount > 0) || (manifest == NULL);
+    if (manifestChanged)
+    {
+        Game_saveAssetManifest(context.dstStorage, context.jobs, context.jobCount);
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_SYSTEM,
+        "Assets from dev: %d skipped, %d rebuilt, %d removed, %d failed in %.1f ms\n",
+        skippedCount, rebuiltCount, removedCount, failedCount,
+        (double)(SDL_GetTicksNS() - startTime) / 1000000.0
+    );
+    assert(failedCount == 0);
+
+    free(manifest);
+    free(context.jobs);
     SDL_CloseStorage(context.srcStorage);
     SDL_CloseStorage(context.dstStorage);
+
+    return rebuiltCount + removedCount;
+}
+
+/// @brief Hash de l'ensemble des sources enregistrées dans le manifeste,
+/// trié par chemin.
+static Uint64 Game_hashAssetManifest(const AssetManifestEntry* entries, int count)
+{
+    // Un changement de format d'obfuscation reconstruit aussi le pack
+    Uint64 hash = 0x9E3779B97F4A7C15ULL ^ (Uint64)count ^ ((Uint64)GAME_OBFUSCATION_VERSION << 48);
+    for (int i = 0; i < count; i++)
+    {
+        Uint64 word = entries[i].hash ^ AssetPack_hashName(entries[i].path);
+        hash = (hash ^ (word * 0xBF58476D1CE4E5B9ULL)) * 0x94D049BB133111EBULL;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+void Game_createAssetPackFromDev(bool force)
+{
+    char packPath[256] = { 0 };
+    SDL_strlcat(packPath, g_paths.assets, sizeof(packPath));
+    SDL_strlcat(packPath, "/" ASSET_PACK_FILE_NAME, sizeof(packPath));
+
+    SDL_Storage* storage = SDL_OpenFileStorage(g_paths.assets);
+    if (storage == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to open storage %s\n", SDL_GetError());
+        assert(false);
+        return;
+    }
+
+    // Le pack regroupe les fichiers .dat construits par Game_createAssetsFromDev()
+    int manifestCount = 0;
+    AssetManifestEntry* manifest = Game_loadAssetManifest(storage, &manifestCount);
+    if (manifest == NULL)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to create asset pack, the asset manifest is missing\n");
+        SDL_CloseStorage(storage);
+        return;
+    }
+
+    // Le pack existant est conservé s'il est valide et construit à partir
+    // des mêmes sources que celles du manifeste
+    const Uint64 contentHash = Game_hashAssetManifest(manifest, manifestCount);
+    if (!force)
+    {
+        AssetPack* pack = AssetPack_open(packPath);
+        bool isUpToDate = pack && (AssetPack_getContentHash(pack) == contentHash);
+        AssetPack_close(pack);
+        if (isUpToDate)
+        {
+            free(manifest);
+            SDL_CloseStorage(storage);
+            return;
+        }
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_SYSTEM, "Create asset pack from dev folder...\n");
+    AssetPackWriter* packWriter = AssetPackWriter_create();
+    AssetPackWriter_setContentHash(packWriter, contentHash);
+    bool success = true;
+    for (int i = 0; i < manifestCount && success; i++)
+    {
+        char datPath[ASSET_BUILD_PATH_SIZE] = { 0 };
+        Game_makeAssetDatPath(manifest[i].path, datPath, sizeof(datPath));
+
+        Uint64 size = 0;
+        void* buffer = NULL;
+        success = SDL_GetStorageFileSize(storage, datPath, &size);
+        if (success)
+        {
+            buffer = SDL_malloc((size_t)size);
+            AssertNew(buffer);
+            success = SDL_ReadStorageFile(storage, datPath, buffer, size);
+        }
+        if (!success)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to read file %s %s", datPath, SDL_GetError());
+            SDL_free(buffer);
+            break;
+        }
+
+        // Les entrées restent obfusquées comme les fichiers .dat :
+        // l'AssetManager les copie puis les décode lors du chargement
+        success = AssetPackWriter_addFile(packWriter, datPath, buffer, size, ASSET_PACK_FLAG_OBFUSCATED);
+    }
+    if (success)
+    {
+        success = AssetPackWriter_save(packWriter, packPath);
+    }
+    if (!success)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Unable to create asset pack %s\n", packPath);
+        assert(false);
+    }
+
+    AssetPackWriter_destroy(packWriter);
+    free(manifest);
+    SDL_CloseStorage(storage);
 }
 
 void Game_updateSizes()
@@ -304,6 +766,12 @@ void Game_updateSizes()
     SDL_Rect viewport = { 0 };
     SDL_GetRenderViewport(g_renderer, &viewport);
 
+    if ((g_sizes.viewportSize.x != (float)viewport.w) ||
+        (g_sizes.viewportSize.y != (float)viewport.h))
+    {
+        g_sizes.revision++;
+    }
+
     g_sizes.uiPixelsPerUnit = Vec2_set(
         viewport.w / g_sizes.uiSize.x,
         viewport.h / g_sizes.uiSize.y
@@ -339,3 +807,149 @@ void Game_retriveMem(void* memory, Uint64 size)
     buffer[0] = 0x73 * (buffer[0] + 0x37);
     buffer[0] ^= 0x73;
 }
+
+static Uint64 Game_splitMix64(Uint64 x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+#define GAME_OBFUSCATION_KEY_WORDS 8
+#define GAME_OBFUSCATION_CHUNK_SIZE (GAME_OBFUSCATION_KEY_WORDS * sizeof(Uint64))
+
+/// @brief Calcule la clé d'un segment de 64 octets.
+/// Chaque mot du flux de clé est dérivé de la graine et de sa position dans
+/// les données : le flux ne se répète pas d'un segment ou d'un bloc à l'autre.
+static void Game_makeChunkKeyV2(Uint64 base, Uint64 chunkIndex, Uint64 key[GAME_OBFUSCATION_KEY_WORDS])
+{
+    const Uint64 firstWord = chunkIndex * GAME_OBFUSCATION_KEY_WORDS;
+    for (int i = 0; i < GAME_OBFUSCATION_KEY_WORDS; i++)
+    {
+        key[i] = Game_splitMix64(base + (firstWord + i) * 0x9E3779B97F4A7C15ULL);
+    }
+}
+
+/// @brief Combine par XOR une plage de données avec le flux de clé.
+/// @param data les données, commençant au segment firstChunk.
+/// @param size la taille de la plage.
+/// @param base l'état initial dérivé de la graine.
+/// @param firstChunk l'indice dans les données du premier segment de la plage.
+static void Game_xorChunksV2(Uint8* data, Uint64 size, Uint64 base, Uint64 firstChunk)
+{
+    const Uint64 chunkSize = GAME_OBFUSCATION_CHUNK_SIZE;
+    Uint64 key[GAME_OBFUSCATION_KEY_WORDS] = { 0 };
+    Uint64 chunk = firstChunk;
+    Uint64 i = 0;
+
+    for (; i + chunkSize <= size; i += chunkSize, chunk++)
+    {
+        Game_makeChunkKeyV2(base, chunk, key);
+
+#if defined(GAME_OBFUSCATION_SSE2)
+        const Uint8* keyBytes = (const Uint8*)key;
+        __m128i* p = (__m128i*)(data + i);
+        _mm_storeu_si128(p + 0, _mm_xor_si128(_mm_loadu_si128(p + 0), _mm_loadu_si128((const __m128i*)(keyBytes + 0))));
+        _mm_storeu_si128(p + 1, _mm_xor_si128(_mm_loadu_si128(p + 1), _mm_loadu_si128((const __m128i*)(keyBytes + 16))));
+        _mm_storeu_si128(p + 2, _mm_xor_si128(_mm_loadu_si128(p + 2), _mm_loadu_si128((const __m128i*)(keyBytes + 32))));
+        _mm_storeu_si128(p + 3, _mm_xor_si128(_mm_loadu_si128(p + 3), _mm_loadu_si128((const __m128i*)(keyBytes + 48))));
+#elif defined(GAME_OBFUSCATION_NEON)
+        const Uint8* keyBytes = (const Uint8*)key;
+        Uint8* p = data + i;
+        vst1q_u8(p + 0, veorq_u8(vld1q_u8(p + 0), vld1q_u8(keyBytes + 0)));
+        vst1q_u8(p + 16, veorq_u8(vld1q_u8(p + 16), vld1q_u8(keyBytes + 16)));
+        vst1q_u8(p + 32, veorq_u8(vld1q_u8(p + 32), vld1q_u8(keyBytes + 32)));
+        vst1q_u8(p + 48, veorq_u8(vld1q_u8(p + 48), vld1q_u8(keyBytes + 48)));
+#else
+        for (int j = 0; j < GAME_OBFUSCATION_KEY_WORDS; j++)
+        {
+            Uint64 word;
+            memcpy(&word, data + i + 8 * j, sizeof(Uint64));
+            word ^= key[j];
+            memcpy(data + i + 8 * j, &word, sizeof(Uint64));
+        }
+#endif
+    }
+
+    // Dernier segment incomplet
+    if (i < size)
+    {
+        Game_makeChunkKeyV2(base, chunk, key);
+        const Uint8* keyBytes = (const Uint8*)key;
+        for (Uint64 j = 0; i + j < size; j++)
+        {
+            data[i + j] ^= keyBytes[j];
+        }
+    }
+}
+
+void Game_retriveBlocksV2(
+    void* payload, Uint64 size, const GameObfuscationHeader* header,
+    Uint64 firstBlock, Uint64 blockCount)
+{
+    assert(header && header->blockSize > 0);
+    assert(header->blockSize % GAME_OBFUSCATION_CHUNK_SIZE == 0);
+    Uint8* data = (Uint8*)payload;
+    const Uint64 blockSize = header->blockSize;
+    const Uint64 chunksPerBlock = blockSize / GAME_OBFUSCATION_CHUNK_SIZE;
+    const Uint64 base = Game_splitMix64(header->seed);
+
+    for (Uint64 block = firstBlock; block < firstBlock + blockCount; block++)
+    {
+        Uint64 offset = block * blockSize;
+        if (offset >= size) break;
+
+        Uint64 length = (size - offset < blockSize) ? size - offset : blockSize;
+        Game_xorChunksV2(data + offset, length, base, block * chunksPerBlock);
+    }
+}
+
+void Game_obfuscateMemV2(void* dst, const void* src, Uint64 size, Uint64 salt)
+{
+    GameObfuscationHeader header = { 0 };
+    header.magic = GAME_OBFUSCATION_MAGIC;
+    header.version = GAME_OBFUSCATION_VERSION;
+    header.blockSize = GAME_OBFUSCATION_BLOCK_SIZE;
+    header.seed = (Uint32)Game_splitMix64(size ^ Game_splitMix64(salt));
+
+    Uint8* payload = (Uint8*)dst + sizeof(GameObfuscationHeader);
+    memcpy(dst, &header, sizeof(GameObfuscationHeader));
+    memcpy(payload, src, (size_t)size);
+
+    // Le XOR par le flux de clé est sa propre réciproque
+    Uint64 blockCount = (size + header.blockSize - 1) / header.blockSize;
+    Game_retriveBlocksV2(payload, size, &header, 0, blockCount);
+}
+
+void Game_retriveAnyMem(void* memory, Uint64 size, Uint64* outOffset, Uint64* outSize)
+{
+    assert(outOffset && outSize);
+    GameObfuscationHeader header = { 0 };
+    if (size >= sizeof(GameObfuscationHeader))
+    {
+        memcpy(&header, memory, sizeof(GameObfuscationHeader));
+    }
+
+    if (header.magic == GAME_OBFUSCATION_MAGIC &&
+        header.version == GAME_OBFUSCATION_VERSION &&
+        header.blockSize > 0 && header.blockSize % GAME_OBFUSCATION_CHUNK_SIZE == 0)
+    {
+        Uint8* payload = (Uint8*)memory + sizeof(GameObfuscationHeader);
+        Uint64 payloadSize = size - sizeof(GameObfuscationHeader);
+        Uint64 blockCount = (payloadSize + header.blockSize - 1) / header.blockSize;
+        Game_retriveBlocksV2(payload, payloadSize, &header, 0, blockCount);
+
+        *outOffset = sizeof(GameObfuscationHeader);
+        *outSize = payloadSize;
+        return;
+    }
+
+    // Ancien format sans en-tête
+    if (size > 0)
+    {
+        Game_retriveMem(memory, size);
+    }
+    *outOffset = 0;
+    *outSize = size;
+}
@@ -13,6 +13,8 @@
 
 #define MIX_CHANNEL_COUNT 16
 typedef struct AssetManager AssetManager;
+typedef struct SpriteBatch SpriteBatch;
+typedef struct RenderQueue RenderQueue;
 typedef struct GamePaths
 {
     char* base;
@@ -27,6 +29,8 @@ typedef struct GameSizes
     Vec2 viewportSize;
     float mainRenderScale;
     float defaultRenderWidth;
+    /// @brief Incrémenté à chaque changement de la taille du viewport.
+    int revision;
 } GameSizes;
 
 /// @brief Temps global du jeu.
@@ -41,6 +45,15 @@ extern SDL_Renderer* g_renderer;
 /// @brief Moteur de rendu des textes.
 extern TTF_TextEngine* g_textEngine;
 
+/// @brief Batch de sprites associé au moteur de rendu.
+extern SpriteBatch* g_spriteBatch;
+
+/// @brief File de commandes de rendu associée au moteur de rendu.
+extern RenderQueue* g_renderQueue;
+
+/// @brief File de commandes utilisée pour remplir les textures de cache de l'interface.
+extern RenderQueue* g_uiCacheQueue;
+
 /// @brief Chemins de stockage des ressources du jeu.
 extern GamePaths g_paths;
 
@@ -87,12 +100,81 @@ void Game_quit();
 /// @param alpha l'opacité (0 pour transparant, 255 pour opaque).
 void Game_setRenderDrawColor(SDL_Color color, Uint8 alpha);
 
-void Game_createAssetsFromDev();
+/// @brief Construit les fichiers .dat du dossier des assets à partir du
+/// dossier assets_dev. La construction est incrémentale : un manifeste
+/// enregistre la taille, la date et le hash de chaque source, et seuls les
+/// fichiers modifiés sont reconstruits, en parallèle.
+/// @return Le nombre de fichiers reconstruits ou supprimés.
+int Game_createAssetsFromDev();
+
+/// @brief Regroupe les fichiers .dat listés dans le manifeste dans un pack
+/// unique indexé (ASSET_PACK_FILE_NAME) placé dans le dossier des assets.
+/// Les entrées restent obfusquées. Le pack est utilisé en priorité par
+/// l'AssetManager. Doit être appelée après Game_createAssetsFromDev().
+/// Le pack n'est reconstruit que s'il est absent, invalide ou construit à
+/// partir de sources différentes de celles du manifeste.
+/// @param force reconstruit le pack même s'il est à jour.
+void Game_createAssetPackFromDev(bool force);
 
 void Game_updateSizes();
 
 void Memcpy(void* const dst, size_t dstSize, const void* src, size_t srcSize);
 char* Strdup(const char* src);
 
+/// @brief Obfuscation v1 : chaîne séquentielle octet par octet, sans en-tête.
+/// Conservée pour lire les anciens fichiers .dat.
 void Game_obfuscateMem(void* memory, Uint64 size);
 void Game_retriveMem(void* memory, Uint64 size);
+
+#define GAME_OBFUSCATION_MAGIC 0x32424F47 // "GOB2"
+#define GAME_OBFUSCATION_VERSION 3
+#define GAME_OBFUSCATION_BLOCK_SIZE (64 * 1024)
+
+/// @brief En-tête des données obfusquées au format v2.
+/// Les données sont combinées par XOR à un flux de clé dont chaque segment de
+/// 64 octets dépend de la graine et de l'indice du segment. Les blocs de
+/// GAME_OBFUSCATION_BLOCK_SIZE octets se décodent indépendamment, avec des
+/// instructions SIMD et sur plusieurs threads.
+typedef struct GameObfuscationHeader
+{
+    Uint32 magic;
+    Uint32 version;
+    Uint32 blockSize;
+    Uint32 seed;
+} GameObfuscationHeader;
+
+/// @brief Renvoie la taille des données obfusquées au format v2.
+/// @param size la taille des données d'origine.
+/// @return La taille en octets, en-tête compris.
+INLINE Uint64 Game_getObfuscatedSizeV2(Uint64 size)
+{
+    return size + sizeof(GameObfuscationHeader);
+}
+
+/// @brief Obfusque des données au format v2.
+/// La graine dépend de la taille et d'un sel, le hash du chemin de l'asset par
+/// exemple, pour que deux assets de même taille n'aient pas le même flux de clé.
+/// @param dst le buffer de destination de taille Game_getObfuscatedSizeV2(size).
+/// @param src les données d'origine.
+/// @param size la taille des données d'origine.
+/// @param salt le sel de la graine.
+void Game_obfuscateMemV2(void* dst, const void* src, Uint64 size, Uint64 salt);
+
+/// @brief Décode une partie des blocs d'un buffer au format v2, en place.
+/// Plusieurs threads peuvent décoder simultanément des plages disjointes.
+/// @param payload les données qui suivent l'en-tête.
+/// @param size la taille des données qui suivent l'en-tête.
+/// @param header l'en-tête.
+/// @param firstBlock l'indice du premier bloc à décoder.
+/// @param blockCount le nombre de blocs à décoder.
+void Game_retriveBlocksV2(
+    void* payload, Uint64 size, const GameObfuscationHeader* header,
+    Uint64 firstBlock, Uint64 blockCount);
+
+/// @brief Décode en place des données obfusquées au format v1 ou v2.
+/// Le format est détecté à partir de l'en-tête.
+/// @param memory les données lues depuis le fichier.
+/// @param size la taille des données lues.
+/// @param outOffset position du début des données décodées dans memory.
+/// @param outSize taille des données décodées.
+void Game_retriveAnyMem(void* memory, Uint64 size, Uint64* outOffset, Uint64* outSize);
@@ -9,8 +9,7 @@
 
 UIButton* UIButton_create(const char* objectName, TTF_Font* font)
 {
-    UIButton* self = (UIButton*)calloc(1, sizeof(UIButton));
-    AssertNew(self);
+    UIButton* self = (UIButton*)UIObject_allocNode(sizeof(UIButton));
 
     UIButton_init(self, objectName, font);
 
@@ -54,7 +53,8 @@ void UIButton_init(void* self, const char* objectName, TTF_Font* font)
     defaultBackColors[UI_BUTTON_STATE_DISABLED] = (SDL_Color){ 20, 20, 20, 255 };
 
     // Initialize text contents and colors
-    selfButton->m_labelString = SDL_strdup(defaultText);
+    selfButton->m_labelString = UIObject_strdup(self, defaultText);
+    UITextCache_init(&selfButton->m_labelCache);
     for (int i = 0; i < UI_BUTTON_STATE_COUNT; ++i)
     {
         selfButton->m_labelColors[i] = defaultTextColors[i];
@@ -66,6 +66,7 @@ void UIButton_init(void* self, const char* objectName, TTF_Font* font)
     selfObj->m_onDestroy = UIButtonVM_onDestroy;
     selfObj->m_onRender = UIButtonVM_onRender;
     selfObj->m_onUpdate = UIButtonVM_onUpdate;
+    selfObj->m_onGetMemory = UIButtonVM_onGetMemory;
     selfSelectable->m_onFocusChanged = UIButtonVM_onFocusChanged;
     selfSelectable->m_onFocus = UIButtonVM_onFocus;
     selfButton->m_onClick = UIButtonVM_onClick;
@@ -74,12 +75,17 @@ void UIButton_init(void* self, const char* objectName, TTF_Font* font)
 void UIButtonVM_onDestroy(void* self)
 {
     UIButton* selfButton = (UIButton*)self;
-    SDL_free(selfButton->m_labelString);
+    UIObject_freeMemory(self, selfButton->m_labelString);
     TTF_DestroyText(selfButton->m_labelText);
 
     UISelectableVM_onDestroy(self);
 }
 
+size_t UIButtonVM_onGetMemory(void* self)
+{
+    return UIUtils_getTextMemory(((UIButton*)self)->m_labelText);
+}
+
 static void UIButton_updateButtonState(void* self)
 {
     UIFocusState selectableState = ((UISelectable*)self)->m_focusState;
@@ -134,16 +140,23 @@ static void UIButton_updateButtonState(void* self)
 
 void UIButtonVM_onUpdate(void* self)
 {
-    UISelectableVM_onUpdate(self);
-    UIButton_updateButtonState(self);
-
     UIObject* selfObj = (UIObject*)self;
     UIButton* selfButton = (UIButton*)self;
+    const bool isLayoutDirty = selfObj->m_transform.isDirty;
 
-    UITransform_updateAABB(
-        &selfButton->m_symbolTransform,
-        &selfObj->m_transform
-    );
+    UISelectableVM_onUpdate(self);
+
+    const UIButtonState prevState = selfButton->m_buttonState;
+    UIButton_updateButtonState(self);
+    if (selfButton->m_buttonState != prevState)
+    {
+        UIObject_invalidateVisual(self);
+    }
+
+    if (isLayoutDirty)
+    {
+        UITransform_updateAABB(&selfButton->m_symbolTransform, &selfObj->m_transform);
+    }
 }
 
 void UIButtonVM_onRender(void* self)
@@ -151,15 +164,13 @@ void UIButtonVM_onRender(void* self)
     UIObject* selfObj = (UIObject*)self;
     UISelectable* selfSelectable = (UISelectable*)self;
     UIButton* selfButton = (UIButton*)self;
-    bool success = true;
 
     UIButtonState state = selfButton->m_buttonState;
     TTF_Text* ttfText = selfButton->m_labelText;
 
     // Update text
     SDL_Color textColor = selfButton->m_labelColors[state];
-    success = TTF_SetTextString(ttfText, selfButton->m_labelString, strlen(selfButton->m_labelString));
-    assert(success);
+    UIUtils_updateText(ttfText, selfButton->m_labelString, &selfButton->m_labelCache);
 
     SDL_FRect viewportRect = { 0 };
     UIObject_getViewportRect(selfObj, &viewportRect);
@@ -169,7 +180,9 @@ void UIButtonVM_onRender(void* self)
         selfButton->m_spriteIndices[state],
         selfButton->m_backColors[state],
         selfButton->m_useColorMod,
-        &viewportRect
+        1.f,
+        &viewportRect,
+        &selfButton->m_spriteGeometry
     );
 
     if (selfButton->m_symbolGroup && selfButton->m_symbolSpriteIndex >= 0)
@@ -181,11 +194,15 @@ void UIButtonVM_onRender(void* self)
             selfButton->m_symbolSpriteIndex,
             textColor,
             selfButton->m_useColorMod,
-            &symbolRect
+            1.f,
+            &symbolRect,
+            &selfButton->m_symbolGeometry
         );
     }
 
-    UIUtils_renderText(ttfText, &viewportRect, selfButton->m_labelAnchor, &textColor);
+    UIUtils_renderText(
+        ttfText, &viewportRect, selfButton->m_labelAnchor, &textColor, &selfButton->m_labelCache
+    );
 }
 
 void UIButton_setLabelString(void* self, const char* text)
@@ -195,8 +212,11 @@ void UIButton_setLabelString(void* self, const char* text)
     UIButton* selfButton = (UIButton*)self;
 
     assert(selfButton->m_labelString && "Existing text string must not be NULL");
-    SDL_free(selfButton->m_labelString);
-    selfButton->m_labelString = SDL_strdup(text);
+    if (SDL_strcmp(selfButton->m_labelString, text) == 0) return;
+    UIObject_freeMemory(self, selfButton->m_labelString);
+    selfButton->m_labelString = UIObject_strdup(self, text);
+    UITextCache_invalidate(&selfButton->m_labelCache);
+    UIObject_invalidateVisual(self);
 }
 
 void UIButtonVM_onClick(void* self)
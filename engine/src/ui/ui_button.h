@@ -13,6 +13,7 @@
 
 void UIButtonVM_onRender(void* self);
 void UIButtonVM_onDestroy(void* self);
+size_t UIButtonVM_onGetMemory(void* self);
 void UIButtonVM_onUpdate(void* self);
 void UIButtonVM_onClick(void* self);
 void UIButtonVM_onFocusChanged(void* self, UIFocusState currState, UIFocusState prevState);
@@ -36,14 +37,17 @@ typedef struct UIButton
     TTF_Text* m_labelText;
 
     char* m_labelString;
+    UITextCache m_labelCache;
     SDL_Color m_labelColors[UI_BUTTON_STATE_COUNT];
     SDL_Color m_backColors[UI_BUTTON_STATE_COUNT];
 
     SpriteGroup* m_spriteGroup;
     int m_spriteIndices[UI_BUTTON_STATE_COUNT];
+    SpriteGeometry m_spriteGeometry;
 
     SpriteGroup* m_symbolGroup;
     int m_symbolSpriteIndex;
+    SpriteGeometry m_symbolGeometry;
     UITransform m_symbolTransform;
     UITransform m_labelTransform;
 
@@ -69,6 +73,7 @@ INLINE void UIButton_setLabelColor(void* self, UIButtonState state, SDL_Color co
     assert(UIObject_isOfType(self, UI_TYPE_BUTTON) && "self must be of type UI_TYPE_BUTTON");
     UIButton* selfButton = (UIButton*)self;
     selfButton->m_labelColors[state] = color;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIButton_setBackgroundColor(void* self, UIButtonState state, SDL_Color color)
@@ -76,6 +81,7 @@ INLINE void UIButton_setBackgroundColor(void* self, UIButtonState state, SDL_Col
     assert(UIObject_isOfType(self, UI_TYPE_BUTTON) && "self must be of type UI_TYPE_BUTTON");
     UIButton* selfButton = (UIButton*)self;
     selfButton->m_backColors[state] = color;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIButton_setLabelAnchor(void* self, Vec2 anchor)
@@ -83,6 +89,7 @@ INLINE void UIButton_setLabelAnchor(void* self, Vec2 anchor)
     assert(UIObject_isOfType(self, UI_TYPE_BUTTON) && "self must be of type UI_TYPE_BUTTON");
     UIButton* selfButton = (UIButton*)self;
     selfButton->m_labelAnchor = anchor;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIButton_setSpriteGroup(void* self, SpriteGroup* spriteGroup)
@@ -90,6 +97,7 @@ INLINE void UIButton_setSpriteGroup(void* self, SpriteGroup* spriteGroup)
     assert(UIObject_isOfType(self, UI_TYPE_BUTTON) && "self must be of type UI_TYPE_BUTTON");
     UIButton* selfButton = (UIButton*)self;
     selfButton->m_spriteGroup = spriteGroup;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIButton_setSpriteIndex(void* self, UIButtonState state, int spriteIndex)
@@ -97,6 +105,7 @@ INLINE void UIButton_setSpriteIndex(void* self, UIButtonState state, int spriteI
     assert(UIObject_isOfType(self, UI_TYPE_BUTTON) && "self must be of type UI_TYPE_BUTTON");
     UIButton* selfButton = (UIButton*)self;
     selfButton->m_spriteIndices[state] = spriteIndex;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIButton_setUseColorMod(void* self, bool useColorMod)
@@ -104,6 +113,7 @@ INLINE void UIButton_setUseColorMod(void* self, bool useColorMod)
     assert(UIObject_isOfType(self, UI_TYPE_BUTTON) && "self must be of type UI_TYPE_BUTTON");
     UIButton* selfButton = (UIButton*)self;
     selfButton->m_useColorMod = useColorMod;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIButton_setActiveState(void* self, bool isActive)
@@ -111,6 +121,7 @@ INLINE void UIButton_setActiveState(void* self, bool isActive)
     assert(UIObject_isOfType(self, UI_TYPE_BUTTON) && "self must be of type UI_TYPE_BUTTON");
     UIButton* selfButton = (UIButton*)self;
     selfButton->m_isActive = isActive;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE bool UIButton_isActive(void* self)
@@ -131,6 +142,7 @@ INLINE void UIButton_setSymbolSprite(
     selfButton->m_symbolGroup = symbolGroup;
     selfButton->m_symbolSpriteIndex = spriteIndex;
     selfButton->m_symbolTransform.localRect = rect;
+    UIObject_setLayoutDirty(self);
 }
 
 void UIButton_setLabelString(void* self, const char* text);
@@ -140,6 +152,7 @@ INLINE void UIButton_setLabelRect(void* self, UIRect rect)
     assert(UIObject_isOfType(self, UI_TYPE_BUTTON) && "self must be of type UI_TYPE_BUTTON");
     UIButton* selfButton = (UIButton*)self;
     selfButton->m_labelTransform.localRect = rect;
+    UIObject_setLayoutDirty(self);
 }
 
 INLINE void UIButton_setFont(void* self, TTF_Font* font)
@@ -150,6 +163,7 @@ INLINE void UIButton_setFont(void* self, TTF_Font* font)
     {
         TTF_SetTextFont(selfButton->m_labelText, font);
     }
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIButton_setOnClickCallback(
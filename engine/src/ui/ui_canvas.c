@@ -6,6 +6,7 @@
 
 #include "ui/ui_canvas.h"
 #include "game_engine_common.h"
+#include "core/render_queue.h"
 
 static inline uint64_t hashSplitmix64(uint64_t value)
 {
@@ -16,10 +17,11 @@ static inline uint64_t hashSplitmix64(uint64_t value)
     return z;
 }
 
+static void UICanvas_addId(UICanvas* self, int id);
+
 UICanvas* UICanvas_create(const char* objectName)
 {
-    UICanvas* self = (UICanvas*)calloc(1, sizeof(UICanvas));
-    AssertNew(self);
+    UICanvas* self = (UICanvas*)UIObject_allocNode(sizeof(UICanvas));
 
     UICanvas_init(self, objectName);
 
@@ -36,6 +38,10 @@ void UICanvas_init(void* self, const char* objectName)
 
     selfObject->m_type |= UI_TYPE_CANVAS;
     selfCanvas->m_setSize = 0;
+    selfCanvas->m_setCapacity = UI_CANVAS_INITIAL_SET_CAPACITY;
+    selfCanvas->m_set = (int*)calloc(selfCanvas->m_setCapacity, sizeof(int));
+    AssertNew(selfCanvas->m_set);
+    UICanvas_addId(selfCanvas, selfObject->m_objectId);
 
     UIRect rect = { 0 };
     rect.anchorMin = Vec2_set(0.f, 0.f);
@@ -44,6 +50,7 @@ void UICanvas_init(void* self, const char* objectName)
     rect.offsetMax = g_sizes.uiSize;
     selfObject->m_transform.localRect = rect;
     UITransform_updateAABB(&selfObject->m_transform, NULL);
+    selfCanvas->m_sizesRevision = g_sizes.revision;
 
     // Virtual methods
     selfObject->m_onRender = UICanvasVM_onRender;
@@ -51,43 +58,96 @@ void UICanvas_init(void* self, const char* objectName)
     selfObject->m_onDestroy = UICanvasVM_onDestroy;
 }
 
-static void UICanvas_recordObjectsRec(UICanvas* self, UIObject* object)
+static size_t UICanvas_findSlot(const UICanvas* self, int id)
 {
-    if (self->m_setSize >= UI_CANVAS_MAX_ELEMENTS)
+    const size_t mask = (size_t)self->m_setCapacity - 1;
+    size_t index = hashSplitmix64((uint64_t)id) & mask;
+    while ((self->m_set[index] != 0) && (self->m_set[index] != id))
     {
-        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "Maximum number of canvas elements reached");
-        assert(false);
-        return;
+        index = (index + 1) & mask;
     }
+    return index;
+}
+
+static void UICanvas_growSet(UICanvas* self)
+{
+    int* prevSet = self->m_set;
+    int prevCapacity = self->m_setCapacity;
 
-    int id = UIObject_getObjectId(object);
-    uint64_t hash = hashSplitmix64((uint64_t)id);
-    size_t index = hash % UI_CANVAS_SET_CAPACITY;
-    while (self->m_set[index] != 0)
+    self->m_setCapacity = 2 * prevCapacity;
+    self->m_set = (int*)calloc(self->m_setCapacity, sizeof(int));
+    AssertNew(self->m_set);
+
+    for (int i = 0; i < prevCapacity; i++)
     {
-        if (self->m_set[index] == id)
-        {
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Object is already recorded in the canvas");
-            index = UI_CANVAS_SET_CAPACITY;
-            break;
-        }
-        index = (index + 1) % UI_CANVAS_SET_CAPACITY;
+        if (prevSet[i] == 0) continue;
+        self->m_set[UICanvas_findSlot(self, prevSet[i])] = prevSet[i];
     }
-    if (index < UI_CANVAS_SET_CAPACITY)
+    free(prevSet);
+}
+
+static void UICanvas_addId(UICanvas* self, int id)
+{
+    // Facteur de charge maximal de 1/2
+    if (2 * (self->m_setSize + 1) > self->m_setCapacity)
     {
-        self->m_set[index] = id;
-        self->m_setSize++;
+        UICanvas_growSet(self);
     }
 
+    size_t index = UICanvas_findSlot(self, id);
+    if (self->m_set[index] == id)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Object is already recorded in the canvas");
+        return;
+    }
+    self->m_set[index] = id;
+    self->m_setSize++;
+    self->m_setRevision++;
+}
+
+static void UICanvas_removeId(UICanvas* self, int id)
+{
+    const size_t mask = (size_t)self->m_setCapacity - 1;
+    size_t i = UICanvas_findSlot(self, id);
+    if (self->m_set[i] == 0) return;
+
+    // Suppression par décalage arrière : pas de pierre tombale
+    size_t j = i;
+    while (true)
+    {
+        j = (j + 1) & mask;
+        if (self->m_set[j] == 0) break;
+
+        size_t k = hashSplitmix64((uint64_t)self->m_set[j]) & mask;
+        bool inRange = (i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j));
+        if (inRange) continue;
+
+        self->m_set[i] = self->m_set[j];
+        i = j;
+    }
+    self->m_set[i] = 0;
+    self->m_setSize--;
+    self->m_setRevision++;
+}
+
+void UICanvas_attachObject(UICanvas* self, UIObject* object)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_CANVAS) && "self must be of type UI_TYPE_CANVAS");
+    UICanvas_addId(self, UIObject_getObjectId(object));
     for (UIObject* child = object->m_firstChild; child != NULL; child = child->m_nextSibling)
     {
-        UICanvas_recordObjectsRec(self, child);
+        UICanvas_attachObject(self, child);
     }
 }
 
-void UICanvas_recordObjects(UICanvas* self)
+void UICanvas_detachObject(UICanvas* self, UIObject* object)
 {
-    UICanvas_recordObjectsRec(self, (UIObject*)self);
+    assert(UIObject_isOfType(self, UI_TYPE_CANVAS) && "self must be of type UI_TYPE_CANVAS");
+    UICanvas_removeId(self, UIObject_getObjectId(object));
+    for (UIObject* child = object->m_firstChild; child != NULL; child = child->m_nextSibling)
+    {
+        UICanvas_detachObject(self, child);
+    }
 }
 
 void UICanvasVM_onUpdate(void* self)
@@ -95,14 +155,22 @@ void UICanvasVM_onUpdate(void* self)
     assert(UIObject_isOfType(self, UI_TYPE_CANVAS) && "self must be of type UI_TYPE_CANVAS");
     UICanvas* selfCanvas = (UICanvas*)self;
 
+    // Les tailles de la fenêtre ont changé : toute l'interface est replacée
+    if (selfCanvas->m_sizesRevision != g_sizes.revision)
+    {
+        selfCanvas->m_sizesRevision = g_sizes.revision;
+        UIObject_setLayoutDirty(self);
+    }
+
     UIObjectVM_onUpdate(self);
+}
 
-    // Clear the recorded set
-    selfCanvas->m_setSize = 0;
-    SDL_memset(selfCanvas->m_set, 0, sizeof(selfCanvas->m_set));
+void UICanvasVM_onDestroy(void* self)
+{
+    UICanvas* selfCanvas = (UICanvas*)self;
+    free(selfCanvas->m_set);
 
-    // Record all objects in the canvas
-    UICanvas_recordObjects(selfCanvas);
+    UIObjectVM_onDestroy(self);
 }
 
 void UICanvasVM_onRender(void* self)
@@ -111,8 +179,8 @@ void UICanvasVM_onRender(void* self)
     UIObject* selfObj = (UIObject*)self;
     SDL_FRect viewportRect = { 0 };
     UIObject_getViewportRect(selfObj, &viewportRect);
-    SDL_SetRenderDrawColor(g_renderer, 255, 128, 0, 255);
-    SDL_RenderRect(g_renderer, &viewportRect);
+    SDL_Color color = { 255, 128, 0, 255 };
+    RenderQueue_drawRect(&viewportRect, color);
 }
 
 bool UICanvas_hasObject(void* self, int id)
@@ -120,15 +188,5 @@ bool UICanvas_hasObject(void* self, int id)
     assert(UIObject_isOfType(self, UI_TYPE_CANVAS) && "self must be of type UI_TYPE_CANVAS");
     UICanvas* selfCanvas = (UICanvas*)self;
 
-    uint64_t hash = hashSplitmix64((uint64_t)id);
-    size_t index = hash % UI_CANVAS_SET_CAPACITY;
-    while (selfCanvas->m_set[index] != 0)
-    {
-        if (selfCanvas->m_set[index] == id)
-        {
-            return true;
-        }
-        index = (index + 1) % UI_CANVAS_SET_CAPACITY;
-    }
-    return false;
+    return selfCanvas->m_set[UICanvas_findSlot(selfCanvas, id)] == id;
 }
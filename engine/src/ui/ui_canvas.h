@@ -13,16 +13,23 @@
 
 void UICanvasVM_onRender(void* self);
 void UICanvasVM_onUpdate(void* self);
-#define UICanvasVM_onDestroy UIObjectVM_onDestroy
+void UICanvasVM_onDestroy(void* self);
 
-#define UI_CANVAS_MAX_ELEMENTS 128
-#define UI_CANVAS_SET_CAPACITY 256
+#define UI_CANVAS_INITIAL_SET_CAPACITY 256
 
 typedef struct UICanvas
 {
     UIObject m_baseObject;
-    int m_set[UI_CANVAS_SET_CAPACITY];
+    /// @brief Ensemble des identifiants des objets du canvas.
+    /// Table à adressage ouvert maintenue lors des rattachements et des
+    /// détachements d'objets (UIObject_setParent(), UIObject_destroy()).
+    int* m_set;
     int m_setSize;
+    int m_setCapacity;
+    /// @brief Numéro incrémenté à chaque ajout ou retrait dans m_set.
+    Uint32 m_setRevision;
+    /// @brief Valeur de g_sizes.revision lors de la dernière disposition.
+    int m_sizesRevision;
 } UICanvas;
 
 UICanvas* UICanvas_create(const char* objectName);
@@ -32,5 +39,26 @@ INLINE void UICanvas_destroy(void* self)
     UIObject_destroy(self);
 }
 
-void UICanvas_recordObjects(UICanvas* self);
+/// @brief Ajoute un objet et ses descendants à l'ensemble des objets du canvas.
+/// Cette fonction est appelée par UIObject_setParent().
+/// @param self le canvas.
+/// @param object la racine du sous-arbre rattaché.
+void UICanvas_attachObject(UICanvas* self, UIObject* object);
+
+/// @brief Retire un objet et ses descendants de l'ensemble des objets du canvas.
+/// Cette fonction est appelée par UIObject_setParent().
+/// @param self le canvas.
+/// @param object la racine du sous-arbre détaché.
+void UICanvas_detachObject(UICanvas* self, UIObject* object);
+
 bool UICanvas_hasObject(void* self, int id);
+
+/// @brief Renvoie un numéro incrémenté à chaque rattachement ou détachement
+/// d'objet. Il permet de savoir si l'ensemble des objets du canvas a changé
+/// depuis une lecture précédente.
+/// @param self le canvas.
+INLINE Uint32 UICanvas_getSetRevision(void* self)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_CANVAS) && "self must be of type UI_TYPE_CANVAS");
+    return ((UICanvas*)self)->m_setRevision;
+}
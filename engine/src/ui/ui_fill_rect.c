@@ -6,11 +6,11 @@
 
 #include "ui/ui_fill_rect.h"
 #include "game_engine_common.h"
+#include "core/render_queue.h"
 
 UIFillRect* UIFillRect_create(const char* objectName, SDL_Color color)
 {
-    UIFillRect* self = (UIFillRect*)calloc(1, sizeof(UIFillRect));
-    AssertNew(self);
+    UIFillRect* self = (UIFillRect*)UIObject_allocNode(sizeof(UIFillRect));
 
     UIFillRect_init(self, objectName, color);
 
@@ -45,19 +45,5 @@ void UIFillRectVM_onRender(void* self)
     SDL_Color color = selfFillRect->m_color;
     color.a = (Uint8)(color.a * selfFillRect->m_opacity);
 
-    bool success = SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, color.a);
-    if (!success)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "UIFillRectVM_onRender");
-        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
-        assert(false);
-    }
-
-    success = SDL_RenderFillRect(g_renderer, &viewportRect);
-    if (!success)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "UIFillRectVM_onRender");
-        SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
-        assert(false);
-    }
+    RenderQueue_drawFillRect(&viewportRect, color);
 }
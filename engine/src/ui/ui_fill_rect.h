@@ -28,3 +28,11 @@ INLINE void UIFillRect_destroy(void* self)
 {
     UIObject_destroy(self);
 }
+
+INLINE void UIFillRect_setColor(void* self, SDL_Color color)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_FILL_RECT) && "self must be of type UI_TYPE_FILL_RECT");
+    UIFillRect* selfFillRect = (UIFillRect*)self;
+    selfFillRect->m_color = color;
+    UIObject_invalidateVisual(self);
+}
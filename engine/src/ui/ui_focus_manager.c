@@ -6,6 +6,13 @@
 
 #include "ui/ui_focus_manager.h"
 
+#define UI_FOCUS_MANAGER_INITIAL_CAPACITY 16
+#define UI_FOCUS_MANAGER_PENALTY_FACTOR 2.f
+
+static const Vec2 s_directionVectors[UI_FOCUS_DIRECTION_COUNT] = {
+    { 0.f, +1.f }, { 0.f, -1.f }, { -1.f, 0.f }, { +1.f, 0.f }
+};
+
 UIFocusManager* UIFocusManager_create()
 {
     UIFocusManager* self = (UIFocusManager*)calloc(1, sizeof(UIFocusManager));
@@ -13,7 +20,17 @@ UIFocusManager* UIFocusManager_create()
 
     self->m_enabled = true;
     self->m_elementCount = 0;
+    self->m_elementCapacity = UI_FOCUS_MANAGER_INITIAL_CAPACITY;
+    self->m_elements = (UIFocusManagerElement*)calloc(self->m_elementCapacity, sizeof(UIFocusManagerElement));
+    AssertNew(self->m_elements);
+    self->m_boxes = (AABB*)calloc(self->m_elementCapacity, sizeof(AABB));
+    AssertNew(self->m_boxes);
+    self->m_spatialIndex = UISpatialIndex_create();
+    self->m_isIndexDirty = true;
+    self->m_isGraphDirty = true;
+    self->m_isValidationDirty = true;
     self->m_focused = NULL;
+    self->m_focusedIdx = -1;
 
     return self;
 }
@@ -21,9 +38,28 @@ UIFocusManager* UIFocusManager_create()
 void UIFocusManager_destroy(UIFocusManager* self)
 {
     if (!self) return;
+
+    for (int i = 0; i < self->m_groupCount; i++)
+    {
+        free(self->m_groups[i]);
+    }
+    free(self->m_groups);
+    UISpatialIndex_destroy(self->m_spatialIndex);
+    free(self->m_elements);
+    free(self->m_boxes);
     free(self);
 }
 
+size_t UIFocusManager_getMemory(UIFocusManager* self)
+{
+    assert(self && "self must not be NULL");
+    return sizeof(UIFocusManager)
+        + (size_t)self->m_elementCapacity * (sizeof(UIFocusManagerElement) + sizeof(AABB))
+        + (size_t)self->m_groupCapacity * sizeof(UIFocusGroup*)
+        + (size_t)self->m_groupCount * sizeof(UIFocusGroup)
+        + UISpatialIndex_getMemory(self->m_spatialIndex);
+}
+
 void UIFocusManager_setCanvas(UIFocusManager* self, void* canvas)
 {
     assert(self && "self must not be NULL");
@@ -32,6 +68,7 @@ void UIFocusManager_setCanvas(UIFocusManager* self, void* canvas)
         assert(UIObject_isOfType(canvas, UI_TYPE_CANVAS) && "canvas must be of type UI_TYPE_CANVAS");
     }
     self->m_canvas = (UICanvas*)canvas;
+    self->m_isValidationDirty = true;
 }
 
 void UIFocusManager_addSelectable(UIFocusManager* self, void* selectable)
@@ -39,12 +76,6 @@ void UIFocusManager_addSelectable(UIFocusManager* self, void* selectable)
     assert(self && "self must not be NULL");
     assert(selectable && "selectable must not be NULL");
 
-    if (self->m_elementCount >= MAX_UI_SELECTABLES_IN_GROUP)
-    {
-        assert(false && "Maximum number of selectables reached");
-        return;
-    }
-
     const int id = UIObject_getObjectId(selectable);
 
     for (int i = 0; i < self->m_elementCount; i++)
@@ -56,9 +87,62 @@ void UIFocusManager_addSelectable(UIFocusManager* self, void* selectable)
             return;
         }
     }
-    self->m_elements[self->m_elementCount].m_id = id;
-    self->m_elements[self->m_elementCount].m_selectable = selectable;
+
+    if (self->m_elementCount >= self->m_elementCapacity)
+    {
+        int newCapacity = 2 * self->m_elementCapacity;
+        UIFocusManagerElement* newElements = (UIFocusManagerElement*)realloc(
+            self->m_elements, newCapacity * sizeof(UIFocusManagerElement)
+        );
+        AssertNew(newElements);
+        AABB* newBoxes = (AABB*)realloc(self->m_boxes, newCapacity * sizeof(AABB));
+        AssertNew(newBoxes);
+        self->m_elements = newElements;
+        self->m_boxes = newBoxes;
+        self->m_elementCapacity = newCapacity;
+    }
+
+    UIFocusManagerElement* element = &self->m_elements[self->m_elementCount];
+    memset(element, 0, sizeof(UIFocusManagerElement));
+    element->m_id = id;
+    element->m_selectable = selectable;
+    for (int d = 0; d < UI_FOCUS_DIRECTION_COUNT; d++)
+    {
+        element->m_neighbors[d] = -1;
+    }
     self->m_elementCount++;
+    self->m_isIndexDirty = true;
+    self->m_isValidationDirty = true;
+}
+
+static int UIFocusManager_findIndex(UIFocusManager* self, void* selectable)
+{
+    if (selectable == NULL) return -1;
+    for (int i = 0; i < self->m_elementCount; i++)
+    {
+        if (self->m_elements[i].m_selectable == selectable) return i;
+    }
+    return -1;
+}
+
+/// @brief Retire un élément en le remplaçant par le dernier.
+static void UIFocusManager_removeAt(UIFocusManager* self, int index)
+{
+    const int lastIndex = self->m_elementCount - 1;
+    if (self->m_focusedIdx == index)
+    {
+        self->m_focused = NULL;
+        self->m_focusedIdx = -1;
+    }
+    else if (self->m_focusedIdx == lastIndex)
+    {
+        self->m_focusedIdx = index;
+    }
+    self->m_elements[index] = self->m_elements[lastIndex];
+    self->m_elementCount--;
+    self->m_isIndexDirty = true;
+    self->m_isGraphDirty = true;
+    self->m_isValidationDirty = true;
 }
 
 void UIFocusManager_removeSelectable(UIFocusManager* self, void* selectable)
@@ -69,6 +153,7 @@ void UIFocusManager_removeSelectable(UIFocusManager* self, void* selectable)
     if (self->m_focused == selectable)
     {
         self->m_focused = NULL;
+        self->m_focusedIdx = -1;
     }
 
     const int id = UIObject_getObjectId(selectable);
@@ -78,8 +163,7 @@ void UIFocusManager_removeSelectable(UIFocusManager* self, void* selectable)
         UIFocusManagerElement* element = &self->m_elements[i];
         if (element->m_id == id)
         {
-            self->m_elements[i] = self->m_elements[self->m_elementCount - 1];
-            self->m_elementCount--;
+            UIFocusManager_removeAt(self, i);
             break;
         }
     }
@@ -90,10 +174,15 @@ void UIFocusManager_clear(UIFocusManager* self)
     assert(self && "self must not be NULL");
     self->m_elementCount = 0;
     self->m_focused = NULL;
+    self->m_focusedIdx = -1;
+    self->m_isIndexDirty = true;
+    self->m_isValidationDirty = true;
 }
 
-static void UIFocusManager_setFocusOn(UIFocusManager* self, UISelectable* selectable)
+static void UIFocusManager_setFocusOn(UIFocusManager* self, int index)
 {
+    UISelectable* selectable = self->m_elements[index].m_selectable;
+    self->m_focusedIdx = index;
     if (self->m_focused == selectable) return;
     if (self->m_focused)
     {
@@ -115,85 +204,249 @@ void UIFocusManager_setFocused(UIFocusManager* self, void* selectable)
         UIFocusManagerElement* element = &self->m_elements[i];
         if (element->m_id != id) continue;
 
-        UIFocusManager_setFocusOn(self, element->m_selectable);
+        UIFocusManager_setFocusOn(self, i);
         return;
     }
 
     assert(false && "selectable not found in focus manager");
 }
 
-static void UIFocusManager_searchNext(UIFocusManager* self, UIInput* input)
+void UIFocusManager_setNavigationOverride(
+    UIFocusManager* self, void* selectable, UIFocusDirection direction, void* target)
 {
-    const float kPenaltyFactor = 2.f;
+    assert(self && "self must not be NULL");
+    assert(direction >= 0 && direction < UI_FOCUS_DIRECTION_COUNT && "Invalid direction");
 
-    Vec2 direction = { 0, 0 };
-    direction.x = (float)(input->rightPressed - input->leftPressed);
-    direction.y = (float)(input->upPressed - input->downPressed);
-    direction = Vec2_normalize(direction);
-    Vec2 directionPerp = Vec2_perp(direction);
+    int index = UIFocusManager_findIndex(self, selectable);
+    assert(index >= 0 && "selectable not found in focus manager");
+    if (index < 0) return;
+
+    self->m_elements[index].m_overrides[direction] = (UISelectable*)target;
+    self->m_isGraphDirty = true;
+}
+
+UIFocusGroup* UIFocusManager_createGroup(UIFocusManager* self, UIFocusGroup* parent)
+{
+    assert(self && "self must not be NULL");
+    assert((parent == NULL || parent->m_manager == self) && "parent must belong to this focus manager");
+
+    if (self->m_groupCount >= self->m_groupCapacity)
+    {
+        int newCapacity = SDL_max(4, 2 * self->m_groupCapacity);
+        UIFocusGroup** newGroups = (UIFocusGroup**)realloc(self->m_groups, newCapacity * sizeof(UIFocusGroup*));
+        AssertNew(newGroups);
+        self->m_groups = newGroups;
+        self->m_groupCapacity = newCapacity;
+    }
+
+    UIFocusGroup* group = (UIFocusGroup*)calloc(1, sizeof(UIFocusGroup));
+    AssertNew(group);
+    group->m_manager = self;
+    group->m_parent = parent;
+    group->m_entryIdx = -1;
+
+    self->m_groups[self->m_groupCount++] = group;
+    return group;
+}
+
+void UIFocusManager_setGroup(UIFocusManager* self, void* selectable, UIFocusGroup* group)
+{
+    assert(self && "self must not be NULL");
+    assert((group == NULL || group->m_manager == self) && "group must belong to this focus manager");
+
+    int index = UIFocusManager_findIndex(self, selectable);
+    assert(index >= 0 && "selectable not found in focus manager");
+    if (index < 0) return;
+
+    self->m_elements[index].m_group = group;
+    self->m_isGraphDirty = true;
+}
+
+void UIFocusGroup_setEntry(UIFocusGroup* self, void* selectable)
+{
+    assert(self && "self must not be NULL");
+    self->m_entry = (UISelectable*)selectable;
+    self->m_manager->m_isGraphDirty = true;
+}
 
-    AABB currAABB = { 0 };
-    UIObject_getAABB(self->m_focused, &currAABB);
+void UIFocusGroup_setExit(UIFocusGroup* self, UIFocusDirection direction, UIFocusGroup* target)
+{
+    assert(self && "self must not be NULL");
+    assert(direction >= 0 && direction < UI_FOCUS_DIRECTION_COUNT && "Invalid direction");
+    assert((target == NULL || target->m_manager == self->m_manager) && "target must belong to the same focus manager");
+    self->m_exits[direction] = target;
+    self->m_manager->m_isGraphDirty = true;
+}
 
-    UISelectable* bestNext = NULL;
-    AABB bestNextAABB = { 0 };
-    float bestDistance = INFINITY;
+static bool UIFocusManager_isSelectable(void* userData, int itemIdx)
+{
+    UIFocusManager* self = (UIFocusManager*)userData;
+    UISelectable* selectable = self->m_elements[itemIdx].m_selectable;
+    return UISelectable_getFocusState(selectable) != UI_FOCUS_STATE_DISABLED;
+}
 
+static void UIFocusManager_updateIndex(UIFocusManager* self)
+{
+    const Uint32 layoutRevision = UIObject_getLayoutRevision();
+    if (self->m_isIndexDirty == false && self->m_indexRevision == layoutRevision) return;
+    self->m_indexRevision = layoutRevision;
+
+    // Une disposition ailleurs dans l'interface ne déplace pas forcément les
+    // éléments : l'index n'est reconstruit que si une boîte a changé
+    bool hasMoved = self->m_isIndexDirty;
     for (int i = 0; i < self->m_elementCount; i++)
     {
-        UIFocusManagerElement* element = &self->m_elements[i];
-        UISelectable* next = element->m_selectable;
-        if (next == self->m_focused) continue;
-        if (UISelectable_getFocusState(next) == UI_FOCUS_STATE_DISABLED) continue;
+        AABB box = { 0 };
+        UIObject_getAABB(self->m_elements[i].m_selectable, &box);
+        if (hasMoved == false && memcmp(&box, &self->m_boxes[i], sizeof(AABB)) == 0) continue;
+
+        self->m_boxes[i] = box;
+        hasMoved = true;
+    }
+    if (hasMoved == false) return;
+
+    UISpatialIndex_build(self->m_spatialIndex, self->m_boxes, self->m_elementCount);
+
+    self->m_isIndexDirty = false;
+    self->m_isGraphDirty = true;
+}
 
-        AABB nextAABB = { 0 };
-        UIObject_getAABB(next, &nextAABB);
+typedef struct UIFocusScope
+{
+    UIFocusManager* manager;
+    UIFocusGroup* group;
+} UIFocusScope;
+
+static bool UIFocusManager_isInScope(void* userData, int itemIdx)
+{
+    UIFocusScope* scope = (UIFocusScope*)userData;
+    UIFocusManagerElement* element = &scope->manager->m_elements[itemIdx];
+    if (element->m_isDisabled) return false;
+    if (scope->group == NULL) return true;
+
+    for (UIFocusGroup* group = element->m_group; group != NULL; group = group->m_parent)
+    {
+        if (group == scope->group) return true;
+    }
+    return false;
+}
 
-        Vec2 shortestVector = AABB_shortestVector(&currAABB, &nextAABB);
+/// @brief Cherche le voisin d'un élément en remontant ses groupes.
+/// Dans chaque groupe, le voisin le plus proche est choisi ; à défaut, le lien
+/// de sortie du groupe est suivi avant de passer au groupe parent.
+static int UIFocusManager_searchNeighbor(UIFocusManager* self, int index, UIFocusDirection direction)
+{
+    const Vec2 directionVector = s_directionVectors[direction];
+    UIFocusScope scope = { 0 };
+    scope.manager = self;
+    scope.group = self->m_elements[index].m_group;
 
-        float proj = Vec2_dot(shortestVector, direction);
-        if (proj <= 0.f) continue;
+    for (;;)
+    {
+        int nextIdx = UISpatialIndex_queryDirection(
+            self->m_spatialIndex, index, directionVector, UI_FOCUS_MANAGER_PENALTY_FACTOR,
+            UIFocusManager_isInScope, &scope
+        );
+        if (nextIdx >= 0) return nextIdx;
+        if (scope.group == NULL) return -1;
+
+        UIFocusGroup* exit = scope.group->m_exits[direction];
+        if (exit)
+        {
+            if (exit->m_entryIdx >= 0) return exit->m_entryIdx;
+
+            UIFocusScope exitScope = { 0 };
+            exitScope.manager = self;
+            exitScope.group = exit;
+            nextIdx = UISpatialIndex_queryDirection(
+                self->m_spatialIndex, index, directionVector, UI_FOCUS_MANAGER_PENALTY_FACTOR,
+                UIFocusManager_isInScope, &exitScope
+            );
+            if (nextIdx >= 0) return nextIdx;
+        }
+        scope.group = scope.group->m_parent;
+    }
+}
 
-        float perpProj = Vec2_dot(shortestVector, directionPerp);
-        float distance = proj + fabsf(perpProj) * kPenaltyFactor;
+/// @brief Recalcule le voisin de chaque élément dans chaque direction.
+static void UIFocusManager_updateGraph(UIFocusManager* self)
+{
+    if (self->m_isGraphDirty == false) return;
 
-        if ((distance < bestDistance) ||
-            ((fabsf(distance - bestDistance) < 1e-5) && (nextAABB.lower.x < bestNextAABB.lower.x)))
+    for (int i = 0; i < self->m_groupCount; i++)
+    {
+        UIFocusGroup* group = self->m_groups[i];
+        group->m_entryIdx = UIFocusManager_findIndex(self, group->m_entry);
+        if (group->m_entryIdx >= 0 && self->m_elements[group->m_entryIdx].m_isDisabled)
         {
-            bestDistance = distance;
-            bestNext = next;
-            bestNextAABB = nextAABB;
+            group->m_entryIdx = -1;
         }
     }
 
-    if (bestNext)
+    for (int i = 0; i < self->m_elementCount; i++)
     {
-        UIFocusManager_setFocusOn(self, bestNext);
+        UIFocusManagerElement* element = &self->m_elements[i];
+        for (int d = 0; d < UI_FOCUS_DIRECTION_COUNT; d++)
+        {
+            element->m_neighbors[d] = -1;
+            if (element->m_isDisabled) continue;
+
+            int overrideIdx = UIFocusManager_findIndex(self, element->m_overrides[d]);
+            if (overrideIdx >= 0 && self->m_elements[overrideIdx].m_isDisabled == false)
+            {
+                element->m_neighbors[d] = overrideIdx;
+                continue;
+            }
+            element->m_neighbors[d] = UIFocusManager_searchNeighbor(self, i, (UIFocusDirection)d);
+        }
     }
+
+    self->m_isGraphDirty = false;
 }
 
-static void UIFocusManager_updateMouse(UIFocusManager* self, UIInput* input)
+static void UIFocusManager_searchNext(UIFocusManager* self, UIInput* input)
 {
-    SDL_FPoint mousePoint = { input->mousePxPos.x, input->mousePxPos.y };
-    Vec2 mouseUIPos = input->mouseUIPos;
-    AABB aabb = { 0 };
+    Vec2 direction = { 0, 0 };
+    direction.x = (float)(input->rightPressed - input->leftPressed);
+    direction.y = (float)(input->upPressed - input->downPressed);
 
-    if (input->mouseMoved)
+    int nextIdx = -1;
+    if (direction.x == 0.f || direction.y == 0.f)
     {
-        for (int i = 0; i < self->m_elementCount; i++)
-        {
-            UIFocusManagerElement* element = &self->m_elements[i];
-            UISelectable* selectable = element->m_selectable;
-            UIFocusState state = UISelectable_getFocusState(selectable);
-            if (state == UI_FOCUS_STATE_DISABLED) continue;
+        UIFocusDirection focusDirection = UI_FOCUS_DIRECTION_UP;
+        if (direction.y < 0.f) focusDirection = UI_FOCUS_DIRECTION_DOWN;
+        else if (direction.x < 0.f) focusDirection = UI_FOCUS_DIRECTION_LEFT;
+        else if (direction.x > 0.f) focusDirection = UI_FOCUS_DIRECTION_RIGHT;
+        else if (direction.y == 0.f) return;
 
-            UIObject_getAABB(selectable, &aabb);
-            if (AABB_containsPoint(&aabb, mouseUIPos) == false) continue;
+        nextIdx = self->m_elements[self->m_focusedIdx].m_neighbors[focusDirection];
+    }
+    else
+    {
+        // Les diagonales ne sont pas précalculées
+        nextIdx = UISpatialIndex_queryDirection(
+            self->m_spatialIndex, self->m_focusedIdx, Vec2_normalize(direction),
+            UI_FOCUS_MANAGER_PENALTY_FACTOR, UIFocusManager_isSelectable, self
+        );
+    }
 
-            if (self->m_focused == selectable) break;
+    if (nextIdx >= 0)
+    {
+        UIFocusManager_setFocusOn(self, nextIdx);
+    }
+}
 
-            UIFocusManager_setFocusOn(self, selectable);
-            break;
+static void UIFocusManager_updateMouse(UIFocusManager* self, UIInput* input)
+{
+    if (input->mouseMoved)
+    {
+        int index = UISpatialIndex_queryPoint(
+            self->m_spatialIndex, input->mouseUIPos,
+            UIFocusManager_isSelectable, self
+        );
+        if (index >= 0)
+        {
+            UIFocusManager_setFocusOn(self, index);
         }
     }
     if (self->m_focused && input->lastInputType == UI_INPUT_TYPE_MOUSE)
@@ -223,6 +476,16 @@ static void UIFocusManager_updateGamepad(UIFocusManager* self, UIInput* input)
 
 static void UIFocusManager_validate(UIFocusManager* self)
 {
+    // Les éléments ne sont revus que si le canvas ou un état de focus a changé
+    const Uint32 setRevision = self->m_canvas ? UICanvas_getSetRevision(self->m_canvas) : 0;
+    const Uint32 stateRevision = UISelectable_getStateRevision();
+    if (self->m_isValidationDirty == false &&
+        self->m_validatedSetRevision == setRevision &&
+        self->m_validatedStateRevision == stateRevision)
+    {
+        return;
+    }
+
     if (self->m_canvas)
     {
         for (int i = 0; i < self->m_elementCount;)
@@ -235,8 +498,7 @@ static void UIFocusManager_validate(UIFocusManager* self)
                     "Selectable with id %d not found in canvas, removing from focus manager\n",
                     element->m_id
                 );
-                self->m_elements[i] = self->m_elements[self->m_elementCount - 1];
-                self->m_elementCount--;
+                UIFocusManager_removeAt(self, i);
                 continue;
             }
             i++;
@@ -247,26 +509,43 @@ static void UIFocusManager_validate(UIFocusManager* self)
     int firstValidIndex = -1;
     for (int i = 0; i < self->m_elementCount; i++)
     {
-        UISelectable* selectable = self->m_elements[i].m_selectable;
+        UIFocusManagerElement* element = &self->m_elements[i];
+        UISelectable* selectable = element->m_selectable;
         UIFocusState state = UISelectable_getFocusState(selectable);
-        if (state == UI_FOCUS_STATE_DISABLED) continue;
+        const bool isDisabled = (state == UI_FOCUS_STATE_DISABLED);
+        if (element->m_isDisabled != isDisabled)
+        {
+            element->m_isDisabled = isDisabled;
+            self->m_isGraphDirty = true;
+        }
+        if (isDisabled) continue;
 
         if (firstValidIndex < 0) firstValidIndex = i;
 
         if (selectable == self->m_focused)
         {
             focusedIsValid = true;
+            self->m_focusedIdx = i;
             continue;
         }
         UISelectable_setFocusState(selectable, UI_FOCUS_STATE_NORMAL);
     }
 
-    if (!focusedIsValid) self->m_focused = NULL;
+    if (!focusedIsValid)
+    {
+        self->m_focused = NULL;
+        self->m_focusedIdx = -1;
+    }
 
     if (self->m_focused == NULL && firstValidIndex >= 0)
     {
-        UIFocusManager_setFocusOn(self, self->m_elements[firstValidIndex].m_selectable);
+        UIFocusManager_setFocusOn(self, firstValidIndex);
     }
+
+    // Les changements d'état faits ci-dessus sont déjà pris en compte
+    self->m_validatedSetRevision = setRevision;
+    self->m_validatedStateRevision = UISelectable_getStateRevision();
+    self->m_isValidationDirty = false;
 }
 
 void UIFocusManager_update(UIFocusManager* self, UIInput* input)
@@ -280,6 +559,8 @@ void UIFocusManager_update(UIFocusManager* self, UIInput* input)
     UIFocusManager_validate(self);
     if (!self->m_focused) return;
 
+    UIFocusManager_updateIndex(self);
+    UIFocusManager_updateGraph(self);
     UIFocusManager_updateMouse(self, input);
     UIFocusManager_updateGamepad(self, input);
 }
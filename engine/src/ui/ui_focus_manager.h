@@ -10,23 +10,83 @@
 #include "ui/ui_input.h"
 #include "ui/ui_selectable.h"
 #include "ui/ui_canvas.h"
+#include "ui/ui_spatial_index.h"
 
-#define MAX_UI_SELECTABLES_IN_GROUP 256
+typedef struct UIFocusManager UIFocusManager;
+
+typedef enum UIFocusDirection
+{
+    UI_FOCUS_DIRECTION_UP = 0,
+    UI_FOCUS_DIRECTION_DOWN,
+    UI_FOCUS_DIRECTION_LEFT,
+    UI_FOCUS_DIRECTION_RIGHT,
+    UI_FOCUS_DIRECTION_COUNT
+} UIFocusDirection;
+
+/// @brief Groupe de navigation.
+/// La navigation reste dans le groupe tant qu'un voisin existe dans la
+/// direction demandée. Sinon, elle suit le lien de sortie du groupe puis
+/// se poursuit dans le groupe parent.
+typedef struct UIFocusGroup
+{
+    UIFocusManager* m_manager;
+    struct UIFocusGroup* m_parent;
+
+    /// @brief Elément sélectionné en entrant dans le groupe, ou NULL pour
+    /// choisir l'élément le plus proche.
+    UISelectable* m_entry;
+    int m_entryIdx;
+
+    /// @brief Groupe atteint en sortant par chaque direction, ou NULL.
+    struct UIFocusGroup* m_exits[UI_FOCUS_DIRECTION_COUNT];
+} UIFocusGroup;
 
 typedef struct UIFocusManagerElement
 {
     UISelectable* m_selectable;
     int m_id;
+    UIFocusGroup* m_group;
+
+    /// @brief Voisins imposés par direction, prioritaires sur les voisins calculés.
+    UISelectable* m_overrides[UI_FOCUS_DIRECTION_COUNT];
+    /// @brief Indice du voisin dans chaque direction, ou -1.
+    int m_neighbors[UI_FOCUS_DIRECTION_COUNT];
+    bool m_isDisabled;
 } UIFocusManagerElement;
 
 typedef struct UIFocusManager
 {
     UICanvas* m_canvas;
 
-    UIFocusManagerElement m_elements[MAX_UI_SELECTABLES_IN_GROUP];
+    UIFocusManagerElement* m_elements;
     int m_elementCount;
+    int m_elementCapacity;
+
+    /// @brief Index des boîtes englobantes des éléments, dans l'ordre de m_elements.
+    /// Il est reconstruit lorsque les éléments changent ou que l'une de leurs
+    /// boîtes a bougé ; une disposition d'autres objets ne le reconstruit pas.
+    UISpatialIndex* m_spatialIndex;
+    AABB* m_boxes;
+    Uint32 m_indexRevision;
+    bool m_isIndexDirty;
+
+    /// @brief Indique si les voisins des éléments doivent être recalculés,
+    /// après un changement de groupe, de lien ou d'état désactivé.
+    bool m_isGraphDirty;
+
+    /// @brief Révisions du canvas et des états de focus lors de la dernière
+    /// validation des éléments. La validation n'est refaite que si l'une
+    /// d'elles a changé ou si m_isValidationDirty est vrai.
+    Uint32 m_validatedSetRevision;
+    Uint32 m_validatedStateRevision;
+    bool m_isValidationDirty;
+
+    UIFocusGroup** m_groups;
+    int m_groupCount;
+    int m_groupCapacity;
 
     UISelectable* m_focused;
+    int m_focusedIdx;
     bool m_enabled;
 } UIFocusManager;
 
@@ -34,12 +94,36 @@ UIFocusManager* UIFocusManager_create();
 void UIFocusManager_destroy(UIFocusManager* self);
 void UIFocusManager_update(UIFocusManager* self, UIInput* input);
 
+/// @brief Renvoie la mémoire allouée par le gestionnaire de focus, en octets.
+/// @param self le gestionnaire de focus.
+/// @return La mémoire allouée, index spatial et groupes compris.
+size_t UIFocusManager_getMemory(UIFocusManager* self);
+
 void UIFocusManager_setCanvas(UIFocusManager* self, void* canvas);
 void UIFocusManager_addSelectable(UIFocusManager* self, void* selectable);
 void UIFocusManager_removeSelectable(UIFocusManager* self, void* selectable);
 void UIFocusManager_clear(UIFocusManager* self);
 void UIFocusManager_setFocused(UIFocusManager* self, void* selectable);
 
-// TODO: Définir des groupes de navigation pour gérer plusieurs groupes indépendants UIFocusGroup.
-// Un groupe aurait un selectable de référence par direction (up, down, left, right) pour gérer la navigation entre groupes.
-// Au sein d'un groupe, la navigation se fait comme actuellement.
+/// @brief Impose le voisin d'un élément dans une direction.
+/// @param self le gestionnaire de focus.
+/// @param selectable l'élément.
+/// @param direction la direction.
+/// @param target le voisin imposé, ou NULL pour revenir au voisin calculé.
+void UIFocusManager_setNavigationOverride(
+    UIFocusManager* self, void* selectable, UIFocusDirection direction, void* target);
+
+/// @brief Crée un groupe de navigation détruit avec le gestionnaire.
+/// @param self le gestionnaire de focus.
+/// @param parent le groupe parent, ou NULL.
+/// @return Le groupe créé.
+UIFocusGroup* UIFocusManager_createGroup(UIFocusManager* self, UIFocusGroup* parent);
+
+/// @brief Place un élément dans un groupe de navigation.
+/// @param self le gestionnaire de focus.
+/// @param selectable l'élément.
+/// @param group le groupe, ou NULL pour le retirer de son groupe.
+void UIFocusManager_setGroup(UIFocusManager* self, void* selectable, UIFocusGroup* group);
+
+void UIFocusGroup_setEntry(UIFocusGroup* self, void* selectable);
+void UIFocusGroup_setExit(UIFocusGroup* self, UIFocusDirection direction, UIFocusGroup* target);
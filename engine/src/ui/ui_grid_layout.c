@@ -6,11 +6,11 @@
 
 #include "ui/ui_grid_layout.h"
 #include "game_engine_common.h"
+#include "core/render_queue.h"
 
 UIGridLayout* UIGridLayout_create(const char* objectName, int rowCount, int columnCount)
 {
-    UIGridLayout* self = (UIGridLayout*)calloc(1, sizeof(UIGridLayout));
-    AssertNew(self);
+    UIGridLayout* self = (UIGridLayout*)UIObject_allocNode(sizeof(UIGridLayout));
 
     UIGridLayout_init(self, objectName, rowCount, columnCount);
 
@@ -28,22 +28,17 @@ void UIGridLayout_init(void* self, const char* objectName, int rowCount, int col
     selfObj->m_type |= UI_TYPE_GRID_LAYOUT;
     selfGrid->m_rowCount = rowCount;
     selfGrid->m_colCount = columnCount;
+    selfGrid->m_rowCapacity = rowCount;
     selfGrid->m_elementCount = 0;
 
     selfGrid->m_padding = Vec2_set(0.f, 0.f);
     selfGrid->m_anchor = Vec2_set(0.5f, 0.5f);
-    selfGrid->m_rowSizes = (float*)calloc(rowCount, sizeof(float));
-    selfGrid->m_colSizes = (float*)calloc(columnCount, sizeof(float));
-    selfGrid->m_rowSpacings = (float*)calloc(rowCount, sizeof(float));
-    selfGrid->m_colSpacings = (float*)calloc(columnCount, sizeof(float));
-    selfGrid->m_rowOffsets = (float*)calloc((size_t)rowCount + 1, sizeof(float));
-    selfGrid->m_colOffsets = (float*)calloc((size_t)columnCount + 1, sizeof(float));
-    AssertNew(selfGrid->m_rowSizes);
-    AssertNew(selfGrid->m_colSizes);
-    AssertNew(selfGrid->m_rowSpacings);
-    AssertNew(selfGrid->m_colSpacings);
-    AssertNew(selfGrid->m_rowOffsets);
-    AssertNew(selfGrid->m_colOffsets);
+    selfGrid->m_rowSizes = (float*)UIObject_allocMemory(self, rowCount * sizeof(float));
+    selfGrid->m_colSizes = (float*)UIObject_allocMemory(self, columnCount * sizeof(float));
+    selfGrid->m_rowSpacings = (float*)UIObject_allocMemory(self, rowCount * sizeof(float));
+    selfGrid->m_colSpacings = (float*)UIObject_allocMemory(self, columnCount * sizeof(float));
+    selfGrid->m_rowOffsets = (float*)UIObject_allocMemory(self, ((size_t)rowCount + 1) * sizeof(float));
+    selfGrid->m_colOffsets = (float*)UIObject_allocMemory(self, ((size_t)columnCount + 1) * sizeof(float));
 
     for (int i = 0; i < rowCount; i++)
     {
@@ -54,6 +49,19 @@ void UIGridLayout_init(void* self, const char* objectName, int rowCount, int col
         selfGrid->m_colSizes[i] = -1.f;
     }
 
+    selfGrid->m_cellCapacity = UI_GRID_INITIAL_CELL_CAPACITY;
+    selfGrid->m_cells = (UIGridCell*)UIObject_allocMemory(self, selfGrid->m_cellCapacity * sizeof(UIGridCell));
+    selfGrid->m_cellTableSize = 2 * UI_GRID_INITIAL_CELL_CAPACITY;
+    selfGrid->m_cellTable = (int*)UIObject_allocMemory(self, selfGrid->m_cellTableSize * sizeof(int));
+    for (int i = 0; i < selfGrid->m_cellTableSize; i++)
+    {
+        selfGrid->m_cellTable[i] = -1;
+    }
+    selfGrid->m_occupancy = (Uint8*)UIObject_allocMemory(self, (size_t)rowCount * columnCount);
+    selfGrid->m_flowIdx = 0;
+    selfGrid->m_areTracksDirty = true;
+    selfGrid->m_areCellsDirty = true;
+
     // Virtual methods
     selfObj->m_onDestroy = UIGridLayoutVM_onDestroy;
     selfObj->m_onRender = UIGridLayoutVM_onRender;
@@ -63,25 +71,159 @@ void UIGridLayout_init(void* self, const char* objectName, int rowCount, int col
 void UIGridLayoutVM_onDestroy(void* self)
 {
     UIGridLayout* selfGrid = (UIGridLayout*)self;
-    free(selfGrid->m_colSizes);
-    free(selfGrid->m_rowSizes);
-    free(selfGrid->m_colOffsets);
-    free(selfGrid->m_rowOffsets);
-    free(selfGrid->m_rowSpacings);
-    free(selfGrid->m_colSpacings);
+    UIObject_freeMemory(self, selfGrid->m_colSizes);
+    UIObject_freeMemory(self, selfGrid->m_rowSizes);
+    UIObject_freeMemory(self, selfGrid->m_colOffsets);
+    UIObject_freeMemory(self, selfGrid->m_rowOffsets);
+    UIObject_freeMemory(self, selfGrid->m_rowSpacings);
+    UIObject_freeMemory(self, selfGrid->m_colSpacings);
+    UIObject_freeMemory(self, selfGrid->m_cells);
+    UIObject_freeMemory(self, selfGrid->m_cellTable);
+    UIObject_freeMemory(self, selfGrid->m_occupancy);
 
     UIObjectVM_onDestroy(self);
 }
 
+/// @brief Remplace un tableau par une copie plus grande.
+/// Les nouveaux éléments sont initialisés à zéro.
+static void* UIGridLayout_growArray(void* self, void* array, size_t oldSize, size_t newSize)
+{
+    void* newArray = UIObject_allocMemory(self, newSize);
+    memcpy(newArray, array, oldSize);
+    UIObject_freeMemory(self, array);
+    return newArray;
+}
+
+static int UIGridLayout_hashObject(UIGridLayout* self, void* object)
+{
+    Uint64 key = (Uint64)(uintptr_t)object >> 4;
+    return (int)((key * 0x9E3779B97F4A7C15ull) >> 32) & (self->m_cellTableSize - 1);
+}
+
 static int UIGridLayout_findCell(void* self, void* object)
 {
     UIGridLayout* selfGrid = (UIGridLayout*)self;
-    for (int i = 0; i < selfGrid->m_elementCount; i++)
+    const int mask = selfGrid->m_cellTableSize - 1;
+    for (int i = UIGridLayout_hashObject(selfGrid, object); ; i = (i + 1) & mask)
+    {
+        int cellIndex = selfGrid->m_cellTable[i];
+        if (cellIndex < 0) return -1;
+        if (selfGrid->m_cells[cellIndex].uiObject == object) return cellIndex;
+    }
+}
+
+static void UIGridLayout_insertCell(UIGridLayout* self, int cellIndex)
+{
+    const int mask = self->m_cellTableSize - 1;
+    int i = UIGridLayout_hashObject(self, self->m_cells[cellIndex].uiObject);
+    while (self->m_cellTable[i] >= 0)
+    {
+        i = (i + 1) & mask;
+    }
+    self->m_cellTable[i] = cellIndex;
+}
+
+static int UIGridLayout_newCell(UIGridLayout* self)
+{
+    if (self->m_elementCount >= self->m_cellCapacity)
+    {
+        int newCapacity = 2 * self->m_cellCapacity;
+        self->m_cells = (UIGridCell*)UIGridLayout_growArray(
+            self, self->m_cells,
+            self->m_cellCapacity * sizeof(UIGridCell), newCapacity * sizeof(UIGridCell)
+        );
+        self->m_cellCapacity = newCapacity;
+    }
+
+    // La table reste remplie au plus à moitié
+    if (2 * (self->m_elementCount + 1) > self->m_cellTableSize)
+    {
+        UIObject_freeMemory(self, self->m_cellTable);
+        self->m_cellTableSize *= 2;
+        self->m_cellTable = (int*)UIObject_allocMemory(self, self->m_cellTableSize * sizeof(int));
+        for (int i = 0; i < self->m_cellTableSize; i++)
+        {
+            self->m_cellTable[i] = -1;
+        }
+        for (int i = 0; i < self->m_elementCount; i++)
+        {
+            UIGridLayout_insertCell(self, i);
+        }
+    }
+
+    return self->m_elementCount++;
+}
+
+static void UIGridLayout_growRows(UIGridLayout* self, int rowCount)
+{
+    const int prevRowCount = self->m_rowCount;
+    if (rowCount <= prevRowCount) return;
+
+    if (rowCount > self->m_rowCapacity)
+    {
+        const size_t prevCapacity = self->m_rowCapacity;
+        const size_t newCapacity = SDL_max((size_t)rowCount, 2 * prevCapacity);
+        const size_t colCount = self->m_colCount;
+        self->m_rowSizes = (float*)UIGridLayout_growArray(
+            self, self->m_rowSizes, prevCapacity * sizeof(float), newCapacity * sizeof(float)
+        );
+        self->m_rowSpacings = (float*)UIGridLayout_growArray(
+            self, self->m_rowSpacings, prevCapacity * sizeof(float), newCapacity * sizeof(float)
+        );
+        self->m_rowOffsets = (float*)UIGridLayout_growArray(
+            self, self->m_rowOffsets, (prevCapacity + 1) * sizeof(float), (newCapacity + 1) * sizeof(float)
+        );
+        self->m_occupancy = (Uint8*)UIGridLayout_growArray(
+            self, self->m_occupancy, prevCapacity * colCount, newCapacity * colCount
+        );
+        self->m_rowCapacity = (int)newCapacity;
+    }
+
+    const float rowSize = (prevRowCount > 0) ? self->m_rowSizes[prevRowCount - 1] : -1.f;
+    const float rowSpacing = (prevRowCount > 1) ? self->m_rowSpacings[prevRowCount - 2] : 0.f;
+    for (int i = prevRowCount; i < rowCount; i++)
+    {
+        self->m_rowSizes[i] = rowSize;
+    }
+    for (int i = SDL_max(prevRowCount - 1, 0); i < rowCount - 1; i++)
     {
-        if (selfGrid->m_cells[i].uiObject != object) continue;
-        return i;
+        self->m_rowSpacings[i] = rowSpacing;
     }
-    return -1;
+    self->m_rowSpacings[rowCount - 1] = 0.f;
+    self->m_rowCount = rowCount;
+
+    self->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
+}
+
+void UIGridLayout_addRows(void* self, int count)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_GRID_LAYOUT) && "self must be of type UI_TYPE_GRID_LAYOUT");
+    assert(count >= 0 && "count must be positive");
+    UIGridLayout* selfGrid = (UIGridLayout*)self;
+    UIGridLayout_growRows(selfGrid, selfGrid->m_rowCount + count);
+}
+
+static void UIGridLayout_setOccupied(UIGridLayout* self, const UIGridCell* cell, Uint8 occupied)
+{
+    for (size_t i = cell->rowIdx; i < cell->rowIdx + cell->rowSpan; i++)
+    {
+        Uint8* rowOccupancy = self->m_occupancy + i * self->m_colCount;
+        memset(rowOccupancy + cell->colIdx, occupied, cell->colSpan);
+    }
+}
+
+static bool UIGridLayout_isAreaFree(UIGridLayout* self, int rowIdx, int columnIdx, int rowSpan, int columnSpan)
+{
+    for (int i = rowIdx; i < rowIdx + rowSpan; i++)
+    {
+        const Uint8* rowOccupancy = self->m_occupancy + (size_t)i * self->m_colCount;
+        for (int j = columnIdx; j < columnIdx + columnSpan; j++)
+        {
+            if (rowOccupancy[j]) return false;
+        }
+    }
+    return true;
 }
 
 void UIGridLayout_addObject(void* self, void* object, int rowIdx, int columnIdx, int rowSpan, int columnSpan)
@@ -104,31 +246,70 @@ void UIGridLayout_addObject(void* self, void* object, int rowIdx, int columnIdx,
     int cellIndex = UIGridLayout_findCell(self, object);
     if (cellIndex < 0)
     {
-        cellIndex = selfGrid->m_elementCount;
-        if (cellIndex >= UI_GRID_MAX_ELEMENTS)
-        {
-            assert(false);
-            return;
-        }
-        selfGrid->m_elementCount++;
+        cellIndex = UIGridLayout_newCell(selfGrid);
+        selfGrid->m_cells[cellIndex].uiObject = object;
+        UIGridLayout_insertCell(selfGrid, cellIndex);
+    }
+    else
+    {
+        UIGridLayout_setOccupied(selfGrid, &selfGrid->m_cells[cellIndex], 0);
     }
     UIGridCell* cell = selfGrid->m_cells + cellIndex;
-    cell->uiObject = object;
     cell->rowIdx = rowIdx;
     cell->colIdx = columnIdx;
     cell->rowSpan = rowSpan;
     cell->colSpan = columnSpan;
+    UIGridLayout_setOccupied(selfGrid, cell, 1);
 
     UIObject_setParent(object, self);
 
-    UIGridLayoutVM_onUpdate(self);
+    // Les cellules sont placées à la prochaine mise à jour, en une seule passe
+    selfGrid->m_areCellsDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
-static void UIGridLayout_updateOffsets(void* self)
+void UIGridLayout_appendObject(void* self, void* object, int rowSpan, int columnSpan)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_GRID_LAYOUT) && "self must be of type UI_TYPE_GRID_LAYOUT");
+    UIGridLayout* selfGrid = (UIGridLayout*)self;
+    const int colCount = selfGrid->m_colCount;
+
+    rowSpan = SDL_max(rowSpan, 1);
+    columnSpan = Int_clamp(columnSpan, 1, colCount);
+
+    for (int idx = selfGrid->m_flowIdx; ; idx++)
+    {
+        const int rowIdx = idx / colCount;
+        const int columnIdx = idx % colCount;
+        if (columnIdx + columnSpan > colCount) continue;
+
+        UIGridLayout_growRows(selfGrid, rowIdx + rowSpan);
+        if (UIGridLayout_isAreaFree(selfGrid, rowIdx, columnIdx, rowSpan, columnSpan) == false) continue;
+
+        selfGrid->m_flowIdx = idx + columnSpan;
+        UIGridLayout_addObject(self, object, rowIdx, columnIdx, rowSpan, columnSpan);
+        return;
+    }
+}
+
+/// @brief Calcule la position des lignes et des colonnes.
+/// Le résultat est conservé tant que les tailles, les espacements, la marge
+/// et la taille de la grille ne changent pas.
+/// @return true si les positions ont été recalculées.
+static bool UIGridLayout_updateOffsets(void* self)
 {
     UIObject* selfObj = (UIObject*)self;
     UIGridLayout* selfGrid = (UIGridLayout*)self;
     const Vec2 dimensions = UITransform_getSize(&(selfObj->m_transform));
+    if (selfGrid->m_areTracksDirty == false &&
+        dimensions.x == selfGrid->m_trackDimensions.x &&
+        dimensions.y == selfGrid->m_trackDimensions.y)
+    {
+        return false;
+    }
+    selfGrid->m_areTracksDirty = false;
+    selfGrid->m_trackDimensions = dimensions;
+
     const size_t rowCount = selfGrid->m_rowCount;
     const size_t colCount = selfGrid->m_colCount;
     const float* rowSpacings = selfGrid->m_rowSpacings;
@@ -191,14 +372,22 @@ static void UIGridLayout_updateOffsets(void* self)
             colOffsets[i + 1] += colSizes[i] * stretchSize.x;
         }
     }
+    return true;
 }
 
 void UIGridLayoutVM_onUpdate(void* self)
 {
+    // Les cellules ne sont replacées que si la grille a changé de taille ou de configuration
+    if (((UIObject*)self)->m_transform.isDirty == false) return;
+
     UIObjectVM_onUpdate(self);
-    UIGridLayout_updateOffsets(self);
 
+    // Si seule la position de la grille change, les rectangles des cellules,
+    // relatifs à la grille, restent valides
     UIGridLayout* selfGrid = (UIGridLayout*)self;
+    if (UIGridLayout_updateOffsets(self) == false && selfGrid->m_areCellsDirty == false) return;
+    selfGrid->m_areCellsDirty = false;
+
     UIObject* selfObj = (UIObject*)self;
     const size_t rowCount = selfGrid->m_rowCount;
     const size_t colCount = selfGrid->m_colCount;
@@ -235,6 +424,7 @@ void UIGridLayoutVM_onUpdate(void* self)
         rect->offsetMax.x += colOffsets[cell.colIdx + cell.colSpan] - colSpacings[cell.colIdx + cell.colSpan - 1];
         rect->offsetMin.y -= rowOffsets[cell.rowIdx + cell.rowSpan] - rowSpacings[cell.rowIdx + cell.rowSpan - 1];
         rect->offsetMax.y -= rowOffsets[cell.rowIdx];
+        object->m_transform.isDirty = true;
     }
 }
 
@@ -266,7 +456,7 @@ void UIGridLayoutVM_onRender(void* self)
     const AABB* aabb = &(selfObj->m_transform.aabb);
 
     SDL_Color color = g_colors.grape5;
-    SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, 255);
+    color.a = 255;
 
     AABB childAABB = { 0 };
     for (int i = 0; i < rowCount; i++)
@@ -282,7 +472,7 @@ void UIGridLayoutVM_onRender(void* self)
             childAABB.upper.y -= rowOffsets[i];
 
             SDL_FRect rect = UIRect_aabbToViewportRect(&childAABB);
-            SDL_RenderRect(g_renderer, &rect);
+            RenderQueue_drawRect(&rect, color);
         }
     }
 }
@@ -293,6 +483,8 @@ void UIGridLayout_setRowSize(void* self, int index, float size)
     UIGridLayout* selfGrid = (UIGridLayout*)self;
     assert(index >= 0 && index < selfGrid->m_rowCount && "index out of bounds");
     selfGrid->m_rowSizes[index] = size;
+    selfGrid->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
 void UIGridLayout_setColumnSize(void* self, int index, float size)
@@ -301,6 +493,8 @@ void UIGridLayout_setColumnSize(void* self, int index, float size)
     UIGridLayout* selfGrid = (UIGridLayout*)self;
     assert(index >= 0 && index < selfGrid->m_colCount && "index out of bounds");
     selfGrid->m_colSizes[index] = size;
+    selfGrid->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
 void UIGridLayout_setRowSizes(void* self, float size)
@@ -311,6 +505,8 @@ void UIGridLayout_setRowSizes(void* self, float size)
     {
         selfGrid->m_rowSizes[i] = size;
     }
+    selfGrid->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
 void UIGridLayout_setColumnSizes(void* self, float size)
@@ -321,6 +517,8 @@ void UIGridLayout_setColumnSizes(void* self, float size)
     {
         selfGrid->m_colSizes[i] = size;
     }
+    selfGrid->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
 void UIGridLayout_setRowSpacing(void* self, int index, float spacing)
@@ -329,6 +527,8 @@ void UIGridLayout_setRowSpacing(void* self, int index, float spacing)
     UIGridLayout* selfGrid = (UIGridLayout*)self;
     assert(index >= 0 && index < selfGrid->m_rowCount - 1 && "index out of bounds");
     selfGrid->m_rowSpacings[index] = spacing;
+    selfGrid->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
 void UIGridLayout_setColumnSpacing(void* self, int index, float spacing)
@@ -337,6 +537,8 @@ void UIGridLayout_setColumnSpacing(void* self, int index, float spacing)
     UIGridLayout* selfGrid = (UIGridLayout*)self;
     assert(index >= 0 && index < selfGrid->m_colCount - 1 && "index out of bounds");
     selfGrid->m_colSpacings[index] = spacing;
+    selfGrid->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
 void UIGridLayout_setRowSpacings(void* self, float spacing)
@@ -348,6 +550,8 @@ void UIGridLayout_setRowSpacings(void* self, float spacing)
         selfGrid->m_rowSpacings[i] = spacing;
     }
     selfGrid->m_rowSpacings[selfGrid->m_rowCount - 1] = 0.f;
+    selfGrid->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
 void UIGridLayout_setColumnSpacings(void* self, float spacing)
@@ -359,6 +563,8 @@ void UIGridLayout_setColumnSpacings(void* self, float spacing)
         selfGrid->m_colSpacings[i] = spacing;
     }
     selfGrid->m_colSpacings[selfGrid->m_colCount - 1] = 0.f;
+    selfGrid->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
 void UIGridLayout_setPadding(void* self, Vec2 padding)
@@ -366,6 +572,8 @@ void UIGridLayout_setPadding(void* self, Vec2 padding)
     assert(UIObject_isOfType(self, UI_TYPE_GRID_LAYOUT) && "self must be of type UI_TYPE_GRID_LAYOUT");
     UIGridLayout* selfGrid = (UIGridLayout*)self;
     selfGrid->m_padding = padding;
+    selfGrid->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
 void UIGridLayout_setAnchor(void* self, Vec2 anchor)
@@ -373,6 +581,8 @@ void UIGridLayout_setAnchor(void* self, Vec2 anchor)
     assert(UIObject_isOfType(self, UI_TYPE_GRID_LAYOUT) && "self must be of type UI_TYPE_GRID_LAYOUT");
     UIGridLayout* selfGrid = (UIGridLayout*)self;
     selfGrid->m_anchor = anchor;
+    selfGrid->m_areTracksDirty = true;
+    UIObject_setLayoutDirty(self);
 }
 
 Vec2 UIGridLayout_getMinimumSize(void* self)
@@ -26,7 +26,7 @@ typedef struct UIGridCell
     size_t colSpan;
 } UIGridCell;
 
-#define UI_GRID_MAX_ELEMENTS 64
+#define UI_GRID_INITIAL_CELL_CAPACITY 8
 
 typedef struct UIGridLayout
 {
@@ -34,6 +34,7 @@ typedef struct UIGridLayout
 
     int m_rowCount;
     int m_colCount;
+    int m_rowCapacity;
     int m_elementCount;
     Vec2 m_padding;
     Vec2 m_anchor;
@@ -43,7 +44,26 @@ typedef struct UIGridLayout
     float* m_colSpacings;
     float* m_rowOffsets;
     float* m_colOffsets;
-    UIGridCell m_cells[UI_GRID_MAX_ELEMENTS];
+
+    UIGridCell* m_cells;
+    int m_cellCapacity;
+
+    /// @brief Table de hachage des indices de cellule par objet.
+    /// Les cases vides valent -1 ; la taille est une puissance de deux.
+    int* m_cellTable;
+    int m_cellTableSize;
+
+    /// @brief Occupation des cases de la grille, ligne par ligne.
+    Uint8* m_occupancy;
+    /// @brief Case à partir de laquelle le placement automatique cherche une place libre.
+    int m_flowIdx;
+
+    /// @brief Indique si m_rowOffsets et m_colOffsets doivent être recalculés.
+    bool m_areTracksDirty;
+    /// @brief Indique si des cellules ont été ajoutées ou déplacées.
+    bool m_areCellsDirty;
+    /// @brief Taille de la grille pour laquelle les offsets ont été calculés.
+    Vec2 m_trackDimensions;
 } UIGridLayout;
 
 UIGridLayout* UIGridLayout_create(const char* objectName, int rowCount, int columnCount);
@@ -55,6 +75,27 @@ INLINE void UIGridLayout_destroy(void* self)
 
 void UIGridLayout_addObject(void* self, void* object, int rowIdx, int columnIdx, int rowSpan, int columnSpan);
 
+/// @brief Place un objet dans la première zone libre, ligne par ligne.
+/// Des lignes sont ajoutées si la grille est pleine ; elles reprennent la
+/// taille de la dernière ligne et l'espacement entre les deux dernières lignes.
+/// @param self la grille.
+/// @param object l'objet.
+/// @param rowSpan le nombre de lignes occupées.
+/// @param columnSpan le nombre de colonnes occupées.
+void UIGridLayout_appendObject(void* self, void* object, int rowSpan, int columnSpan);
+
+/// @brief Ajoute des lignes à la fin de la grille.
+/// @param self la grille.
+/// @param count le nombre de lignes.
+void UIGridLayout_addRows(void* self, int count);
+
+INLINE int UIGridLayout_getRowCount(void* self)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_GRID_LAYOUT) && "self must be of type UI_TYPE_GRID_LAYOUT");
+    UIGridLayout* selfGrid = (UIGridLayout*)self;
+    return selfGrid->m_rowCount;
+}
+
 void UIGridLayout_setRowSize(void* self, int index, float size);
 void UIGridLayout_setColumnSize(void* self, int index, float size);
 void UIGridLayout_setRowSizes(void* self, float size);
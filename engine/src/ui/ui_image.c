@@ -9,8 +9,7 @@
 
 UIImage* UIImage_create(const char* objectName, SpriteGroup* spriteGroup, int spriteIndex)
 {
-    UIImage* self = (UIImage*)calloc(1, sizeof(UIImage));
-    AssertNew(self);
+    UIImage* self = (UIImage*)UIObject_allocNode(sizeof(UIImage));
 
     UIImage_init(self, objectName, spriteGroup, spriteIndex);
 
@@ -46,12 +45,13 @@ void UIImageVM_onRender(void* self)
     UIObject_getViewportRect(self, &viewportRect);
     SDL_Color colorMod = selfImage->m_colorMod;
 
-    SpriteGroup_setOpacityFloat(selfImage->m_spriteGroup, selfImage->m_opacity);
     UIUtils_renderSprite(
         selfImage->m_spriteGroup,
         selfImage->m_spriteIndex,
         colorMod,
         true,
-        &viewportRect
+        selfImage->m_opacity,
+        &viewportRect,
+        &selfImage->m_spriteGeometry
     );
 }
@@ -20,6 +20,7 @@ typedef struct UIImage
     UIObject m_baseObject;
     SpriteGroup* m_spriteGroup;
     int m_spriteIndex;
+    SpriteGeometry m_spriteGeometry;
     SDL_Color m_colorMod;
     float m_opacity;
 } UIImage;
@@ -36,6 +37,7 @@ INLINE void UIImage_setColorMod(void* self, SDL_Color colorMod)
     assert(UIObject_isOfType(self, UI_TYPE_IMAGE) && "self must be of type UI_TYPE_IMAGE");
     UIImage* selfImage = (UIImage*)self;
     selfImage->m_colorMod = colorMod;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIImage_setOpacity(void* self, float opacity)
@@ -43,6 +45,7 @@ INLINE void UIImage_setOpacity(void* self, float opacity)
     assert(UIObject_isOfType(self, UI_TYPE_IMAGE) && "self must be of type UI_TYPE_IMAGE");
     UIImage* selfImage = (UIImage*)self;
     selfImage->m_opacity = opacity;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIImage_setSpriteIndex(void* self, int spriteIndex)
@@ -50,6 +53,7 @@ INLINE void UIImage_setSpriteIndex(void* self, int spriteIndex)
     assert(UIObject_isOfType(self, UI_TYPE_IMAGE) && "self must be of type UI_TYPE_IMAGE");
     UIImage* selfImage = (UIImage*)self;
     selfImage->m_spriteIndex = spriteIndex;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIImage_setSprite(void* self, SpriteGroup* spriteGroup, int spriteIndex)
@@ -58,4 +62,5 @@ INLINE void UIImage_setSprite(void* self, SpriteGroup* spriteGroup, int spriteIn
     UIImage* selfImage = (UIImage*)self;
     selfImage->m_spriteGroup = spriteGroup;
     selfImage->m_spriteIndex = spriteIndex;
+    UIObject_invalidateVisual(self);
 }
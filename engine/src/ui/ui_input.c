@@ -6,6 +6,7 @@
 
 #include "ui/ui_input.h"
 #include "game_engine_common.h"
+#include "ui/ui_object.h"
 
 void UIInput_init(UIInput* self)
 {
@@ -22,6 +23,7 @@ void UIInput_init(UIInput* self)
     self->clickReleased = false;
     self->cancelPressed = false;
     self->mouseMoved = false;
+    self->wheelY = 0.f;
 
     self->mousePxPos = Vec2_zero;
     self->mouseUIPos = Vec2_set(0, g_sizes.uiSize.y);
@@ -70,6 +72,7 @@ void UIInput_beforeEventLoop(UIInput* self)
     self->clickReleased = false;
     self->cancelPressed = false;
     self->mouseMoved = false;
+    self->wheelY = 0.f;
 }
 
 static void UIInput_processControllerButtonDown(UIInput* self, int button)
@@ -216,6 +219,15 @@ static void UIInput_processMouseButtonUp(UIInput* self, int button)
     }
 }
 
+static void UIInput_processMouseWheel(UIInput* self, const SDL_MouseWheelEvent* wheel)
+{
+    float wheelY = wheel->y;
+    if (wheel->direction == SDL_MOUSEWHEEL_FLIPPED) wheelY = -wheelY;
+
+    self->wheelY += wheelY;
+    self->lastInputType = UI_INPUT_TYPE_MOUSE;
+}
+
 void UIInput_processEvent(UIInput* self, SDL_Event* event)
 {
     assert(self && "self must not be NULL");
@@ -223,6 +235,12 @@ void UIInput_processEvent(UIInput* self, SDL_Event* event)
 
     switch (event->type)
     {
+    case SDL_EVENT_RENDER_TARGETS_RESET:
+    case SDL_EVENT_RENDER_DEVICE_RESET:
+        // Le contenu des caches de rendu de l'interface est perdu
+        UIObject_invalidateRenderCaches(event->type == SDL_EVENT_RENDER_DEVICE_RESET);
+        break;
+
     case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
         UIInput_processControllerButtonDown(self, event->gbutton.button);
         break;
@@ -251,6 +269,10 @@ void UIInput_processEvent(UIInput* self, SDL_Event* event)
         UIInput_processMouseButtonUp(self, event->button.button);
         break;
 
+    case SDL_EVENT_MOUSE_WHEEL:
+        UIInput_processMouseWheel(self, &event->wheel);
+        break;
+
     default:
         break;
     }
@@ -78,6 +78,9 @@ typedef struct UIInput
     bool clickReleased;
     bool cancelPressed;
     bool mouseMoved;
+    /// @brief Défilement vertical de la molette pendant la frame, en crans.
+    /// Une valeur positive correspond à un défilement vers le haut.
+    float wheelY;
     Vec2 mousePxPos;
     Vec2 mouseUIPos;
     Vec2 navDirection;
@@ -9,8 +9,7 @@
 
 UILabel* UILabel_create(const char* objectName, TTF_Font* font)
 {
-    UILabel* self = (UILabel*)calloc(1, sizeof(UILabel));
-    AssertNew(self);
+    UILabel* self = (UILabel*)UIObject_allocNode(sizeof(UILabel));
 
     UILabel_init(self, objectName, font);
 
@@ -27,14 +26,16 @@ void UILabel_init(void* self, const char* objectName, TTF_Font* font)
 
     selfObject->m_type |= UI_TYPE_LABEL;
     selfLabel->m_text = TTF_CreateText(g_textEngine, font, "Label", 0);
-    selfLabel->m_textString = SDL_strdup("Label");
+    selfLabel->m_textString = UIObject_strdup(self, "Label");
     selfLabel->m_color = g_colors.gray0;
     selfLabel->m_anchor = Vec2_anchor_center;
+    UITextCache_init(&selfLabel->m_textCache);
 
     // Virtual methods
     selfObject->m_onRender = UILabelVM_onRender;
     selfObject->m_onUpdate = UILabelVM_onUpdate;
     selfObject->m_onDestroy = UILabelVM_onDestroy;
+    selfObject->m_onGetMemory = UILabelVM_onGetMemory;
 }
 
 void UILabelVM_onRender(void* self)
@@ -45,20 +46,24 @@ void UILabelVM_onRender(void* self)
 
     // Update text
     SDL_Color textColor = selfLabel->m_color;
-    bool success = TTF_SetTextString(ttfText, selfLabel->m_textString, strlen(selfLabel->m_textString));
-    assert(success);
+    UIUtils_updateText(ttfText, selfLabel->m_textString, &selfLabel->m_textCache);
 
     // Render text
     SDL_FRect viewportRect = { 0 };
     UIObject_getViewportRect(selfObj, &viewportRect);
-    UIUtils_renderText(ttfText, &viewportRect, selfLabel->m_anchor, &textColor);
+    UIUtils_renderText(ttfText, &viewportRect, selfLabel->m_anchor, &textColor, &selfLabel->m_textCache);
 }
 
 void UILabelVM_onDestroy(void* self)
 {
     UILabel* selfLabel = (UILabel*)self;
-    SDL_free(selfLabel->m_textString);
+    UIObject_freeMemory(self, selfLabel->m_textString);
     TTF_DestroyText(selfLabel->m_text);
 
     UIObjectVM_onDestroy(self);
 }
+
+size_t UILabelVM_onGetMemory(void* self)
+{
+    return UIUtils_getTextMemory(((UILabel*)self)->m_text);
+}
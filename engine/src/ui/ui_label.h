@@ -13,6 +13,7 @@
 
 void UILabelVM_onRender(void* self);
 void UILabelVM_onDestroy(void* self);
+size_t UILabelVM_onGetMemory(void* self);
 #define UILabelVM_onUpdate UIObjectVM_onUpdate
 
 typedef struct UILabel
@@ -22,6 +23,7 @@ typedef struct UILabel
     char* m_textString;
     SDL_Color m_color;
     Vec2 m_anchor;
+    UITextCache m_textCache;
 } UILabel;
 
 UILabel* UILabel_create(const char* objectName, TTF_Font* font);
@@ -36,6 +38,7 @@ INLINE void UILabel_setColor(void* self, SDL_Color color)
     assert(UIObject_isOfType(self, UI_TYPE_LABEL) && "self must be of type UI_TYPE_LABEL");
     UILabel* selfLabel = (UILabel*)self;
     selfLabel->m_color = color;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UILabel_setAnchor(void* self, Vec2 anchor)
@@ -43,6 +46,7 @@ INLINE void UILabel_setAnchor(void* self, Vec2 anchor)
     assert(UIObject_isOfType(self, UI_TYPE_LABEL) && "self must be of type UI_TYPE_LABEL");
     UILabel* selfLabel = (UILabel*)self;
     selfLabel->m_anchor = anchor;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UILabel_setTextString(void* self, const char* text)
@@ -50,6 +54,9 @@ INLINE void UILabel_setTextString(void* self, const char* text)
     assert(UIObject_isOfType(self, UI_TYPE_LABEL) && "self must be of type UI_TYPE_LABEL");
     UILabel* selfLabel = (UILabel*)self;
     assert(selfLabel->m_textString && "Existing text string must not be NULL");
-    SDL_free(selfLabel->m_textString);
-    selfLabel->m_textString = SDL_strdup(text);
+    if (SDL_strcmp(selfLabel->m_textString, text) == 0) return;
+    UIObject_freeMemory(self, selfLabel->m_textString);
+    selfLabel->m_textString = UIObject_strdup(self, text);
+    UITextCache_invalidate(&selfLabel->m_textCache);
+    UIObject_invalidateVisual(self);
 }
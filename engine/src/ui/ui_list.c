@@ -20,6 +20,8 @@ static void UIList_nextItem(UIList* self)
     }
     if (self->m_itemIdx != prevIdx)
     {
+        UITextCache_invalidate(&self->m_itemCache);
+        UIObject_invalidateVisual(self);
         self->m_onItemChanged(self, self->m_itemIdx, prevIdx, true);
         if (self->m_userOnItemChanged)
         {
@@ -41,6 +43,8 @@ static void UIList_prevItem(UIList* self)
     }
     if (self->m_itemIdx != prevIdx)
     {
+        UITextCache_invalidate(&self->m_itemCache);
+        UIObject_invalidateVisual(self);
         self->m_onItemChanged(self, self->m_itemIdx, prevIdx, false);
         if (self->m_userOnItemChanged)
         {
@@ -92,8 +96,7 @@ static void UIList_updateHandledAction(UIList* self)
 
 UIList* UIList_create(const char* objectName, TTF_Font* font, int itemCount, int configFlags)
 {
-    UIList* self = (UIList*)calloc(1, sizeof(UIList));
-    AssertNew(self);
+    UIList* self = (UIList*)UIObject_allocNode(sizeof(UIList));
 
     UIList_init(self, objectName, font, itemCount, configFlags);
 
@@ -136,14 +139,16 @@ void UIList_init(void* self, const char* objectName, TTF_Font* font, int itemCou
     defaultBackColors[UI_LIST_STATE_DISABLED] = (SDL_Color){ 30, 30, 30, 255 };
 
     // Initialize text contents and colors
-    selfList->m_labelString = SDL_strdup("Label");
-    selfList->m_itemStrings = SDL_malloc(itemCount * sizeof(char*));
+    selfList->m_labelString = UIObject_strdup(self, "Label");
+    selfList->m_itemStrings = (char**)UIObject_allocMemory(self, itemCount * sizeof(char*));
     for (int i = 0; i < itemCount; ++i)
     {
         char buffer[32] = { 0 };
         SDL_snprintf(buffer, sizeof(buffer), "Item %d", i);
-        selfList->m_itemStrings[i] = SDL_strdup(buffer);
+        selfList->m_itemStrings[i] = UIObject_strdup(self, buffer);
     }
+    UITextCache_init(&selfList->m_labelCache);
+    UITextCache_init(&selfList->m_itemCache);
     for (int i = 0; i < UI_LIST_STATE_COUNT; ++i)
     {
         selfList->m_itemColors[i] = defaultTextColors[i];
@@ -210,6 +215,7 @@ void UIList_init(void* self, const char* objectName, TTF_Font* font, int itemCou
     selfObj->m_onDestroy = UIListVM_onDestroy;
     selfObj->m_onRender = UIListVM_onRender;
     selfObj->m_onUpdate = UIListVM_onUpdate;
+    selfObj->m_onGetMemory = UIListVM_onGetMemory;
 
     selfSelectable->m_onFocusChanged = UIListVM_onFocusChanged;
     selfSelectable->m_onFocus = UIListVM_onFocus;
@@ -221,12 +227,12 @@ void UIListVM_onDestroy(void* self)
 {
     UIList* selfList = (UIList*)self;
 
-    SDL_free(selfList->m_labelString);
+    UIObject_freeMemory(self, selfList->m_labelString);
     for (int i = 0; i < selfList->m_itemCount; ++i)
     {
-        SDL_free(selfList->m_itemStrings[i]);
+        UIObject_freeMemory(self, selfList->m_itemStrings[i]);
     }
-    SDL_free(selfList->m_itemStrings);
+    UIObject_freeMemory(self, selfList->m_itemStrings);
 
     TTF_DestroyText(selfList->m_labelText);
     TTF_DestroyText(selfList->m_itemText);
@@ -234,6 +240,12 @@ void UIListVM_onDestroy(void* self)
     UISelectableVM_onDestroy(self);
 }
 
+size_t UIListVM_onGetMemory(void* self)
+{
+    UIList* selfList = (UIList*)self;
+    return UIUtils_getTextMemory(selfList->m_labelText) + UIUtils_getTextMemory(selfList->m_itemText);
+}
+
 
 static void UIList_updateListState(void* self)
 {
@@ -266,9 +278,11 @@ static void UIList_updateListState(void* self)
 
 void UIListVM_onUpdate(void* self)
 {
-    UISelectableVM_onUpdate(self);
     UIObject* selfObj = (UIObject*)self;
     UIList* selfList = (UIList*)self;
+    const bool isLayoutDirty = selfObj->m_transform.isDirty;
+
+    UISelectableVM_onUpdate(self);
     UIFocusState focusState = UISelectable_getFocusState(self);
 
     selfList->m_hasPrevItem = true;
@@ -287,11 +301,19 @@ void UIListVM_onUpdate(void* self)
         UISelectable_setFocusState(selfList->m_nextButton, UI_FOCUS_STATE_DISABLED);
     }
 
+    const UIListState prevState = selfList->m_listState;
     UIList_updateListState(self);
+    if (selfList->m_listState != prevState)
+    {
+        UIObject_invalidateVisual(self);
+    }
     UIList_updateHandledAction(selfList);
 
-    UITransform_updateAABB(&selfList->m_labelTransform, &selfObj->m_transform);
-    UITransform_updateAABB(&selfList->m_itemTransform, &selfObj->m_transform);
+    if (isLayoutDirty)
+    {
+        UITransform_updateAABB(&selfList->m_labelTransform, &selfObj->m_transform);
+        UITransform_updateAABB(&selfList->m_itemTransform, &selfObj->m_transform);
+    }
 }
 
 void UIListVM_onFocusChanged(void* self, UIFocusState currState, UIFocusState prevState)
@@ -318,17 +340,14 @@ void UIListVM_onRender(void* self)
     UIObject* selfObj = (UIObject*)self;
     UISelectable* selfSelectable = (UISelectable*)self;
     UIList* selfList = (UIList*)self;
-    bool success = true;
 
     UIListState state = selfList->m_listState;
     TTF_Text* labelText = selfList->m_labelText;
     TTF_Text* ttfText = selfList->m_itemText;
 
     // Update text
-    success = TTF_SetTextString(labelText, selfList->m_labelString, 0);
-    assert(success);
-    success = TTF_SetTextString(ttfText, selfList->m_itemStrings[selfList->m_itemIdx], 0);
-    assert(success);
+    UIUtils_updateText(labelText, selfList->m_labelString, &selfList->m_labelCache);
+    UIUtils_updateText(ttfText, selfList->m_itemStrings[selfList->m_itemIdx], &selfList->m_itemCache);
 
     SDL_Color itemColor = selfList->m_itemColors[state];
     SDL_Color labelColor = selfList->m_labelColors[state];
@@ -340,14 +359,20 @@ void UIListVM_onRender(void* self)
         selfList->m_spriteIndices[state],
         selfList->m_backColors[state],
         selfList->m_useColorMod,
-        &viewportRect
+        1.f,
+        &viewportRect,
+        &selfList->m_spriteGeometry
     );
 
     UITransform_getViewportRect(&selfList->m_labelTransform, &viewportRect);
-    UIUtils_renderText(labelText, &viewportRect, selfList->m_labelAnchor, &itemColor);
+    UIUtils_renderText(
+        labelText, &viewportRect, selfList->m_labelAnchor, &itemColor, &selfList->m_labelCache
+    );
 
     UITransform_getViewportRect(&selfList->m_itemTransform, &viewportRect);
-    UIUtils_renderText(ttfText, &viewportRect, selfList->m_itemAnchor, &labelColor);
+    UIUtils_renderText(
+        ttfText, &viewportRect, selfList->m_itemAnchor, &labelColor, &selfList->m_itemCache
+    );
 }
 
 static void UIListVM_onMouseFocus(UIList* self, UIInput* input)
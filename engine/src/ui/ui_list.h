@@ -14,6 +14,7 @@
 
 void UIListVM_onRender(void* self);
 void UIListVM_onDestroy(void* self);
+size_t UIListVM_onGetMemory(void* self);
 void UIListVM_onUpdate(void* self);
 void UIListVM_onFocusChanged(void* self, UIFocusState currState, UIFocusState prevState);
 void UIListVM_onFocus(void* self, UIInput* input);
@@ -49,12 +50,15 @@ typedef struct UIList
 
     char* m_labelString;
     char** m_itemStrings;
+    UITextCache m_labelCache;
+    UITextCache m_itemCache;
     SDL_Color m_itemColors[UI_LIST_STATE_COUNT];
     SDL_Color m_labelColors[UI_LIST_STATE_COUNT];
     SDL_Color m_backColors[UI_LIST_STATE_COUNT];
 
     SpriteGroup* m_spriteGroup;
     int m_spriteIndices[UI_BUTTON_STATE_COUNT];
+    SpriteGeometry m_spriteGeometry;
 
     Vec2 m_itemAnchor;
     Vec2 m_labelAnchor;
@@ -86,8 +90,11 @@ INLINE void UIList_setLabelString(void* self, const char* text)
     assert(text && "text must not be NULL");
     UIList* selfList = (UIList*)self;
     assert(selfList->m_labelString && "Existing label string must not be NULL");
-    SDL_free(selfList->m_labelString);
-    selfList->m_labelString = SDL_strdup(text);
+    if (SDL_strcmp(selfList->m_labelString, text) == 0) return;
+    UIObject_freeMemory(self, selfList->m_labelString);
+    selfList->m_labelString = UIObject_strdup(self, text);
+    UITextCache_invalidate(&selfList->m_labelCache);
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIList_setItemString(void* self, int itemIdx, const char* text)
@@ -97,8 +104,14 @@ INLINE void UIList_setItemString(void* self, int itemIdx, const char* text)
     UIList* selfList = (UIList*)self;
     assert(itemIdx >= 0 && itemIdx < selfList->m_itemCount && "itemIdx out of bounds");
     assert(selfList->m_itemStrings[itemIdx] && "Existing item string must not be NULL");
-    SDL_free(selfList->m_itemStrings[itemIdx]);
-    selfList->m_itemStrings[itemIdx] = SDL_strdup(text);
+    if (SDL_strcmp(selfList->m_itemStrings[itemIdx], text) == 0) return;
+    UIObject_freeMemory(self, selfList->m_itemStrings[itemIdx]);
+    selfList->m_itemStrings[itemIdx] = UIObject_strdup(self, text);
+    if (itemIdx == selfList->m_itemIdx)
+    {
+        UITextCache_invalidate(&selfList->m_itemCache);
+    }
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIList_setSelectedItem(void* self, int itemIdx)
@@ -106,7 +119,10 @@ INLINE void UIList_setSelectedItem(void* self, int itemIdx)
     assert(UIObject_isOfType(self, UI_TYPE_LIST) && "self must be of type UI_TYPE_LIST");
     UIList* selfList = (UIList*)self;
     assert(itemIdx >= 0 && itemIdx < selfList->m_itemCount && "itemIdx out of bounds");
+    if (selfList->m_itemIdx == itemIdx) return;
     selfList->m_itemIdx = itemIdx;
+    UITextCache_invalidate(&selfList->m_itemCache);
+    UIObject_invalidateVisual(self);
 }
 
 INLINE int UIList_getSelectedItem(void* self)
@@ -144,6 +160,7 @@ INLINE void UIList_setTextColor(void* self, UIListState state, SDL_Color color)
     assert(UIObject_isOfType(self, UI_TYPE_LIST) && "self must be of type UI_TYPE_LIST");
     UIList* selfList = (UIList*)self;
     selfList->m_itemColors[state] = color;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIList_setBackgroundColor(void* self, UIListState state, SDL_Color color)
@@ -151,6 +168,7 @@ INLINE void UIList_setBackgroundColor(void* self, UIListState state, SDL_Color c
     assert(UIObject_isOfType(self, UI_TYPE_LIST) && "self must be of type UI_TYPE_LIST");
     UIList* selfList = (UIList*)self;
     selfList->m_backColors[state] = color;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIList_setItemAnchor(void* self, Vec2 anchor)
@@ -158,6 +176,7 @@ INLINE void UIList_setItemAnchor(void* self, Vec2 anchor)
     assert(UIObject_isOfType(self, UI_TYPE_LIST) && "self must be of type UI_TYPE_LIST");
     UIList* selfList = (UIList*)self;
     selfList->m_itemAnchor = anchor;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIList_setLabelAnchor(void* self, Vec2 anchor)
@@ -165,6 +184,7 @@ INLINE void UIList_setLabelAnchor(void* self, Vec2 anchor)
     assert(UIObject_isOfType(self, UI_TYPE_LIST) && "self must be of type UI_TYPE_LIST");
     UIList* selfList = (UIList*)self;
     selfList->m_labelAnchor = anchor;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIList_setSpriteGroup(void* self, SpriteGroup* spriteGroup)
@@ -172,6 +192,7 @@ INLINE void UIList_setSpriteGroup(void* self, SpriteGroup* spriteGroup)
     assert(UIObject_isOfType(self, UI_TYPE_LIST) && "self must be of type UI_TYPE_LIST");
     UIList* selfList = (UIList*)self;
     selfList->m_spriteGroup = spriteGroup;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIList_setSpriteIndex(void* self, UIListState state, int spriteIndex)
@@ -179,6 +200,7 @@ INLINE void UIList_setSpriteIndex(void* self, UIListState state, int spriteIndex
     assert(UIObject_isOfType(self, UI_TYPE_LIST) && "self must be of type UI_TYPE_LIST");
     UIList* selfList = (UIList*)self;
     selfList->m_spriteIndices[state] = spriteIndex;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIList_setUseColorMod(void* self, bool useColorMod)
@@ -186,6 +208,7 @@ INLINE void UIList_setUseColorMod(void* self, bool useColorMod)
     assert(UIObject_isOfType(self, UI_TYPE_LIST) && "self must be of type UI_TYPE_LIST");
     UIList* selfList = (UIList*)self;
     selfList->m_useColorMod = useColorMod;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE void UIList_setLabelRect(void* self, UIRect rect)
@@ -193,6 +216,7 @@ INLINE void UIList_setLabelRect(void* self, UIRect rect)
     assert(UIObject_isOfType(self, UI_TYPE_LIST) && "self must be of type UI_TYPE_LIST");
     UIList* selfList = (UIList*)self;
     selfList->m_labelTransform.localRect = rect;
+    UIObject_setLayoutDirty(self);
 }
 
 INLINE void UIList_setItemRect(void* self, UIRect rect)
@@ -200,4 +224,5 @@ INLINE void UIList_setItemRect(void* self, UIRect rect)
     assert(UIObject_isOfType(self, UI_TYPE_LIST) && "self must be of type UI_TYPE_LIST");
     UIList* selfList = (UIList*)self;
     selfList->m_itemTransform.localRect = rect;
+    UIObject_setLayoutDirty(self);
 }
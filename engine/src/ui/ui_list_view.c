@@ -0,0 +1,370 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "ui/ui_list_view.h"
+#include "game_engine_common.h"
+#include "core/render_queue.h"
+
+/// @brief Marge horizontale du texte dans une ligne, en unités de l'interface.
+#define UI_LIST_VIEW_TEXT_PADDING 5.f
+
+UIListView* UIListView_create(const char* objectName, TTF_Font* font, float rowHeight)
+{
+    UIListView* self = (UIListView*)UIObject_allocNode(sizeof(UIListView));
+
+    UIListView_init(self, objectName, font, rowHeight);
+
+    return self;
+}
+
+void UIListView_init(void* self, const char* objectName, TTF_Font* font, float rowHeight)
+{
+    assert(self && "self must not be NULL");
+    assert(rowHeight > 0.f && "rowHeight must be positive");
+
+    UISelectable_init(self, objectName);
+    UIObject* selfObj = (UIObject*)self;
+    UISelectable* selfSelectable = (UISelectable*)self;
+    UIListView* selfView = (UIListView*)self;
+
+    selfObj->m_type |= UI_TYPE_LIST_VIEW;
+    selfView->m_font = font;
+    selfView->m_rowHeight = rowHeight;
+    selfView->m_getItemText = NULL;
+    selfView->m_dataSource = NULL;
+    selfView->m_itemCount = 0;
+    selfView->m_firstItemIdx = 0;
+    selfView->m_selectedIdx = -1;
+    selfView->m_rows = NULL;
+    selfView->m_rowCapacity = 0;
+    selfView->m_visibleRowCount = 0;
+    selfView->m_textAnchor = Vec2_anchor_west;
+
+    selfView->m_textColors[UI_LIST_VIEW_ROW_STATE_NORMAL] = (SDL_Color){ 200, 200, 200, 255 };
+    selfView->m_textColors[UI_LIST_VIEW_ROW_STATE_SELECTED] = (SDL_Color){ 255, 255, 255, 255 };
+    selfView->m_textColors[UI_LIST_VIEW_ROW_STATE_FOCUSED] = (SDL_Color){ 255, 255, 255, 255 };
+    selfView->m_rowColors[UI_LIST_VIEW_ROW_STATE_NORMAL] = (SDL_Color){ 0, 0, 0, 0 };
+    selfView->m_rowColors[UI_LIST_VIEW_ROW_STATE_SELECTED] = (SDL_Color){ 70, 70, 70, 255 };
+    selfView->m_rowColors[UI_LIST_VIEW_ROW_STATE_FOCUSED] = (SDL_Color){ 90, 90, 90, 255 };
+    selfView->m_backColor = (SDL_Color){ 50, 50, 50, 255 };
+
+    selfSelectable->m_handledActionFlags = UI_ACTION_VALIDATE | UI_ACTION_CLICK;
+
+    // Virtual methods
+    selfObj->m_onDestroy = UIListViewVM_onDestroy;
+    selfObj->m_onRender = UIListViewVM_onRender;
+    selfObj->m_onUpdate = UIListViewVM_onUpdate;
+    selfObj->m_onGetMemory = UIListViewVM_onGetMemory;
+
+    selfSelectable->m_onFocus = UIListViewVM_onFocus;
+}
+
+void UIListViewVM_onDestroy(void* self)
+{
+    UIListView* selfView = (UIListView*)self;
+
+    for (int i = 0; i < selfView->m_rowCapacity; i++)
+    {
+        TTF_DestroyText(selfView->m_rows[i].text);
+    }
+    free(selfView->m_rows);
+
+    UISelectableVM_onDestroy(self);
+}
+
+size_t UIListViewVM_onGetMemory(void* self)
+{
+    UIListView* selfView = (UIListView*)self;
+    size_t memory = (size_t)selfView->m_rowCapacity * sizeof(UIListViewRow);
+    for (int i = 0; i < selfView->m_rowCapacity; i++)
+    {
+        memory += UIUtils_getTextMemory(selfView->m_rows[i].text);
+    }
+    return memory;
+}
+
+static void UIListView_reserveRows(UIListView* self, int rowCount)
+{
+    if (rowCount <= self->m_rowCapacity) return;
+
+    UIListViewRow* newRows = (UIListViewRow*)realloc(self->m_rows, rowCount * sizeof(UIListViewRow));
+    AssertNew(newRows);
+    for (int i = self->m_rowCapacity; i < rowCount; i++)
+    {
+        UIListViewRow* row = &newRows[i];
+        row->text = TTF_CreateText(g_textEngine, self->m_font, "", 0);
+        AssertNew(row->text);
+        UITextCache_init(&row->textCache);
+    }
+    self->m_rows = newRows;
+    self->m_rowCapacity = rowCount;
+
+    // L'association entre éléments et lignes dépend du nombre de lignes
+    for (int i = 0; i < self->m_rowCapacity; i++)
+    {
+        self->m_rows[i].itemIdx = -1;
+    }
+}
+
+static void UIListView_fetchRow(UIListView* self, UIListViewRow* row, int itemIdx)
+{
+    char buffer[UI_LIST_VIEW_MAX_TEXT_SIZE] = { 0 };
+    if (self->m_getItemText)
+    {
+        self->m_getItemText(self->m_dataSource, itemIdx, buffer, sizeof(buffer));
+    }
+    row->itemIdx = itemIdx;
+    UITextCache_invalidate(&row->textCache);
+    UIUtils_updateText(row->text, buffer, &row->textCache);
+}
+
+static int UIListView_clampFirstItem(UIListView* self, int firstItemIdx)
+{
+    const int maxFirstItemIdx = Int_max(0, self->m_itemCount - Int_max(1, self->m_visibleRowCount));
+    return Int_clamp(firstItemIdx, 0, maxFirstItemIdx);
+}
+
+void UIListView_setDataSource(void* self, UIListViewGetItemText getItemText, void* dataSource, int itemCount)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    selfView->m_getItemText = getItemText;
+    selfView->m_dataSource = dataSource;
+    UIListView_setItemCount(self, itemCount);
+}
+
+void UIListView_setItemCount(void* self, int itemCount)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    assert(itemCount >= 0 && "itemCount must be positive");
+    UIListView* selfView = (UIListView*)self;
+
+    selfView->m_itemCount = itemCount;
+    if (itemCount == 0)
+    {
+        selfView->m_selectedIdx = -1;
+    }
+    else
+    {
+        selfView->m_selectedIdx = Int_clamp(selfView->m_selectedIdx, 0, itemCount - 1);
+    }
+    selfView->m_firstItemIdx = UIListView_clampFirstItem(selfView, selfView->m_firstItemIdx);
+    UIListView_refresh(self);
+}
+
+void UIListView_refresh(void* self)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    for (int i = 0; i < selfView->m_rowCapacity; i++)
+    {
+        selfView->m_rows[i].itemIdx = -1;
+    }
+    UIObject_invalidateVisual(self);
+}
+
+void UIListView_refreshItem(void* self, int itemIdx)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    if (selfView->m_rowCapacity == 0 || itemIdx < 0) return;
+
+    UIListViewRow* row = &selfView->m_rows[itemIdx % selfView->m_rowCapacity];
+    if (row->itemIdx != itemIdx) return;
+
+    row->itemIdx = -1;
+    UIObject_invalidateVisual(self);
+}
+
+void UIListView_scrollTo(void* self, int firstItemIdx)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    firstItemIdx = UIListView_clampFirstItem(selfView, firstItemIdx);
+    if (selfView->m_firstItemIdx == firstItemIdx) return;
+
+    selfView->m_firstItemIdx = firstItemIdx;
+    UIObject_invalidateVisual(self);
+}
+
+void UIListView_setSelectedItem(void* self, int itemIdx)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    assert(itemIdx >= 0 && itemIdx < selfView->m_itemCount && "itemIdx out of bounds");
+
+    if (itemIdx < selfView->m_firstItemIdx)
+    {
+        UIListView_scrollTo(self, itemIdx);
+    }
+    else if (selfView->m_visibleRowCount > 0 &&
+             itemIdx >= selfView->m_firstItemIdx + selfView->m_visibleRowCount)
+    {
+        UIListView_scrollTo(self, itemIdx - selfView->m_visibleRowCount + 1);
+    }
+
+    if (selfView->m_selectedIdx == itemIdx) return;
+    selfView->m_selectedIdx = itemIdx;
+    UIObject_invalidateVisual(self);
+}
+
+static void UIListView_updateHandledAction(UIListView* self)
+{
+    UISelectable* selfSelectable = (UISelectable*)self;
+    if (selfSelectable->m_focusState == UI_FOCUS_STATE_DISABLED)
+    {
+        selfSelectable->m_handledActionFlags = 0;
+        return;
+    }
+
+    // Aux extrémités, la navigation quitte la liste
+    int actionFlags = UI_ACTION_VALIDATE | UI_ACTION_CLICK;
+    if (self->m_selectedIdx > 0) actionFlags |= UI_ACTION_UP;
+    if (self->m_selectedIdx < self->m_itemCount - 1) actionFlags |= UI_ACTION_DOWN;
+    selfSelectable->m_handledActionFlags = actionFlags;
+}
+
+void UIListViewVM_onUpdate(void* self)
+{
+    UIObject* selfObj = (UIObject*)self;
+    UIListView* selfView = (UIListView*)self;
+
+    UISelectableVM_onUpdate(self);
+
+    Vec2 size = UITransform_getSize(&selfObj->m_transform);
+    const int visibleRowCount = Int_max(1, (int)floorf(size.y / selfView->m_rowHeight + 1e-4f));
+    if (visibleRowCount != selfView->m_visibleRowCount)
+    {
+        UIListView_reserveRows(selfView, visibleRowCount);
+        selfView->m_visibleRowCount = visibleRowCount;
+        selfView->m_firstItemIdx = UIListView_clampFirstItem(selfView, selfView->m_firstItemIdx);
+        UIObject_invalidateVisual(self);
+    }
+
+    // Seuls les éléments devenus visibles sont demandés à la source
+    const int lastItemIdx = Int_min(selfView->m_firstItemIdx + visibleRowCount, selfView->m_itemCount);
+    for (int itemIdx = selfView->m_firstItemIdx; itemIdx < lastItemIdx; itemIdx++)
+    {
+        UIListViewRow* row = &selfView->m_rows[itemIdx % selfView->m_rowCapacity];
+        if (row->itemIdx == itemIdx) continue;
+
+        UIListView_fetchRow(selfView, row, itemIdx);
+        UIObject_invalidateVisual(self);
+    }
+
+    UIListView_updateHandledAction(selfView);
+}
+
+static void UIListView_fillRect(const SDL_FRect* rect, SDL_Color color)
+{
+    if (color.a == 0) return;
+    RenderQueue_drawFillRect(rect, color);
+}
+
+void UIListViewVM_onRender(void* self)
+{
+    UIListView* selfView = (UIListView*)self;
+    const bool isFocused = (UISelectable_getFocusState(self) == UI_FOCUS_STATE_FOCUSED);
+
+    SDL_FRect viewportRect = { 0 };
+    UIObject_getViewportRect(self, &viewportRect);
+    UIListView_fillRect(&viewportRect, selfView->m_backColor);
+
+    const float rowHeight = selfView->m_rowHeight * g_sizes.uiPixelsPerUnit.y;
+    const float padding = UI_LIST_VIEW_TEXT_PADDING * g_sizes.uiPixelsPerUnit.x;
+    const int lastItemIdx = Int_min(selfView->m_firstItemIdx + selfView->m_visibleRowCount, selfView->m_itemCount);
+    for (int itemIdx = selfView->m_firstItemIdx; itemIdx < lastItemIdx; itemIdx++)
+    {
+        UIListViewRow* row = &selfView->m_rows[itemIdx % selfView->m_rowCapacity];
+        if (row->itemIdx != itemIdx)
+        {
+            // La liste a défilé depuis la dernière mise à jour
+            UIListView_fetchRow(selfView, row, itemIdx);
+        }
+
+        UIListViewRowState state = UI_LIST_VIEW_ROW_STATE_NORMAL;
+        if (itemIdx == selfView->m_selectedIdx)
+        {
+            state = isFocused ? UI_LIST_VIEW_ROW_STATE_FOCUSED : UI_LIST_VIEW_ROW_STATE_SELECTED;
+        }
+
+        SDL_FRect rowRect = viewportRect;
+        rowRect.y += (float)(itemIdx - selfView->m_firstItemIdx) * rowHeight;
+        rowRect.h = rowHeight;
+        UIListView_fillRect(&rowRect, selfView->m_rowColors[state]);
+
+        rowRect.x += padding;
+        rowRect.w -= 2.f * padding;
+        UIUtils_renderText(
+            row->text, &rowRect, selfView->m_textAnchor, &selfView->m_textColors[state], &row->textCache
+        );
+    }
+}
+
+static void UIListView_click(UIListView* self)
+{
+    if (self->m_selectedIdx < 0) return;
+    if (self->m_onItemClicked)
+    {
+        self->m_onItemClicked(self, self->m_selectedIdx);
+    }
+}
+
+static void UIListViewVM_onMouseFocus(UIListView* self, UIInput* input)
+{
+    AABB aabb = { 0 };
+    UIObject_getAABB(self, &aabb);
+    if (AABB_containsPoint(&aabb, input->mouseUIPos) == false) return;
+
+    if (input->wheelY != 0.f)
+    {
+        int rowDelta = (int)roundf(input->wheelY * UI_LIST_VIEW_WHEEL_ROWS);
+        UIListView_scrollTo(self, self->m_firstItemIdx - rowDelta);
+    }
+
+    int rowIdx = (int)floorf((aabb.upper.y - input->mouseUIPos.y) / self->m_rowHeight);
+    int itemIdx = self->m_firstItemIdx + rowIdx;
+    if (rowIdx < 0 || rowIdx >= self->m_visibleRowCount || itemIdx >= self->m_itemCount) return;
+
+    if (input->mouseMoved || input->wheelY != 0.f || input->clickPressed)
+    {
+        UIListView_setSelectedItem(self, itemIdx);
+    }
+    if (input->clickPressed)
+    {
+        UIListView_click(self);
+    }
+}
+
+static void UIListViewVM_onControllerFocus(UIListView* self, UIInput* input)
+{
+    if (self->m_itemCount == 0) return;
+
+    int itemIdx = self->m_selectedIdx;
+    if (input->upPressed) itemIdx--;
+    if (input->downPressed) itemIdx++;
+    itemIdx = Int_clamp(itemIdx, 0, self->m_itemCount - 1);
+    UIListView_setSelectedItem(self, itemIdx);
+
+    if (input->validatePressed)
+    {
+        UIListView_click(self);
+    }
+}
+
+void UIListViewVM_onFocus(void* self, UIInput* input)
+{
+    UIListView* selfView = (UIListView*)self;
+
+    if (input->lastInputType == UI_INPUT_TYPE_MOUSE)
+    {
+        UIListViewVM_onMouseFocus(selfView, input);
+    }
+    else
+    {
+        UIListViewVM_onControllerFocus(selfView, input);
+    }
+}
@@ -0,0 +1,185 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+#include "ui/ui_input.h"
+#include "ui/ui_utils.h"
+#include "ui/ui_selectable.h"
+
+void UIListViewVM_onRender(void* self);
+void UIListViewVM_onDestroy(void* self);
+size_t UIListViewVM_onGetMemory(void* self);
+void UIListViewVM_onUpdate(void* self);
+void UIListViewVM_onFocus(void* self, UIInput* input);
+
+/// @brief Taille maximale du texte d'un élément, en octets.
+#define UI_LIST_VIEW_MAX_TEXT_SIZE 256
+
+/// @brief Nombre de lignes parcourues par cran de molette.
+#define UI_LIST_VIEW_WHEEL_ROWS 3
+
+typedef enum UIListViewRowState
+{
+    UI_LIST_VIEW_ROW_STATE_NORMAL = 0,
+    UI_LIST_VIEW_ROW_STATE_SELECTED,
+    UI_LIST_VIEW_ROW_STATE_FOCUSED,
+    UI_LIST_VIEW_ROW_STATE_COUNT
+} UIListViewRowState;
+
+/// @brief Fonction fournissant le texte d'un élément.
+/// @param userData les données de la source.
+/// @param itemIdx l'indice de l'élément.
+/// @param buffer le tampon dans lequel écrire le texte.
+/// @param bufferSize la taille du tampon.
+typedef void (*UIListViewGetItemText)(void* userData, int itemIdx, char* buffer, int bufferSize);
+
+/// @brief Ligne affichée par une UIListView.
+typedef struct UIListViewRow
+{
+    TTF_Text* text;
+    /// @brief Indice de l'élément affiché, ou -1.
+    int itemIdx;
+    UITextCache textCache;
+} UIListViewRow;
+
+/// @brief Liste défilante virtualisée.
+/// Les éléments ne sont pas stockés : leur texte est demandé à une source de
+/// données lorsqu'ils deviennent visibles. Seules les lignes visibles possèdent
+/// un TTF_Text, réutilisé par l'élément qui prend la place d'un élément sorti
+/// de la vue. La mémoire et le coût par frame dépendent du nombre de lignes
+/// visibles et non du nombre d'éléments.
+typedef struct UIListView
+{
+    UISelectable m_baseSelectable;
+
+    TTF_Font* m_font;
+    float m_rowHeight;
+
+    UIListViewGetItemText m_getItemText;
+    void* m_dataSource;
+    int m_itemCount;
+    int m_firstItemIdx;
+    int m_selectedIdx;
+
+    /// @brief Lignes réutilisées ; l'élément i est affiché par la ligne i % m_rowCapacity.
+    UIListViewRow* m_rows;
+    int m_rowCapacity;
+    int m_visibleRowCount;
+
+    SDL_Color m_textColors[UI_LIST_VIEW_ROW_STATE_COUNT];
+    SDL_Color m_rowColors[UI_LIST_VIEW_ROW_STATE_COUNT];
+    SDL_Color m_backColor;
+    Vec2 m_textAnchor;
+
+    void (*m_onItemClicked)(void* self, int itemIdx);
+} UIListView;
+
+/// @brief Crée une liste virtualisée.
+/// @param objectName le nom de l'objet.
+/// @param font la police des éléments.
+/// @param rowHeight la hauteur d'une ligne, en unités de l'interface.
+/// @return La liste créée.
+UIListView* UIListView_create(const char* objectName, TTF_Font* font, float rowHeight);
+void UIListView_init(void* self, const char* objectName, TTF_Font* font, float rowHeight);
+
+INLINE void UIListView_destroy(void* self)
+{
+    UIObject_destroy(self);
+}
+
+/// @brief Définit la source des éléments.
+/// @param self la liste.
+/// @param getItemText la fonction fournissant le texte d'un élément.
+/// @param dataSource les données passées à la fonction.
+/// @param itemCount le nombre d'éléments.
+void UIListView_setDataSource(void* self, UIListViewGetItemText getItemText, void* dataSource, int itemCount);
+
+/// @brief Modifie le nombre d'éléments de la source.
+/// Les lignes visibles redemandent leur texte.
+/// @param self la liste.
+/// @param itemCount le nombre d'éléments.
+void UIListView_setItemCount(void* self, int itemCount);
+
+/// @brief Redemande le texte de toutes les lignes visibles.
+/// @param self la liste.
+void UIListView_refresh(void* self);
+
+/// @brief Redemande le texte d'un élément s'il est visible.
+/// @param self la liste.
+/// @param itemIdx l'indice de l'élément.
+void UIListView_refreshItem(void* self, int itemIdx);
+
+/// @brief Sélectionne un élément et fait défiler la liste pour l'afficher.
+/// @param self la liste.
+/// @param itemIdx l'indice de l'élément.
+void UIListView_setSelectedItem(void* self, int itemIdx);
+
+/// @brief Fait défiler la liste.
+/// @param self la liste.
+/// @param firstItemIdx l'indice du premier élément visible.
+void UIListView_scrollTo(void* self, int firstItemIdx);
+
+INLINE int UIListView_getSelectedItem(void* self)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    return selfView->m_selectedIdx;
+}
+
+INLINE int UIListView_getFirstVisibleItem(void* self)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    return selfView->m_firstItemIdx;
+}
+
+INLINE int UIListView_getItemCount(void* self)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    return selfView->m_itemCount;
+}
+
+INLINE void UIListView_setOnItemClickedCallback(void* self, void (*onItemClicked)(void* self, int itemIdx))
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    selfView->m_onItemClicked = onItemClicked;
+}
+
+INLINE void UIListView_setTextColor(void* self, UIListViewRowState state, SDL_Color color)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    selfView->m_textColors[state] = color;
+    UIObject_invalidateVisual(self);
+}
+
+INLINE void UIListView_setRowColor(void* self, UIListViewRowState state, SDL_Color color)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    selfView->m_rowColors[state] = color;
+    UIObject_invalidateVisual(self);
+}
+
+INLINE void UIListView_setBackgroundColor(void* self, SDL_Color color)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    selfView->m_backColor = color;
+    UIObject_invalidateVisual(self);
+}
+
+INLINE void UIListView_setTextAnchor(void* self, Vec2 anchor)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_LIST_VIEW) && "self must be of type UI_TYPE_LIST_VIEW");
+    UIListView* selfView = (UIListView*)self;
+    selfView->m_textAnchor = anchor;
+    UIObject_invalidateVisual(self);
+}
@@ -6,13 +6,203 @@
 
 #include "ui/ui_object.h"
 #include "game_engine_common.h"
+#include "core/render_queue.h"
+#include "ui/ui_canvas.h"
 
 #define UI_OBJECT_MAGIC_NUMBER 0x1234ABCD
 
+static int s_layoutCount = 0;
+static Uint64 s_updateCount = 0;
+static Uint32 s_layoutRevision = 0;
+
+/// @brief Indique si un cache de rendu est en cours de remplissage.
+static bool s_isRenderingCache = false;
+
+/// @brief Numéros incrémentés lorsque le contenu des textures cibles ou les
+/// textures elles-mêmes sont perdus.
+static Uint32 s_renderTargetsRevision = 0;
+static Uint32 s_renderDeviceRevision = 0;
+
+#define UI_OBJECT_MAX_POOLS 16
+#define UI_OBJECT_POOL_BLOCK_SIZE 32
+
+static MemoryArena* s_currentArena = NULL;
+static bool s_isPoolingEnabled = false;
+static MemoryPool* s_pools[UI_OBJECT_MAX_POOLS] = { 0 };
+static bool s_isPoolTableFullReported = false;
+static UIAllocStats s_allocStats = { 0 };
+
+MemoryArena* UIObject_setArena(MemoryArena* arena)
+{
+    MemoryArena* prevArena = s_currentArena;
+    s_currentArena = arena;
+    return prevArena;
+}
+
+void UIObject_setPoolingEnabled(bool enabled)
+{
+    s_isPoolingEnabled = enabled;
+}
+
+void UIObject_destroyPools()
+{
+    for (int i = 0; i < UI_OBJECT_MAX_POOLS; i++)
+    {
+        if (s_pools[i] == NULL) continue;
+        assert(MemoryPool_getStats(s_pools[i]).usedCount == 0 && "Some UI objects are still alive");
+        MemoryPool_destroy(s_pools[i]);
+        s_pools[i] = NULL;
+    }
+}
+
+/// @brief Renvoie le pool des objets d'une taille donnée.
+/// Les pools sont séparés par taille alignée et non par type : des types de
+/// même taille après alignement partagent un pool.
+/// Si la table des pools est pleine, renvoie NULL et l'objet est alloué sur le tas.
+static MemoryPool* UIObject_getPool(size_t size)
+{
+    for (int i = 0; i < UI_OBJECT_MAX_POOLS; i++)
+    {
+        if (s_pools[i] == NULL)
+        {
+            s_pools[i] = MemoryPool_create(size, UI_OBJECT_POOL_BLOCK_SIZE);
+            return s_pools[i];
+        }
+        if (MemoryPool_getElementSize(s_pools[i]) == MEMORY_ALIGN(size)) return s_pools[i];
+    }
+
+    if (s_isPoolTableFullReported == false)
+    {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "UI object pool table is full (%d sizes), objects of %zu bytes are allocated on the heap",
+            UI_OBJECT_MAX_POOLS, size
+        );
+        s_isPoolTableFullReported = true;
+    }
+    assert(false && "UI_OBJECT_MAX_POOLS is too small");
+    return NULL;
+}
+
+void* UIObject_allocNode(size_t size)
+{
+    assert(size >= sizeof(UIObject));
+    UIObject* node = NULL;
+    if (s_currentArena)
+    {
+        node = (UIObject*)MemoryArena_alloc(s_currentArena, size);
+        node->m_arena = s_currentArena;
+        s_allocStats.arenaAllocCount++;
+        return node;
+    }
+
+    MemoryPool* pool = s_isPoolingEnabled ? UIObject_getPool(size) : NULL;
+    if (pool)
+    {
+        node = (UIObject*)MemoryPool_alloc(pool);
+        node->m_pool = pool;
+        s_allocStats.poolAllocCount++;
+        return node;
+    }
+
+    node = (UIObject*)SDL_calloc(1, size);
+    AssertNew(node);
+    s_allocStats.heapAllocCount++;
+    return node;
+}
+
+static void UIObject_freeNode(UIObject* self)
+{
+    if (self->m_arena) return;
+    if (self->m_pool)
+    {
+        MemoryPool_free(self->m_pool, self);
+        s_allocStats.poolFreeCount++;
+        return;
+    }
+    SDL_free(self);
+    s_allocStats.heapFreeCount++;
+}
+
+/// @brief Renvoie l'arène dans laquelle allouer la mémoire d'un objet.
+/// L'arène de l'objet n'est utilisée que pendant la construction de sa page,
+/// lorsqu'elle est l'arène courante. En dehors, ou pour un objet alloué sur le
+/// tas, la mémoire est allouée sur le tas : elle ne doit pas dépendre de
+/// l'arène d'une autre page.
+static MemoryArena* UIObject_getMemoryArena(void* self)
+{
+    UIObject* selfObj = (UIObject*)self;
+    if (selfObj->m_arena == NULL || selfObj->m_arena != s_currentArena) return NULL;
+    return s_currentArena;
+}
+
+void* UIObject_allocMemory(void* self, size_t size)
+{
+    MemoryArena* arena = UIObject_getMemoryArena(self);
+    if (arena)
+    {
+        s_allocStats.arenaAllocCount++;
+        return MemoryArena_alloc(arena, size);
+    }
+
+    void* memory = SDL_calloc(1, size);
+    AssertNew(memory);
+    s_allocStats.heapAllocCount++;
+    return memory;
+}
+
+char* UIObject_strdup(void* self, const char* str)
+{
+    assert(str && "The string must be valid");
+    MemoryArena* arena = UIObject_getMemoryArena(self);
+    if (arena)
+    {
+        s_allocStats.arenaAllocCount++;
+        return MemoryArena_strdup(arena, str);
+    }
+
+    char* copy = SDL_strdup(str);
+    AssertNew(copy);
+    s_allocStats.heapAllocCount++;
+    return copy;
+}
+
+void UIObject_freeMemory(void* self, void* memory)
+{
+    if (!memory) return;
+    UIObject* selfObj = (UIObject*)self;
+
+    // Les zones allouées après la construction de la page sont sur le tas
+    if (selfObj->m_arena && MemoryArena_contains(selfObj->m_arena, memory)) return;
+
+    SDL_free(memory);
+    s_allocStats.heapFreeCount++;
+}
+
+UIAllocStats UIObject_getAllocStats()
+{
+    return s_allocStats;
+}
+
+void UIObject_resetAllocStats()
+{
+    memset(&s_allocStats, 0, sizeof(UIAllocStats));
+}
+
+static void UIObject_destroyRenderCache(UIObject* self)
+{
+    if (self->m_renderCache == NULL) return;
+    if (self->m_renderCache->texture)
+    {
+        SDL_DestroyTexture(self->m_renderCache->texture);
+    }
+    free(self->m_renderCache);
+    self->m_renderCache = NULL;
+}
+
 UIObject* UIObject_create(const char* objectName)
 {
-    UIObject* self = (UIObject*)calloc(1, sizeof(UIObject));
-    AssertNew(self);
+    UIObject* self = (UIObject*)UIObject_allocNode(sizeof(UIObject));
 
     UIObject_init(self, objectName);
 
@@ -29,17 +219,19 @@ void UIObject_init(void* self, const char* objectName)
     selfObj->m_type = UI_TYPE_OBJECT;
     selfObj->m_enabled = true;
     selfObj->m_objectId = s_nextObjectId++;
-    selfObj->m_objectName = SDL_strdup(objectName);
+    selfObj->m_objectName = UIObject_strdup(self, objectName);
 
     selfObj->m_transform.localRect.anchorMin = Vec2_set(0.f, 0.f);
     selfObj->m_transform.localRect.anchorMax = Vec2_set(1.f, 1.f);
     selfObj->m_transform.localRect.offsetMin = Vec2_set(0.f, 0.f);
     selfObj->m_transform.localRect.offsetMax = Vec2_set(0.f, 0.f);
+    selfObj->m_transform.isDirty = true;
 
     // Virtual methods
     selfObj->m_onRender = UIObjectVM_onRender;
     selfObj->m_onUpdate = UIObjectVM_onUpdate;
     selfObj->m_onDestroy = UIObjectVM_onDestroy;
+    selfObj->m_onGetMemory = UIObjectVM_onGetMemory;
 }
 
 static void UIObject_destroyRecursive(UIObject* self)
@@ -56,8 +248,9 @@ static void UIObject_destroyRecursive(UIObject* self)
 
     // Appel du destructeur virtuel
     self->m_onDestroy(self);
+    UIObject_destroyRenderCache(self);
 
-    free(self);
+    UIObject_freeNode(self);
 }
 
 void UIObject_destroy(void* self)
@@ -76,6 +269,18 @@ bool UIObject_isOfType(void* self, UIType type)
     return (obj->m_type & type) != 0;
 }
 
+/// @brief Renvoie le canvas racine de l'arbre contenant un objet.
+/// @return Le canvas ou NULL si la racine de l'arbre n'est pas un canvas.
+static UICanvas* UIObject_getRootCanvas(UIObject* self)
+{
+    UIObject* root = self;
+    while (root->m_parent)
+    {
+        root = root->m_parent;
+    }
+    return UIObject_isOfType(root, UI_TYPE_CANVAS) ? (UICanvas*)root : NULL;
+}
+
 void UIObject_setParent(void* self, void* parent)
 {
     assert(UIObject_isOfType(self, UI_TYPE_OBJECT) && "self must be of type UI_TYPE_OBJECT");
@@ -85,6 +290,14 @@ void UIObject_setParent(void* self, void* parent)
 
     if (selfObj->m_parent)
     {
+        UIObject_invalidateVisual(selfObj->m_parent);
+
+        UICanvas* canvas = UIObject_getRootCanvas(selfObj->m_parent);
+        if (canvas)
+        {
+            UICanvas_detachObject(canvas, selfObj);
+        }
+
         UIObject* prevChild = NULL;
         UIObject* currChild = selfObj->m_parent->m_firstChild;
         while (currChild)
@@ -106,10 +319,18 @@ void UIObject_setParent(void* self, void* parent)
         }
     }
     selfObj->m_parent = parentObj;
+    selfObj->m_transform.isDirty = true;
+    UIObject_invalidateVisual(selfObj);
     if (parentObj)
     {
         selfObj->m_nextSibling = parentObj->m_firstChild;
         parentObj->m_firstChild = selfObj;
+
+        UICanvas* canvas = UIObject_getRootCanvas(parentObj);
+        if (canvas)
+        {
+            UICanvas_attachObject(canvas, selfObj);
+        }
     }
 }
 
@@ -122,24 +343,170 @@ void UIObject_update(void* self)
     if (selfObj->m_enabled == false) return;
 
     selfObj->m_onUpdate(selfObj);
+    s_updateCount++;
     for (UIObject* child = selfObj->m_firstChild; child != NULL; child = child->m_nextSibling)
     {
         UIObject_update(child);
     }
 }
 
-void UIObject_render(void* self)
+static void UIObject_renderSubtree(UIObject* self)
+{
+    self->m_onRender(self);
+    for (UIObject* child = self->m_firstChild; child != NULL; child = child->m_nextSibling)
+    {
+        UIObject_render(child);
+    }
+}
+
+void UIObject_setRenderCacheEnabled(void* self, bool enabled)
 {
-    UIObject* selfObj = (UIObject*)self;
     assert(UIObject_isOfType(self, UI_TYPE_OBJECT) && "self must be of type UI_TYPE_OBJECT");
+    UIObject* selfObj = (UIObject*)self;
 
-    if (selfObj->m_enabled == false) return;
+    if (enabled == false)
+    {
+        UIObject_destroyRenderCache(selfObj);
+        return;
+    }
+    if (selfObj->m_renderCache) return;
+
+    selfObj->m_renderCache = (UIRenderCache*)calloc(1, sizeof(UIRenderCache));
+    AssertNew(selfObj->m_renderCache);
+    selfObj->m_renderCache->isDirty = true;
+}
+
+size_t UIObject_getMemoryEstimate(void* self)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_OBJECT) && "self must be of type UI_TYPE_OBJECT");
+    UIObject* selfObj = (UIObject*)self;
 
-    selfObj->m_onRender(selfObj);
+    size_t memory = selfObj->m_onGetMemory(selfObj);
+    if (selfObj->m_renderCache && selfObj->m_renderCache->texture)
+    {
+        const SDL_Texture* texture = selfObj->m_renderCache->texture;
+        memory += (size_t)texture->w * (size_t)texture->h * 4;
+    }
     for (UIObject* child = selfObj->m_firstChild; child != NULL; child = child->m_nextSibling)
     {
-        UIObject_render(child);
+        memory += UIObject_getMemoryEstimate(child);
+    }
+    return memory;
+}
+
+void UIObject_invalidateRenderCaches(bool isDeviceLost)
+{
+    s_renderTargetsRevision++;
+    if (isDeviceLost)
+    {
+        s_renderDeviceRevision++;
+    }
+}
+
+void UIObject_invalidateVisual(void* self)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_OBJECT) && "self must be of type UI_TYPE_OBJECT");
+    for (UIObject* object = (UIObject*)self; object != NULL; object = object->m_parent)
+    {
+        if (object->m_renderCache)
+        {
+            object->m_renderCache->isDirty = true;
+        }
+    }
+}
+
+/// @brief Dessine le sous-arbre d'un objet dans sa texture de cache si
+/// nécessaire, puis dessine cette texture.
+/// @return false si le sous-arbre doit être dessiné sans cache.
+static bool UIObject_renderCached(UIObject* self)
+{
+    UIRenderCache* cache = self->m_renderCache;
+
+    // Un cache imbriqué est dessiné directement pendant le remplissage de son parent
+    if (s_isRenderingCache) return false;
+
+    SDL_FRect viewportRect = { 0 };
+    UIObject_getViewportRect(self, &viewportRect);
+
+    // La texture est alignée sur les pixels pour éviter le filtrage
+    SDL_FRect rect = { 0 };
+    rect.x = floorf(viewportRect.x);
+    rect.y = floorf(viewportRect.y);
+    rect.w = ceilf(viewportRect.x + viewportRect.w) - rect.x;
+    rect.h = ceilf(viewportRect.y + viewportRect.h) - rect.y;
+    if (rect.w < 1.f || rect.h < 1.f) return false;
+
+    if (rect.x != cache->rect.x || rect.y != cache->rect.y ||
+        rect.w != cache->rect.w || rect.h != cache->rect.h ||
+        cache->drawGizmos != g_drawUIGizmos ||
+        cache->targetsRevision != s_renderTargetsRevision)
+    {
+        cache->isDirty = true;
+    }
+
+    if (cache->texture == NULL || cache->texture->w != (int)rect.w || cache->texture->h != (int)rect.h ||
+        cache->deviceRevision != s_renderDeviceRevision)
+    {
+        if (cache->texture)
+        {
+            SDL_DestroyTexture(cache->texture);
+        }
+        cache->texture = SDL_CreateTexture(
+            g_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, (int)rect.w, (int)rect.h
+        );
+        if (cache->texture == NULL)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "UIObject_renderCached");
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "%s", SDL_GetError());
+            return false;
+        }
+        // Le contenu de la texture est prémultiplié par l'alpha
+        SDL_SetTextureBlendMode(cache->texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        SDL_SetTextureScaleMode(cache->texture, SDL_SCALEMODE_NEAREST);
+        cache->deviceRevision = s_renderDeviceRevision;
+        cache->isDirty = true;
+    }
+
+    if (cache->isDirty)
+    {
+        RenderQueue* mainQueue = RenderQueue_swapCurrent(NULL);
+        SDL_Texture* prevTarget = SDL_GetRenderTarget(g_renderer);
+
+        s_isRenderingCache = true;
+        RenderQueue_begin(g_uiCacheQueue);
+        UIObject_renderSubtree(self);
+        s_isRenderingCache = false;
+
+        SDL_SetRenderTarget(g_renderer, cache->texture);
+        SDL_SetRenderDrawColor(g_renderer, 0, 0, 0, 0);
+        SDL_RenderClear(g_renderer);
+        RenderQueue_setOffset(g_uiCacheQueue, -rect.x, -rect.y);
+        RenderQueue_end(g_uiCacheQueue);
+        SDL_SetRenderTarget(g_renderer, prevTarget);
+
+        RenderQueue_swapCurrent(mainQueue);
+
+        cache->rect = rect;
+        cache->drawGizmos = g_drawUIGizmos;
+        cache->targetsRevision = s_renderTargetsRevision;
+        cache->isDirty = false;
     }
+
+    SDL_FColor color = { 1.f, 1.f, 1.f, 1.f };
+    RenderQueue_drawTexture(cache->texture, NULL, &rect, color);
+    return true;
+}
+
+void UIObject_render(void* self)
+{
+    UIObject* selfObj = (UIObject*)self;
+    assert(UIObject_isOfType(self, UI_TYPE_OBJECT) && "self must be of type UI_TYPE_OBJECT");
+
+    if (selfObj->m_enabled == false) return;
+
+    if (selfObj->m_renderCache && UIObject_renderCached(selfObj)) return;
+
+    UIObject_renderSubtree(selfObj);
 }
 
 void UIObjectVM_onRender(void* self)
@@ -148,21 +515,58 @@ void UIObjectVM_onRender(void* self)
     UIObject* selfObj = (UIObject*)self;
     SDL_FRect viewportRect = { 0 };
     UIObject_getViewportRect(selfObj, &viewportRect);
-    SDL_SetRenderDrawColor(g_renderer, 0, 255, 255, 255);
-    SDL_RenderRect(g_renderer, &viewportRect);
+    SDL_Color color = { 0, 255, 255, 255 };
+    RenderQueue_drawRect(&viewportRect, color);
 }
 
 void UIObjectVM_onUpdate(void* self)
 {
     UIObject* selfObj = (UIObject*)self;
+    if (selfObj->m_transform.isDirty == false) return;
+
     UITransform_updateAABB(&selfObj->m_transform, selfObj->m_parent ? &selfObj->m_parent->m_transform : NULL);
+    selfObj->m_transform.isDirty = false;
+    s_layoutCount++;
+    s_layoutRevision++;
+    UIObject_invalidateVisual(selfObj);
+
+    // Les enfants sont mis à jour après leur parent
+    for (UIObject* child = selfObj->m_firstChild; child != NULL; child = child->m_nextSibling)
+    {
+        child->m_transform.isDirty = true;
+    }
+}
+
+int UIObject_getLayoutCount()
+{
+    return s_layoutCount;
+}
+
+void UIObject_resetLayoutCount()
+{
+    s_layoutCount = 0;
+}
+
+Uint64 UIObject_getUpdateCount()
+{
+    return s_updateCount;
+}
+
+Uint32 UIObject_getLayoutRevision()
+{
+    return s_layoutRevision;
 }
 
 void UIObjectVM_onDestroy(void* self)
 {
     UIObject* selfObj = (UIObject*)self;
     //printf("Freeing UIObject '%s'\n", selfObj->m_objectName);
-    SDL_free(selfObj->m_objectName);
+    UIObject_freeMemory(selfObj, selfObj->m_objectName);
+}
+
+size_t UIObjectVM_onGetMemory(void* self)
+{
+    return 0;
 }
 
 void UIObject_getViewportRect(void* self, SDL_FRect* outRect)
@@ -8,12 +8,14 @@
 
 #include "game_engine_settings.h"
 #include "ui/ui_utils.h"
+#include "utils/memory_arena.h"
 
 typedef struct UIObject UIObject;
 
 void UIObjectVM_onRender(void* self);
 void UIObjectVM_onUpdate(void* self);
 void UIObjectVM_onDestroy(void* self);
+size_t UIObjectVM_onGetMemory(void* self);
 
 typedef enum UIType
 {
@@ -26,8 +28,25 @@ typedef enum UIType
     UI_TYPE_LABEL = 0x0040,
     UI_TYPE_IMAGE = 0x0080,
     UI_TYPE_FILL_RECT = 0x0100,
+    UI_TYPE_LIST_VIEW = 0x0200,
 } UIType;
 
+/// @brief Texture contenant le rendu d'un sous-arbre statique de l'interface.
+typedef struct UIRenderCache
+{
+    SDL_Texture* texture;
+    /// @brief Rectangle du sous-arbre dans le viewport, aligné sur les pixels.
+    SDL_FRect rect;
+    /// @brief Indique si la texture doit être redessinée.
+    bool isDirty;
+    /// @brief Valeur de g_drawUIGizmos lors du dernier dessin.
+    bool drawGizmos;
+    /// @brief Numéro de réinitialisation des cibles de rendu lors du dernier dessin.
+    Uint32 targetsRevision;
+    /// @brief Numéro de réinitialisation du périphérique de rendu à la création de la texture.
+    Uint32 deviceRevision;
+} UIRenderCache;
+
 struct UIObject
 {
     int m_magicNumber;
@@ -41,11 +60,87 @@ struct UIObject
     UIObject* m_firstChild;
     UIObject* m_nextSibling;
 
+    /// @brief Cache de rendu du sous-arbre, ou NULL si l'objet est dessiné à chaque frame.
+    UIRenderCache* m_renderCache;
+
+    /// @brief Arène ou pool contenant l'objet, ou NULL s'il est alloué sur le tas.
+    MemoryArena* m_arena;
+    MemoryPool* m_pool;
+
     void (*m_onRender)(void* self);
     void (*m_onUpdate)(void* self);
     void (*m_onDestroy)(void* self);
+    /// @brief Renvoie la mémoire possédée par l'objet hors de son nœud,
+    /// comme ses textes SDL_ttf.
+    size_t (*m_onGetMemory)(void* self);
 };
 
+/// @brief Statistiques d'allocation de l'interface.
+typedef struct UIAllocStats
+{
+    /// @brief Nombre d'allocations et de libérations sur le tas.
+    int heapAllocCount;
+    int heapFreeCount;
+    /// @brief Nombre d'allocations dans une arène.
+    int arenaAllocCount;
+    /// @brief Nombre d'allocations et de libérations dans un pool.
+    int poolAllocCount;
+    int poolFreeCount;
+} UIAllocStats;
+
+/// @brief Définit l'arène utilisée par les objets créés ensuite.
+/// Les objets, leurs noms et leurs chaînes initiales sont alloués dans
+/// l'arène ; les objets doivent être détruits avant la remise à zéro de
+/// l'arène, qui libère alors leur mémoire en une fois.
+/// L'arène ne doit être définie que pendant la construction d'une page et
+/// l'arène précédente restaurée ensuite.
+/// @param arena l'arène, ou NULL pour allouer sur le tas.
+/// @return L'arène utilisée précédemment.
+MemoryArena* UIObject_setArena(MemoryArena* arena);
+
+/// @brief Active les pools d'objets.
+/// En dehors d'une arène, les objets sont alors alloués dans un pool par
+/// taille d'objet, ce qui évite les allocations système pour les objets créés
+/// et détruits pendant l'exécution.
+/// @param enabled true pour activer les pools.
+void UIObject_setPoolingEnabled(bool enabled);
+
+/// @brief Détruit les pools d'objets.
+/// Tous les objets alloués dans un pool doivent avoir été détruits.
+void UIObject_destroyPools();
+
+/// @brief Alloue un objet de l'interface, initialisé à zéro.
+/// @param size la taille de l'objet.
+/// @return L'objet alloué.
+void* UIObject_allocNode(size_t size);
+
+/// @brief Alloue une zone mémoire appartenant à un objet, initialisée à zéro.
+/// La zone est allouée dans l'arène de l'objet si elle est l'arène courante,
+/// c'est-à-dire pendant la construction de sa page, et sur le tas sinon.
+/// @param self l'objet propriétaire de la zone.
+/// @param size la taille en octets.
+/// @return La zone allouée.
+void* UIObject_allocMemory(void* self, size_t size);
+
+/// @brief Copie une chaîne appartenant à un objet.
+/// La copie est allouée comme avec UIObject_allocMemory().
+/// @param self l'objet propriétaire de la chaîne.
+/// @param str la chaîne à copier.
+/// @return La copie.
+char* UIObject_strdup(void* self, const char* str);
+
+/// @brief Libère une zone allouée par UIObject_allocMemory() ou UIObject_strdup().
+/// Les zones appartenant à l'arène de l'objet sont libérées avec l'arène.
+/// @param self l'objet propriétaire de la zone.
+/// @param memory la zone mémoire.
+void UIObject_freeMemory(void* self, void* memory);
+
+/// @brief Renvoie les statistiques d'allocation depuis le dernier appel à
+/// UIObject_resetAllocStats().
+UIAllocStats UIObject_getAllocStats();
+
+void UIObject_resetAllocStats();
+
 UIObject* UIObject_create(const char* objectName);
 void UIObject_destroy(void* self);
 void UIObject_init(void* self, const char* objectName);
@@ -61,18 +156,76 @@ const char* UIObject_getObjectName(void* self);
 void UIObject_update(void* self);
 void UIObject_render(void* self);
 
+/// @brief Demande le recalcul de la disposition d'un objet et de ses descendants
+/// lors de la prochaine mise à jour.
+/// @param self l'objet.
+void UIObject_setLayoutDirty(void* self);
+
+/// @brief Renvoie le nombre d'objets dont la disposition a été recalculée
+/// depuis le dernier appel à UIObject_resetLayoutCount().
+int UIObject_getLayoutCount();
+
+/// @brief Remet à zéro le compteur de dispositions recalculées.
+/// Cette fonction est appelée au début de chaque frame.
+void UIObject_resetLayoutCount();
+
+/// @brief Renvoie le nombre total d'objets mis à jour par UIObject_update().
+/// Il n'est jamais remis à zéro : le nombre d'objets mis à jour pendant une
+/// période est la différence de deux lectures.
+Uint64 UIObject_getUpdateCount();
+
+/// @brief Renvoie un numéro incrémenté à chaque recalcul de disposition.
+/// Il n'est jamais remis à zéro et permet de savoir si des boîtes englobantes
+/// ont changé depuis une lecture précédente.
+Uint32 UIObject_getLayoutRevision();
+
+/// @brief Active ou désactive le cache de rendu d'un objet.
+/// Lorsqu'il est actif, l'objet et ses descendants sont dessinés dans une
+/// texture qui n'est redessinée qu'après une modification de leur apparence.
+/// @param self l'objet.
+/// @param enabled true pour activer le cache.
+void UIObject_setRenderCacheEnabled(void* self, bool enabled);
+
+/// @brief Signale que l'apparence d'un objet a changé.
+/// Les caches de rendu de l'objet et de ses ancêtres seront redessinés.
+/// @param self l'objet.
+void UIObject_invalidateVisual(void* self);
+
+/// @brief Renvoie une estimation de la mémoire utilisée par un objet et ses
+/// descendants hors de leurs nœuds : textures des caches de rendu (4 octets
+/// par pixel) et textes SDL_ttf.
+/// @param self l'objet.
+/// @return La mémoire estimée en octets.
+size_t UIObject_getMemoryEstimate(void* self);
+
+/// @brief Invalide tous les caches de rendu de l'interface.
+/// Doit être appelée lors des événements SDL_EVENT_RENDER_TARGETS_RESET et
+/// SDL_EVENT_RENDER_DEVICE_RESET, qui font perdre le contenu des textures
+/// cibles (Direct3D). Les caches sont redessinés lors de leur prochain rendu.
+/// @param isDeviceLost true si les textures doivent aussi être recréées.
+void UIObject_invalidateRenderCaches(bool isDeviceLost);
+
 bool UIObject_isOfType(void* self, UIType type);
 
 INLINE void UIObject_setRect(void* self, UIRect rect)
 {
     assert(UIObject_isOfType(self, UI_TYPE_OBJECT) && "self must be of type UI_TYPE_OBJECT");
     ((UIObject*)self)->m_transform.localRect = rect;
+    ((UIObject*)self)->m_transform.isDirty = true;
+}
+
+INLINE void UIObject_setLayoutDirty(void* self)
+{
+    assert(UIObject_isOfType(self, UI_TYPE_OBJECT) && "self must be of type UI_TYPE_OBJECT");
+    ((UIObject*)self)->m_transform.isDirty = true;
 }
 
 INLINE void UIObject_setEnabled(void* self, bool enabled)
 {
     assert(UIObject_isOfType(self, UI_TYPE_OBJECT) && "self must be of type UI_TYPE_OBJECT");
+    if (((UIObject*)self)->m_enabled == enabled) return;
     ((UIObject*)self)->m_enabled = enabled;
+    UIObject_invalidateVisual(self);
 }
 
 INLINE bool UIObject_isEnabled(void* self)
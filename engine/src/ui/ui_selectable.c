@@ -6,11 +6,11 @@
 
 #include "ui/ui_selectable.h"
 #include "game_engine_common.h"
+#include "core/render_queue.h"
 
 UISelectable* UISelectable_create(const char* objectName)
 {
-    UISelectable* self = (UISelectable*)calloc(1, sizeof(UISelectable));
-    AssertNew(self);
+    UISelectable* self = (UISelectable*)UIObject_allocNode(sizeof(UISelectable));
 
     UISelectable_init(self, objectName);
 
@@ -40,6 +40,13 @@ void UISelectable_init(void* self, const char* objectName)
     selfSelectable->m_focusState = UI_FOCUS_STATE_NORMAL;
 }
 
+static Uint32 s_stateRevision = 0;
+
+Uint32 UISelectable_getStateRevision()
+{
+    return s_stateRevision;
+}
+
 void UISelectable_setFocusState(void* self, UIFocusState state)
 {
     UISelectable* selfSelectable = (UISelectable*)self;
@@ -49,6 +56,8 @@ void UISelectable_setFocusState(void* self, UIFocusState state)
 
     int prevState = selfSelectable->m_focusState;
     selfSelectable->m_focusState = state;
+    s_stateRevision++;
+    UIObject_invalidateVisual(self);
 
     selfSelectable->m_onFocusChanged(selfSelectable, state, prevState);
     if (selfSelectable->m_userOnFocusChanged)
@@ -62,21 +71,22 @@ void UISelectableVM_onRender(void* self)
     UIObject* selfObj = (UIObject*)self;
     UISelectable* selfSelectable = (UISelectable*)self;
 
+    SDL_Color color = { 0, 255, 255, 255 };
     switch (selfSelectable->m_focusState)
     {
     default:
     case UI_FOCUS_STATE_NORMAL:
-        SDL_SetRenderDrawColor(g_renderer, 0, 255, 255, 255);
         break;
 
     case UI_FOCUS_STATE_FOCUSED:
-        SDL_SetRenderDrawColor(g_renderer, 255, 255, 255, 255);
+        color.r = 255;
         break;
     }
 
     SDL_FRect viewportRect = { 0 };
     UIObject_getViewportRect(selfObj, &viewportRect);
-    SDL_RenderFillRect(g_renderer, &viewportRect);
+
+    RenderQueue_drawFillRect(&viewportRect, color);
 }
 
 void UISelectableVM_onFocusChanged(void* self, UIFocusState currState, UIFocusState prevState)
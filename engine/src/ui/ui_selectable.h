@@ -68,6 +68,10 @@ INLINE bool UISelectable_shouldHandleAction(void* self, int actionFlags)
 
 void UISelectable_setFocusState(void* self, UIFocusState state);
 
+/// @brief Renvoie un numéro incrémenté à chaque changement d'état de focus
+/// d'un objet sélectionnable. Il n'est jamais remis à zéro.
+Uint32 UISelectable_getStateRevision();
+
 INLINE UIFocusState UISelectable_getFocusState(void* self)
 {
     assert(UIObject_isOfType(self, UI_TYPE_SELECTABLE) && "self must be of type UI_TYPE_SELECTABLE");
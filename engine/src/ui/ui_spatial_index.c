@@ -0,0 +1,304 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "ui/ui_spatial_index.h"
+#include "game_engine_common.h"
+
+/// @brief Nombre maximal de cellules par élément, pour borner la mémoire de la
+/// grille lorsque les éléments sont petits et dispersés.
+#define UI_SPATIAL_INDEX_MAX_CELLS_PER_ITEM 4
+#define UI_SPATIAL_INDEX_MIN_CELL_SIZE 1.f
+
+UISpatialIndex* UISpatialIndex_create()
+{
+    UISpatialIndex* self = (UISpatialIndex*)calloc(1, sizeof(UISpatialIndex));
+    AssertNew(self);
+
+    return self;
+}
+
+void UISpatialIndex_destroy(UISpatialIndex* self)
+{
+    if (!self) return;
+
+    free(self->m_boxes);
+    free(self->m_cellStart);
+    free(self->m_cellItems);
+    free(self);
+}
+
+size_t UISpatialIndex_getMemory(UISpatialIndex* self)
+{
+    assert(self && "self must not be NULL");
+    return sizeof(UISpatialIndex)
+        + (size_t)self->m_itemCapacity * sizeof(AABB)
+        + (size_t)self->m_cellCapacity * sizeof(int)
+        + (size_t)self->m_cellItemCapacity * sizeof(int);
+}
+
+static int UISpatialIndex_getColumn(UISpatialIndex* self, float x)
+{
+    int column = (int)floorf((x - self->m_origin.x) / self->m_cellSize);
+    return Int_clamp(column, 0, self->m_columnCount - 1);
+}
+
+static int UISpatialIndex_getRow(UISpatialIndex* self, float y)
+{
+    int row = (int)floorf((y - self->m_origin.y) / self->m_cellSize);
+    return Int_clamp(row, 0, self->m_rowCount - 1);
+}
+
+static void UISpatialIndex_reserve(UISpatialIndex* self, int itemCount, int cellCount)
+{
+    if (itemCount > self->m_itemCapacity)
+    {
+        int newCapacity = SDL_max(itemCount, 2 * self->m_itemCapacity);
+        AABB* newBoxes = (AABB*)realloc(self->m_boxes, newCapacity * sizeof(AABB));
+        AssertNew(newBoxes);
+        self->m_boxes = newBoxes;
+        self->m_itemCapacity = newCapacity;
+    }
+    if (cellCount + 1 > self->m_cellCapacity)
+    {
+        int newCapacity = SDL_max(cellCount + 1, 2 * self->m_cellCapacity);
+        int* newCellStart = (int*)realloc(self->m_cellStart, newCapacity * sizeof(int));
+        AssertNew(newCellStart);
+        self->m_cellStart = newCellStart;
+        self->m_cellCapacity = newCapacity;
+    }
+}
+
+void UISpatialIndex_build(UISpatialIndex* self, const AABB* boxes, int count)
+{
+    assert(self && "self must not be NULL");
+    assert((boxes || count == 0) && "boxes must not be NULL");
+
+    self->m_itemCount = count;
+    self->m_columnCount = 0;
+    self->m_rowCount = 0;
+    if (count == 0) return;
+
+    // Taille des cellules proche de la taille moyenne des éléments
+    AABB bounds = boxes[0];
+    float sizeSum = 0.f;
+    for (int i = 0; i < count; i++)
+    {
+        const AABB* box = &boxes[i];
+        bounds.lower.x = fminf(bounds.lower.x, box->lower.x);
+        bounds.lower.y = fminf(bounds.lower.y, box->lower.y);
+        bounds.upper.x = fmaxf(bounds.upper.x, box->upper.x);
+        bounds.upper.y = fmaxf(bounds.upper.y, box->upper.y);
+        Vec2 size = AABB_getSize(box);
+        sizeSum += fmaxf(size.x, size.y);
+    }
+    Vec2 boundsSize = AABB_getSize(&bounds);
+    float cellSize = fmaxf(sizeSum / (float)count, UI_SPATIAL_INDEX_MIN_CELL_SIZE);
+    int columnCount = 0;
+    int rowCount = 0;
+    for (;;)
+    {
+        columnCount = (int)(boundsSize.x / cellSize) + 1;
+        rowCount = (int)(boundsSize.y / cellSize) + 1;
+        if (columnCount * rowCount <= UI_SPATIAL_INDEX_MAX_CELLS_PER_ITEM * count) break;
+        cellSize *= 2.f;
+    }
+    const int cellCount = columnCount * rowCount;
+
+    UISpatialIndex_reserve(self, count, cellCount);
+    memcpy(self->m_boxes, boxes, count * sizeof(AABB));
+    self->m_origin = bounds.lower;
+    self->m_cellSize = cellSize;
+    self->m_columnCount = columnCount;
+    self->m_rowCount = rowCount;
+
+    // Nombre d'éléments par cellule
+    int* cellStart = self->m_cellStart;
+    memset(cellStart, 0, (cellCount + 1) * sizeof(int));
+    for (int i = 0; i < count; i++)
+    {
+        const AABB* box = &self->m_boxes[i];
+        const int x0 = UISpatialIndex_getColumn(self, box->lower.x);
+        const int x1 = UISpatialIndex_getColumn(self, box->upper.x);
+        const int y0 = UISpatialIndex_getRow(self, box->lower.y);
+        const int y1 = UISpatialIndex_getRow(self, box->upper.y);
+        for (int y = y0; y <= y1; y++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                cellStart[y * columnCount + x]++;
+            }
+        }
+    }
+
+    // Fin de chaque cellule
+    for (int c = 1; c <= cellCount; c++)
+    {
+        cellStart[c] += cellStart[c - 1];
+    }
+    const int cellItemCount = cellStart[cellCount];
+    if (cellItemCount > self->m_cellItemCapacity)
+    {
+        int newCapacity = SDL_max(cellItemCount, 2 * self->m_cellItemCapacity);
+        int* newCellItems = (int*)realloc(self->m_cellItems, newCapacity * sizeof(int));
+        AssertNew(newCellItems);
+        self->m_cellItems = newCellItems;
+        self->m_cellItemCapacity = newCapacity;
+    }
+
+    // Remplissage à rebours : les indices sont croissants dans chaque cellule
+    // et cellStart contient à la fin le début de chaque cellule
+    for (int i = count - 1; i >= 0; i--)
+    {
+        const AABB* box = &self->m_boxes[i];
+        const int x0 = UISpatialIndex_getColumn(self, box->lower.x);
+        const int x1 = UISpatialIndex_getColumn(self, box->upper.x);
+        const int y0 = UISpatialIndex_getRow(self, box->lower.y);
+        const int y1 = UISpatialIndex_getRow(self, box->upper.y);
+        for (int y = y0; y <= y1; y++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                self->m_cellItems[--cellStart[y * columnCount + x]] = i;
+            }
+        }
+    }
+}
+
+int UISpatialIndex_queryPoint(
+    UISpatialIndex* self, Vec2 point,
+    UISpatialIndexFilter filter, void* userData)
+{
+    assert(self && "self must not be NULL");
+    if (self->m_itemCount == 0) return -1;
+
+    const float x = (point.x - self->m_origin.x) / self->m_cellSize;
+    const float y = (point.y - self->m_origin.y) / self->m_cellSize;
+    if (x < 0.f || y < 0.f || x > (float)self->m_columnCount || y > (float)self->m_rowCount) return -1;
+
+    const int cell = UISpatialIndex_getRow(self, point.y) * self->m_columnCount
+        + UISpatialIndex_getColumn(self, point.x);
+    for (int k = self->m_cellStart[cell]; k < self->m_cellStart[cell + 1]; k++)
+    {
+        const int itemIdx = self->m_cellItems[k];
+        if (AABB_containsPoint(&self->m_boxes[itemIdx], point) == false) continue;
+        if (filter && filter(userData, itemIdx) == false) continue;
+        return itemIdx;
+    }
+    return -1;
+}
+
+typedef struct UISpatialDirectionQuery
+{
+    int fromIdx;
+    AABB fromBox;
+    Vec2 direction;
+    Vec2 directionPerp;
+    float penaltyFactor;
+    UISpatialIndexFilter filter;
+    void* userData;
+
+    int bestIdx;
+    float bestDistance;
+} UISpatialDirectionQuery;
+
+static void UISpatialIndex_visitCell(UISpatialIndex* self, UISpatialDirectionQuery* query, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= self->m_columnCount || y >= self->m_rowCount) return;
+
+    const int cell = y * self->m_columnCount + x;
+    for (int k = self->m_cellStart[cell]; k < self->m_cellStart[cell + 1]; k++)
+    {
+        const int itemIdx = self->m_cellItems[k];
+        if (itemIdx == query->fromIdx) continue;
+
+        const AABB* box = &self->m_boxes[itemIdx];
+        Vec2 shortestVector = AABB_shortestVector(&query->fromBox, box);
+
+        float proj = Vec2_dot(shortestVector, query->direction);
+        if (proj <= 0.f) continue;
+
+        float perpProj = Vec2_dot(shortestVector, query->directionPerp);
+        float distance = proj + fabsf(perpProj) * query->penaltyFactor;
+        if (distance > query->bestDistance + 1e-5f) continue;
+
+        // Départage des égalités par la position puis par l'indice
+        if (query->bestIdx >= 0 && distance >= query->bestDistance - 1e-5f)
+        {
+            const AABB* bestBox = &self->m_boxes[query->bestIdx];
+            if (box->lower.x > bestBox->lower.x) continue;
+            if (box->lower.x == bestBox->lower.x && itemIdx > query->bestIdx) continue;
+        }
+        if (query->filter && query->filter(query->userData, itemIdx) == false) continue;
+
+        query->bestIdx = itemIdx;
+        query->bestDistance = distance;
+    }
+}
+
+int UISpatialIndex_queryDirection(
+    UISpatialIndex* self, int itemIdx, Vec2 direction, float penaltyFactor,
+    UISpatialIndexFilter filter, void* userData)
+{
+    assert(self && "self must not be NULL");
+    assert(itemIdx >= 0 && itemIdx < self->m_itemCount && "itemIdx out of bounds");
+
+    UISpatialDirectionQuery query = { 0 };
+    query.fromIdx = itemIdx;
+    query.fromBox = self->m_boxes[itemIdx];
+    query.direction = direction;
+    query.directionPerp = Vec2_perp(direction);
+    query.penaltyFactor = penaltyFactor;
+    query.filter = filter;
+    query.userData = userData;
+    query.bestIdx = -1;
+    query.bestDistance = INFINITY;
+
+    const int x0 = UISpatialIndex_getColumn(self, query.fromBox.lower.x);
+    const int x1 = UISpatialIndex_getColumn(self, query.fromBox.upper.x);
+    const int y0 = UISpatialIndex_getRow(self, query.fromBox.lower.y);
+    const int y1 = UISpatialIndex_getRow(self, query.fromBox.upper.y);
+
+    // Un élément rencontré pour la première fois dans l'anneau r est séparé de
+    // l'élément de départ par au moins (r - 1) cellules
+    const float boundFactor = fminf(penaltyFactor, 1.f) * self->m_cellSize;
+    const int maxRing = SDL_max(self->m_columnCount, self->m_rowCount);
+
+    for (int r = 0; r <= maxRing; r++)
+    {
+        if (r >= 2 && query.bestDistance < (float)(r - 1) * boundFactor) break;
+
+        const int xMin = x0 - r, xMax = x1 + r;
+        const int yMin = y0 - r, yMax = y1 + r;
+        const int xFirst = Int_max(xMin, 0), xLast = Int_min(xMax, self->m_columnCount - 1);
+        const int yFirst = Int_max(yMin + 1, 0), yLast = Int_min(yMax - 1, self->m_rowCount - 1);
+
+        if (r == 0)
+        {
+            // Cellules recouvertes par l'élément de départ
+            for (int y = y0; y <= y1; y++)
+            {
+                for (int x = x0; x <= x1; x++)
+                {
+                    UISpatialIndex_visitCell(self, &query, x, y);
+                }
+            }
+            continue;
+        }
+
+        for (int x = xFirst; x <= xLast; x++)
+        {
+            UISpatialIndex_visitCell(self, &query, x, yMin);
+            UISpatialIndex_visitCell(self, &query, x, yMax);
+        }
+        for (int y = yFirst; y <= yLast; y++)
+        {
+            UISpatialIndex_visitCell(self, &query, xMin, y);
+            UISpatialIndex_visitCell(self, &query, xMax, y);
+        }
+    }
+
+    return query.bestIdx;
+}
@@ -0,0 +1,84 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+#include "utils/utils.h"
+
+/// @brief Fonction indiquant si un élément peut être renvoyé par une requête.
+/// @param userData les données passées à la requête.
+/// @param itemIdx l'indice de l'élément.
+typedef bool (*UISpatialIndexFilter)(void* userData, int itemIdx);
+
+/// @brief Grille uniforme sur des boîtes englobantes.
+/// Chaque cellule référence les éléments qui la recouvrent, par indices
+/// croissants. La grille est reconstruite par UISpatialIndex_build() lorsque
+/// les boîtes changent.
+typedef struct UISpatialIndex
+{
+    AABB* m_boxes;
+    int m_itemCount;
+    int m_itemCapacity;
+
+    /// @brief Début de la liste de chaque cellule dans m_cellItems.
+    /// La liste de la cellule i s'arrête au début de la cellule i + 1.
+    int* m_cellStart;
+    int* m_cellItems;
+    int m_cellCapacity;
+    int m_cellItemCapacity;
+
+    Vec2 m_origin;
+    float m_cellSize;
+    int m_columnCount;
+    int m_rowCount;
+} UISpatialIndex;
+
+UISpatialIndex* UISpatialIndex_create();
+void UISpatialIndex_destroy(UISpatialIndex* self);
+
+/// @brief Renvoie la mémoire allouée par l'index, en octets.
+/// @param self l'index.
+/// @return La mémoire allouée.
+size_t UISpatialIndex_getMemory(UISpatialIndex* self);
+
+/// @brief Reconstruit l'index à partir de boîtes englobantes.
+/// @param self l'index.
+/// @param boxes les boîtes, copiées par l'index.
+/// @param count le nombre de boîtes.
+void UISpatialIndex_build(UISpatialIndex* self, const AABB* boxes, int count);
+
+/// @brief Recherche l'élément d'indice minimal contenant un point.
+/// @param self l'index.
+/// @param point le point.
+/// @param filter fonction filtrant les éléments, ou NULL.
+/// @param userData les données passées au filtre.
+/// @return L'indice de l'élément ou -1 s'il n'y en a pas.
+int UISpatialIndex_queryPoint(
+    UISpatialIndex* self, Vec2 point,
+    UISpatialIndexFilter filter, void* userData);
+
+/// @brief Recherche l'élément le plus proche d'un élément dans une direction.
+/// La distance est la projection du plus court vecteur entre les boîtes sur la
+/// direction, plus la projection orthogonale pondérée par penaltyFactor.
+/// Les cellules sont parcourues par anneaux autour de l'élément de départ et
+/// la recherche s'arrête dès qu'aucun anneau ne peut contenir de meilleur élément.
+/// @param self l'index.
+/// @param itemIdx l'indice de l'élément de départ.
+/// @param direction la direction normalisée.
+/// @param penaltyFactor la pondération de l'écart orthogonal.
+/// @param filter fonction filtrant les éléments, ou NULL.
+/// @param userData les données passées au filtre.
+/// @return L'indice de l'élément ou -1 s'il n'y en a pas.
+int UISpatialIndex_queryDirection(
+    UISpatialIndex* self, int itemIdx, Vec2 direction, float penaltyFactor,
+    UISpatialIndexFilter filter, void* userData);
+
+INLINE int UISpatialIndex_getItemCount(UISpatialIndex* self)
+{
+    assert(self && "self must not be NULL");
+    return self->m_itemCount;
+}
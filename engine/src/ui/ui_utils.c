@@ -6,6 +6,10 @@
 
 #include "ui/ui_utils.h"
 #include "game_engine_common.h"
+#include "core/asset_manager.h"
+#include "core/render_queue.h"
+
+static int s_textUpdateCount = 0;
 
 void UIRect_getAABB(const UIRect* rect, const AABB* parentAABB, AABB* outAABB)
 {
@@ -91,16 +95,104 @@ void UITransform_setAbsoluteViewAABB(UITransform* transform, const AABB* aabb)
     transform->localRect.offsetMax = Vec2_div(aabb->upper, pixelsPerUnit);
 }
 
-void UIUtils_renderText(TTF_Text* text, const SDL_FRect* destRect, Vec2 anchor, const SDL_Color* color)
+void UITextCache_init(UITextCache* self)
 {
-    bool success = true;
-    success = TTF_SetTextColor(text, color->r, color->g, color->b, color->a);
+    assert(self && "self must not be NULL");
+    memset(self, 0, sizeof(UITextCache));
+    self->stringRevision = 1;
+}
+
+size_t UIUtils_getTextMemory(TTF_Text* text)
+{
+    if (text == NULL) return 0;
+    size_t glyphCount = text->text ? strlen(text->text) : 0;
+    return UI_TEXT_MEMORY_BASE + glyphCount * UI_TEXT_MEMORY_PER_GLYPH;
+}
+
+/// @brief Associe un texte à l'instance active de sa police, seulement si une
+/// police a changé depuis la dernière association.
+static void UIUtils_syncTextFont(TTF_Text* text, UITextCache* cache)
+{
+    const Uint32 fontGeneration = AssetManager_getFontGeneration();
+    if (cache && cache->fontGeneration == fontGeneration) return;
+
+    AssetManager_syncTextFont(text);
+    if (cache)
+    {
+        // Une instance peut avoir été redimensionnée sans changer d'adresse
+        cache->fontGeneration = fontGeneration;
+        cache->sizeFont = NULL;
+    }
+}
+
+void UIUtils_updateText(TTF_Text* text, const char* string, UITextCache* cache)
+{
+    assert(text && string);
+    if (cache && cache->textRevision == cache->stringRevision) return;
+
+    // La chaîne est mise en forme avec la police active
+    UIUtils_syncTextFont(text, cache);
+
+    bool success = TTF_SetTextString(text, string, 0);
     assert(success);
+    s_textUpdateCount++;
+
+    if (cache)
+    {
+        cache->textRevision = cache->stringRevision;
+    }
+}
+
+int UIUtils_getTextUpdateCount()
+{
+    return s_textUpdateCount;
+}
+
+void UIUtils_resetTextUpdateCount()
+{
+    s_textUpdateCount = 0;
+}
+
+void UIUtils_renderText(
+    TTF_Text* text, const SDL_FRect* destRect, Vec2 anchor, const SDL_Color* color,
+    UITextCache* cache)
+{
+    bool success = true;
+    UIUtils_syncTextFont(text, cache);
 
     int textW = 0;
     int textH = 0;
-    success = TTF_GetTextSize(text, &textW, &textH);
-    assert(success);
+    if (cache)
+    {
+        if (!cache->hasColor ||
+            cache->color.r != color->r || cache->color.g != color->g ||
+            cache->color.b != color->b || cache->color.a != color->a)
+        {
+            success = TTF_SetTextColor(text, color->r, color->g, color->b, color->a);
+            assert(success);
+            cache->color = *color;
+            cache->hasColor = true;
+        }
+
+        // La taille dépend de la chaîne et de la police, qui change avec la taille de la fenêtre
+        TTF_Font* font = TTF_GetTextFont(text);
+        if (cache->sizeRevision != cache->textRevision || cache->sizeFont != font)
+        {
+            success = TTF_GetTextSize(text, &(cache->width), &(cache->height));
+            assert(success);
+            cache->sizeRevision = cache->textRevision;
+            cache->sizeFont = font;
+        }
+        textW = cache->width;
+        textH = cache->height;
+    }
+    else
+    {
+        success = TTF_SetTextColor(text, color->r, color->g, color->b, color->a);
+        assert(success);
+        success = TTF_GetTextSize(text, &textW, &textH);
+        assert(success);
+    }
 
     SDL_FRect textRect = *destRect;
     textRect.x += anchor.x * (textRect.w - textW);
@@ -108,51 +200,44 @@ void UIUtils_renderText(TTF_Text* text, const SDL_FRect* destRect, Vec2 anchor,
     textRect.x = roundf(textRect.x);
     textRect.y = roundf(textRect.y);
 
-    success = TTF_DrawRendererText(text, textRect.x, textRect.y);
-    assert(success);
+    RenderQueue_drawText(text, textRect.x, textRect.y);
 }
 
 void UIUtils_renderSprite(
     SpriteGroup* spriteGroup, int spriteIndex,
-    SDL_Color color, bool useColorMod, SDL_FRect* dstRect)
+    SDL_Color color, bool useColorMod, float opacity, SDL_FRect* dstRect,
+    SpriteGeometry* geometry)
 {
     assert(dstRect && "dstRect must not be NULL");
-    bool success = true;
 
     if (spriteGroup && spriteIndex >= 0)
     {
+        SDL_FColor vertexColor = { 1.f, 1.f, 1.f, opacity };
         if (useColorMod)
         {
             float a = color.a / 255.f;
-            float r = color.r / 255.f * a;
-            float g = color.g / 255.f * a;
-            float b = color.b / 255.f * a;
+            vertexColor.r = color.r / 255.f * a;
+            vertexColor.g = color.g / 255.f * a;
+            vertexColor.b = color.b / 255.f * a;
+        }
 
-            SpriteGroup_setColorModFloat(spriteGroup, r, g, b);
+        if (geometry)
+        {
+            SpriteGroup_renderCached(
+                spriteGroup, spriteIndex, dstRect, Vec2_anchor_north_west,
+                g_sizes.mainRenderScale, vertexColor, geometry
+            );
         }
         else
         {
-            SpriteGroup_setColorModFloat(spriteGroup, 1.f, 1.f, 1.f);
+            SpriteGroup_renderWithColor(
+                spriteGroup, spriteIndex, dstRect, Vec2_anchor_north_west,
+                g_sizes.mainRenderScale, vertexColor
+            );
         }
-
-        SpriteGroup_render(spriteGroup, spriteIndex, dstRect, Vec2_anchor_north_west, g_sizes.mainRenderScale);
     }
     else
     {
-        success = SDL_SetRenderDrawColor(g_renderer, color.r, color.g, color.b, color.a);
-        if (!success)
-        {
-            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "UIUtils_renderSprite");
-            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
-            assert(false);
-        }
-
-        success = SDL_RenderFillRect(g_renderer, dstRect);
-        if (!success)
-        {
-            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "UIUtils_renderSprite");
-            SDL_LogError(SDL_LOG_CATEGORY_SYSTEM, "%s", SDL_GetError());
-            assert(false);
-        }
+        RenderQueue_drawFillRect(dstRect, color);
     }
 }
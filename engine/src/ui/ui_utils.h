@@ -25,6 +25,8 @@ typedef struct UITransform
 {
     UIRect localRect;
     AABB aabb;
+    /// @brief Indique que aabb doit être recalculé à la prochaine mise à jour.
+    bool isDirty;
 } UITransform;
 
 void UITransform_updateAABB(UITransform* transform, const UITransform* parent);
@@ -33,8 +35,71 @@ bool UITransform_containsPoint(const UITransform* transform, Vec2 point);
 Vec2 UITransform_getSize(const UITransform* transform);
 void UITransform_setAbsoluteViewAABB(UITransform* transform, const AABB* aabb);
 
-void UIUtils_renderText(TTF_Text* text, const SDL_FRect* destRect, Vec2 anchor, const SDL_Color* color);
+/// @brief État transmis à un TTF_Text par un widget.
+/// Les setters du widget incrémentent stringRevision lorsque la chaîne change :
+/// la chaîne, la couleur et la taille du texte ne sont alors transmises ou
+/// mesurées par SDL_ttf qu'après une modification.
+typedef struct UITextCache
+{
+    /// @brief Révision de la chaîne du widget.
+    Uint32 stringRevision;
+    /// @brief Révision de la chaîne transmise au TTF_Text.
+    Uint32 textRevision;
+
+    /// @brief Couleur transmise au TTF_Text.
+    SDL_Color color;
+    bool hasColor;
+
+    /// @brief Valeur de AssetManager_getFontGeneration() lors de la dernière
+    /// association du texte à l'instance active de sa police.
+    Uint32 fontGeneration;
+
+    /// @brief Taille mesurée, valide pour la révision et la police associées.
+    Uint32 sizeRevision;
+    TTF_Font* sizeFont;
+    int width;
+    int height;
+} UITextCache;
+
+void UITextCache_init(UITextCache* self);
+
+/// @brief Signale que la chaîne d'un texte a changé.
+/// @param self le cache.
+INLINE void UITextCache_invalidate(UITextCache* self)
+{
+    assert(self && "self must not be NULL");
+    self->stringRevision++;
+}
+
+/// @brief Transmet une chaîne à un TTF_Text si sa révision a changé.
+/// @param text le texte.
+/// @param string la chaîne du widget.
+/// @param cache le cache du texte, ou NULL pour transmettre la chaîne sans condition.
+void UIUtils_updateText(TTF_Text* text, const char* string, UITextCache* cache);
+
+/// @brief Renvoie le nombre de chaînes transmises à SDL_ttf par UIUtils_updateText()
+/// depuis le dernier appel à UIUtils_resetTextUpdateCount().
+/// Chaque transmission entraîne une nouvelle mise en forme du texte.
+int UIUtils_getTextUpdateCount();
+
+/// @brief Estimation de la mémoire d'un TTF_Text, en octets.
+/// SDL_ttf conserve par texte la mise en forme et la géométrie des glyphes.
+#define UI_TEXT_MEMORY_BASE 512
+#define UI_TEXT_MEMORY_PER_GLYPH 128
+
+/// @brief Renvoie une estimation de la mémoire utilisée par un TTF_Text.
+/// @param text le texte, ou NULL.
+/// @return La mémoire estimée en octets.
+size_t UIUtils_getTextMemory(TTF_Text* text);
+
+/// @brief Remet à zéro le compteur de chaînes transmises.
+void UIUtils_resetTextUpdateCount();
+
+void UIUtils_renderText(
+    TTF_Text* text, const SDL_FRect* destRect, Vec2 anchor, const SDL_Color* color,
+    UITextCache* cache);
 
 void UIUtils_renderSprite(
     SpriteGroup* spriteGroup, int spriteIndex,
-    SDL_Color color, bool useColorMod, SDL_FRect* dstRect);
+    SDL_Color color, bool useColorMod, float opacity, SDL_FRect* dstRect,
+    SpriteGeometry* geometry);
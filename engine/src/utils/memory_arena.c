@@ -0,0 +1,210 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/memory_arena.h"
+#include "game_engine_common.h"
+
+struct MemoryArenaBlock
+{
+    MemoryArenaBlock* next;
+    size_t capacity;
+    size_t used;
+};
+
+/// @brief Taille de l'en-tête d'un bloc, les données étant placées juste après.
+#define MEMORY_ARENA_HEADER_SIZE MEMORY_ALIGN(sizeof(MemoryArenaBlock))
+
+static MemoryArenaBlock* MemoryArena_createBlock(MemoryArena* self, size_t capacity)
+{
+    MemoryArenaBlock* block = (MemoryArenaBlock*)SDL_malloc(MEMORY_ARENA_HEADER_SIZE + capacity);
+    AssertNew(block);
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+
+    self->m_stats.blockCount++;
+    self->m_stats.reservedSize += capacity;
+    return block;
+}
+
+static Uint8* MemoryArenaBlock_getData(MemoryArenaBlock* block)
+{
+    return (Uint8*)block + MEMORY_ARENA_HEADER_SIZE;
+}
+
+MemoryArena* MemoryArena_create(size_t blockSize)
+{
+    MemoryArena* self = (MemoryArena*)calloc(1, sizeof(MemoryArena));
+    AssertNew(self);
+
+    self->m_blockSize = MEMORY_ALIGN(blockSize);
+    self->m_firstBlock = MemoryArena_createBlock(self, self->m_blockSize);
+    self->m_currBlock = self->m_firstBlock;
+
+    return self;
+}
+
+void MemoryArena_destroy(MemoryArena* self)
+{
+    if (!self) return;
+
+    MemoryArenaBlock* block = self->m_firstBlock;
+    while (block)
+    {
+        MemoryArenaBlock* next = block->next;
+        SDL_free(block);
+        block = next;
+    }
+    free(self);
+}
+
+void* MemoryArena_alloc(MemoryArena* self, size_t size)
+{
+    assert(self && "The MemoryArena must be created");
+    size = MEMORY_ALIGN(SDL_max(size, (size_t)1));
+
+    MemoryArenaBlock* block = self->m_currBlock;
+    if (block->used + size > block->capacity)
+    {
+        // Les blocs sont chaînés dans l'ordre de création
+        block = MemoryArena_createBlock(self, SDL_max(self->m_blockSize, size));
+        self->m_currBlock->next = block;
+        self->m_currBlock = block;
+    }
+
+    void* memory = MemoryArenaBlock_getData(block) + block->used;
+    block->used += size;
+    memset(memory, 0, size);
+
+    self->m_stats.allocCount++;
+    self->m_stats.usedSize += size;
+    return memory;
+}
+
+char* MemoryArena_strdup(MemoryArena* self, const char* str)
+{
+    assert(str && "The string must be valid");
+    size_t size = strlen(str) + 1;
+    char* copy = (char*)MemoryArena_alloc(self, size);
+    memcpy(copy, str, size);
+    return copy;
+}
+
+bool MemoryArena_contains(MemoryArena* self, const void* memory)
+{
+    assert(self && "The MemoryArena must be created");
+    const Uint8* address = (const Uint8*)memory;
+    for (MemoryArenaBlock* block = self->m_firstBlock; block != NULL; block = block->next)
+    {
+        const Uint8* data = MemoryArenaBlock_getData(block);
+        if (data <= address && address < data + block->capacity) return true;
+    }
+    return false;
+}
+
+void MemoryArena_reset(MemoryArena* self)
+{
+    assert(self && "The MemoryArena must be created");
+
+    MemoryArenaBlock* block = self->m_firstBlock->next;
+    while (block)
+    {
+        MemoryArenaBlock* next = block->next;
+        SDL_free(block);
+        block = next;
+    }
+    self->m_firstBlock->next = NULL;
+    self->m_firstBlock->used = 0;
+    self->m_currBlock = self->m_firstBlock;
+
+    self->m_stats.allocCount = 0;
+    self->m_stats.blockCount = 1;
+    self->m_stats.usedSize = 0;
+    self->m_stats.reservedSize = self->m_firstBlock->capacity;
+}
+
+struct MemoryPoolBlock
+{
+    MemoryPoolBlock* next;
+};
+
+#define MEMORY_POOL_HEADER_SIZE MEMORY_ALIGN(sizeof(MemoryPoolBlock))
+
+MemoryPool* MemoryPool_create(size_t elementSize, int elementsPerBlock)
+{
+    assert(elementSize > 0 && elementsPerBlock > 0);
+
+    MemoryPool* self = (MemoryPool*)calloc(1, sizeof(MemoryPool));
+    AssertNew(self);
+
+    // Un élément libre contient le pointeur vers l'élément libre suivant
+    self->m_elementSize = MEMORY_ALIGN(SDL_max(elementSize, sizeof(void*)));
+    self->m_elementsPerBlock = elementsPerBlock;
+
+    return self;
+}
+
+void MemoryPool_destroy(MemoryPool* self)
+{
+    if (!self) return;
+
+    MemoryPoolBlock* block = self->m_firstBlock;
+    while (block)
+    {
+        MemoryPoolBlock* next = block->next;
+        SDL_free(block);
+        block = next;
+    }
+    free(self);
+}
+
+static void MemoryPool_grow(MemoryPool* self)
+{
+    const size_t elementSize = self->m_elementSize;
+    MemoryPoolBlock* block = (MemoryPoolBlock*)SDL_malloc(
+        MEMORY_POOL_HEADER_SIZE + elementSize * self->m_elementsPerBlock
+    );
+    AssertNew(block);
+    block->next = self->m_firstBlock;
+    self->m_firstBlock = block;
+    self->m_stats.blockCount++;
+
+    // Chaîne les éléments du bloc dans l'ordre des adresses
+    Uint8* data = (Uint8*)block + MEMORY_POOL_HEADER_SIZE;
+    for (int i = self->m_elementsPerBlock - 1; i >= 0; i--)
+    {
+        void** element = (void**)(data + i * elementSize);
+        *element = self->m_freeList;
+        self->m_freeList = element;
+    }
+}
+
+void* MemoryPool_alloc(MemoryPool* self)
+{
+    assert(self && "The MemoryPool must be created");
+    if (self->m_freeList == NULL)
+    {
+        MemoryPool_grow(self);
+    }
+
+    void** element = (void**)self->m_freeList;
+    self->m_freeList = *element;
+    memset(element, 0, self->m_elementSize);
+
+    self->m_stats.usedCount++;
+    return element;
+}
+
+void MemoryPool_free(MemoryPool* self, void* element)
+{
+    assert(self && "The MemoryPool must be created");
+    if (!element) return;
+    assert(self->m_stats.usedCount > 0 && "The element does not belong to the pool");
+
+    *(void**)element = self->m_freeList;
+    self->m_freeList = element;
+    self->m_stats.usedCount--;
+}
@@ -0,0 +1,133 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+/// @brief Alignement des allocations des arènes et des pools.
+#define MEMORY_ALIGNMENT 16
+#define MEMORY_ALIGN(size) (((size) + (MEMORY_ALIGNMENT - 1)) & ~((size_t)MEMORY_ALIGNMENT - 1))
+
+typedef struct MemoryArenaBlock MemoryArenaBlock;
+
+/// @brief Statistiques d'une arène mémoire.
+typedef struct MemoryArenaStats
+{
+    /// @brief Nombre d'allocations depuis la dernière remise à zéro.
+    int allocCount;
+    /// @brief Nombre de blocs alloués par le système.
+    int blockCount;
+    /// @brief Nombre d'octets alloués dans l'arène.
+    size_t usedSize;
+    /// @brief Nombre d'octets réservés par les blocs.
+    size_t reservedSize;
+} MemoryArenaStats;
+
+/// @brief Allocateur linéaire par blocs.
+/// Les allocations ne sont jamais libérées individuellement : toute la mémoire
+/// de l'arène est rendue en une fois par MemoryArena_reset() ou
+/// MemoryArena_destroy().
+typedef struct MemoryArena
+{
+    MemoryArenaBlock* m_firstBlock;
+    MemoryArenaBlock* m_currBlock;
+    size_t m_blockSize;
+    MemoryArenaStats m_stats;
+} MemoryArena;
+
+/// @brief Crée une arène mémoire.
+/// @param blockSize la taille en octets des blocs alloués par le système.
+/// @return L'arène créée.
+MemoryArena* MemoryArena_create(size_t blockSize);
+
+/// @brief Détruit une arène mémoire et toutes ses allocations.
+/// @param self l'arène.
+void MemoryArena_destroy(MemoryArena* self);
+
+/// @brief Alloue une zone mémoire initialisée à zéro.
+/// @param self l'arène.
+/// @param size la taille en octets.
+/// @return La zone allouée, alignée sur MEMORY_ALIGNMENT octets.
+void* MemoryArena_alloc(MemoryArena* self, size_t size);
+
+/// @brief Copie une chaîne de caractères dans l'arène.
+/// @param self l'arène.
+/// @param str la chaîne à copier.
+/// @return La copie.
+char* MemoryArena_strdup(MemoryArena* self, const char* str);
+
+/// @brief Indique si une adresse appartient à un bloc de l'arène.
+/// @param self l'arène.
+/// @param memory l'adresse.
+/// @return true si l'adresse a été allouée par l'arène.
+bool MemoryArena_contains(MemoryArena* self, const void* memory);
+
+/// @brief Libère toutes les allocations de l'arène.
+/// Le premier bloc est conservé pour les allocations suivantes.
+/// @param self l'arène.
+void MemoryArena_reset(MemoryArena* self);
+
+INLINE MemoryArenaStats MemoryArena_getStats(MemoryArena* self)
+{
+    assert(self && "The MemoryArena must be created");
+    return self->m_stats;
+}
+
+typedef struct MemoryPoolBlock MemoryPoolBlock;
+
+/// @brief Statistiques d'un pool mémoire.
+typedef struct MemoryPoolStats
+{
+    /// @brief Nombre d'éléments alloués et non libérés.
+    int usedCount;
+    /// @brief Nombre de blocs alloués par le système.
+    int blockCount;
+} MemoryPoolStats;
+
+/// @brief Allocateur d'éléments de taille fixe.
+/// Les éléments libérés sont chaînés dans une liste et réutilisés par les
+/// allocations suivantes.
+typedef struct MemoryPool
+{
+    MemoryPoolBlock* m_firstBlock;
+    void* m_freeList;
+    size_t m_elementSize;
+    int m_elementsPerBlock;
+    MemoryPoolStats m_stats;
+} MemoryPool;
+
+/// @brief Crée un pool mémoire.
+/// @param elementSize la taille en octets d'un élément.
+/// @param elementsPerBlock le nombre d'éléments des blocs alloués par le système.
+/// @return Le pool créé.
+MemoryPool* MemoryPool_create(size_t elementSize, int elementsPerBlock);
+
+/// @brief Détruit un pool mémoire et tous ses éléments.
+/// @param self le pool.
+void MemoryPool_destroy(MemoryPool* self);
+
+/// @brief Alloue un élément initialisé à zéro.
+/// @param self le pool.
+/// @return L'élément alloué.
+void* MemoryPool_alloc(MemoryPool* self);
+
+/// @brief Rend un élément au pool.
+/// @param self le pool.
+/// @param element l'élément, alloué par ce pool.
+void MemoryPool_free(MemoryPool* self, void* element);
+
+INLINE MemoryPoolStats MemoryPool_getStats(MemoryPool* self)
+{
+    assert(self && "The MemoryPool must be created");
+    return self->m_stats;
+}
+
+INLINE size_t MemoryPool_getElementSize(MemoryPool* self)
+{
+    assert(self && "The MemoryPool must be created");
+    return self->m_elementSize;
+}
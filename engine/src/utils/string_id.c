@@ -0,0 +1,163 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "utils/string_id.h"
+#include "game_engine_common.h"
+
+typedef struct StringIDEntry
+{
+    Uint64 hash;
+    char* string;
+} StringIDEntry;
+
+/// @brief Table globale des chaînes internées.
+/// L'identifiant d'une chaîne est son indice dans m_entries plus un.
+typedef struct StringIDTable
+{
+    StringIDEntry* m_entries;
+    int m_entryCount;
+    int m_entryCapacity;
+
+    /// @brief Table à adressage ouvert contenant des identifiants.
+    StringID* m_slots;
+    int m_slotCapacity;
+} StringIDTable;
+
+static StringIDTable s_table = { 0 };
+static SDL_SpinLock s_lock = 0;
+
+static Uint64 StringID_hash(const char* str)
+{
+    Uint64 hash = 0xCBF29CE484222325ULL;
+    for (const char* c = str; *c != '\0'; c++)
+    {
+        hash ^= (Uint8)*c;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static StringID StringID_findLocked(const char* str, Uint64 hash, int* outSlot)
+{
+    if (s_table.m_slotCapacity == 0)
+    {
+        *outSlot = -1;
+        return STRING_ID_INVALID;
+    }
+
+    const int mask = s_table.m_slotCapacity - 1;
+    int slot = (int)(hash & mask);
+    while (s_table.m_slots[slot] != STRING_ID_INVALID)
+    {
+        const StringIDEntry* entry = &(s_table.m_entries[s_table.m_slots[slot] - 1]);
+        if (entry->hash == hash && SDL_strcmp(entry->string, str) == 0)
+        {
+            *outSlot = slot;
+            return s_table.m_slots[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    *outSlot = slot;
+    return STRING_ID_INVALID;
+}
+
+static void StringID_growSlotsLocked()
+{
+    int newCapacity = (s_table.m_slotCapacity > 0) ? 2 * s_table.m_slotCapacity : 256;
+    StringID* newSlots = (StringID*)calloc(newCapacity, sizeof(StringID));
+    AssertNew(newSlots);
+
+    const int mask = newCapacity - 1;
+    for (int i = 0; i < s_table.m_entryCount; i++)
+    {
+        int slot = (int)(s_table.m_entries[i].hash & mask);
+        while (newSlots[slot] != STRING_ID_INVALID)
+        {
+            slot = (slot + 1) & mask;
+        }
+        newSlots[slot] = (StringID)(i + 1);
+    }
+
+    free(s_table.m_slots);
+    s_table.m_slots = newSlots;
+    s_table.m_slotCapacity = newCapacity;
+}
+
+StringID StringID_intern(const char* str)
+{
+    assert(str && "The string must be valid");
+    const Uint64 hash = StringID_hash(str);
+    int slot = -1;
+
+    SDL_LockSpinlock(&s_lock);
+
+    StringID id = StringID_findLocked(str, hash, &slot);
+    if (id != STRING_ID_INVALID)
+    {
+        SDL_UnlockSpinlock(&s_lock);
+        return id;
+    }
+
+    // Facteur de charge maximal de 1/2
+    if (2 * (s_table.m_entryCount + 1) > s_table.m_slotCapacity)
+    {
+        StringID_growSlotsLocked();
+        StringID_findLocked(str, hash, &slot);
+    }
+    if (s_table.m_entryCount >= s_table.m_entryCapacity)
+    {
+        int newCapacity = (s_table.m_entryCapacity > 0) ? 2 * s_table.m_entryCapacity : 128;
+        StringIDEntry* newEntries = (StringIDEntry*)realloc(s_table.m_entries, newCapacity * sizeof(StringIDEntry));
+        AssertNew(newEntries);
+        s_table.m_entries = newEntries;
+        s_table.m_entryCapacity = newCapacity;
+    }
+
+    StringIDEntry* entry = &(s_table.m_entries[s_table.m_entryCount++]);
+    entry->hash = hash;
+    entry->string = Strdup(str);
+    id = (StringID)s_table.m_entryCount;
+    s_table.m_slots[slot] = id;
+
+    SDL_UnlockSpinlock(&s_lock);
+    return id;
+}
+
+StringID StringID_find(const char* str)
+{
+    assert(str && "The string must be valid");
+    const Uint64 hash = StringID_hash(str);
+    int slot = -1;
+
+    SDL_LockSpinlock(&s_lock);
+    StringID id = StringID_findLocked(str, hash, &slot);
+    SDL_UnlockSpinlock(&s_lock);
+
+    return id;
+}
+
+const char* StringID_getString(StringID id)
+{
+    SDL_LockSpinlock(&s_lock);
+    assert(0 < id && id <= (StringID)s_table.m_entryCount && "The StringID is not valid");
+    const char* str = s_table.m_entries[id - 1].string;
+    SDL_UnlockSpinlock(&s_lock);
+
+    return str;
+}
+
+void StringID_clear()
+{
+    SDL_LockSpinlock(&s_lock);
+    for (int i = 0; i < s_table.m_entryCount; i++)
+    {
+        free(s_table.m_entries[i].string);
+    }
+    free(s_table.m_entries);
+    free(s_table.m_slots);
+    memset(&s_table, 0, sizeof(StringIDTable));
+    SDL_UnlockSpinlock(&s_lock);
+}
@@ -0,0 +1,36 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "game_engine_settings.h"
+
+/// @brief Identifiant d'une chaîne de caractères internée.
+/// Deux chaînes égales ont le même identifiant pendant toute l'exécution :
+/// les comparaisons et les recherches se font sur des entiers.
+typedef Uint32 StringID;
+
+#define STRING_ID_INVALID 0
+
+/// @brief Renvoie l'identifiant d'une chaîne, en l'internant si nécessaire.
+/// Cette fonction peut être appelée depuis plusieurs threads.
+/// @param str la chaîne de caractères.
+/// @return L'identifiant de la chaîne.
+StringID StringID_intern(const char* str);
+
+/// @brief Renvoie l'identifiant d'une chaîne déjà internée.
+/// @param str la chaîne de caractères.
+/// @return L'identifiant de la chaîne ou STRING_ID_INVALID si elle n'a jamais été internée.
+StringID StringID_find(const char* str);
+
+/// @brief Renvoie la chaîne associée à un identifiant.
+/// @param id l'identifiant.
+/// @return La chaîne internée, valide jusqu'à l'appel de StringID_clear().
+const char* StringID_getString(StringID id);
+
+/// @brief Libère toutes les chaînes internées.
+/// Les identifiants obtenus auparavant deviennent invalides.
+void StringID_clear();